@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "storage/lru_buffer_strategy.h"
+
+// 旧版 LRU 实现，每次访问都需要 std::list::remove 遍历整个链表，作为对比基准
+class ListRemoveLRUBufferStrategy : public huadb::BufferStrategy {
+ public:
+  void Access(size_t frame_no) override {
+    access_order_.remove(frame_no);
+    access_order_.emplace_front(frame_no);
+  }
+  size_t Evict(const std::function<bool(size_t)> &evictable) override {
+    auto victim = access_order_.back();
+    access_order_.pop_back();
+    return victim;
+  }
+  std::vector<size_t> GetVictims(size_t count, const std::function<bool(size_t)> &evictable) const override {
+    return {access_order_.rbegin(), std::next(access_order_.rbegin(), std::min(count, access_order_.size()))};
+  }
+  // 预热时直接插入，避免 O(n^2) 的预热开销
+  void Fill(size_t frame_count) {
+    for (size_t i = 0; i < frame_count; i++) {
+      access_order_.emplace_front(i);
+    }
+  }
+
+ private:
+  std::list<size_t> access_order_;
+};
+
+// 访问 operations 次：9/10 为命中（随机访问已有页面），1/10 为缺页（淘汰后重新放入同一帧）
+double Run(huadb::BufferStrategy &strategy, size_t frame_count, size_t operations, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> frame_dist(0, frame_count - 1);
+  auto evictable = [](size_t) { return true; };
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < operations; i++) {
+    if (i % 10 == 9) {
+      strategy.Access(strategy.Evict(evictable));
+    } else {
+      strategy.Access(frame_dist(rng));
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() / operations;
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("buffer_strategy_benchmark");
+  program.add_argument("-n", "--operations")
+      .help("Number of accesses per run")
+      .default_value(2000u)
+      .metavar("OPS")
+      .scan<'u', unsigned>();
+  program.add_argument("frames")
+      .help("Buffer pool sizes to benchmark")
+      .nargs(argparse::nargs_pattern::any)
+      .default_value(std::vector<std::string>{"1024", "65536", "1048576"});
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  auto operations = program.get<unsigned>("--operations");
+  std::cout << std::setw(10) << "frames" << std::setw(20) << "list::remove ns/op" << std::setw(16) << "hashed ns/op"
+            << std::endl;
+  for (const auto &frames : program.get<std::vector<std::string>>("frames")) {
+    size_t frame_count = std::stoull(frames);
+
+    ListRemoveLRUBufferStrategy list_remove;
+    list_remove.Fill(frame_count);
+    auto list_remove_ns = Run(list_remove, frame_count, operations, frame_count);
+
+    huadb::LRUBufferStrategy hashed;
+    for (size_t i = 0; i < frame_count; i++) {
+      hashed.Access(i);
+    }
+    auto hashed_ns = Run(hashed, frame_count, operations, frame_count);
+
+    std::cout << std::setw(10) << frame_count << std::setw(20) << std::fixed << std::setprecision(1) << list_remove_ns
+              << std::setw(16) << hashed_ns << std::endl;
+  }
+  return 0;
+}
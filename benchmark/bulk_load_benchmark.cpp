@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "argparse/argparse.hpp"
+#include "common/result_writer.h"
+#include "database/connection.h"
+#include "database/database_engine.h"
+
+std::string Execute(const huadb::Connection &connection, const std::string &sql) {
+  std::ostringstream result;
+  huadb::SimpleWriter writer(result, true);
+  connection.SendQuery(sql, writer);
+  return result.str();
+}
+
+std::string RowValues(size_t i) {
+  return std::to_string(i) + ", " + std::to_string(i % 1000) + ", " + std::to_string(i) + ".5, 'customer_" +
+         std::to_string(i % 5000) + "'";
+}
+
+// 在新数据库中建表并以 method 方式导入 rows 行，返回每秒导入的行数
+// method 为 insert 时每行一条 INSERT，为 batch 时每条 INSERT 包含 batch_size 行，为 copy 时从 CSV 文件导入
+double Run(const std::string &method, size_t page_size, size_t buffer_bytes, size_t rows, size_t batch_size,
+           const std::string &csv_path) {
+  auto database = std::make_unique<huadb::DatabaseEngine>(std::max<size_t>(buffer_bytes / page_size, 1), page_size);
+  auto connection = std::make_unique<huadb::Connection>(*database);
+  Execute(*connection, "create table load_t(id int, amount int, price double, customer varchar(32));");
+  auto begin = std::chrono::steady_clock::now();
+  if (method == "copy") {
+    Execute(*connection, "copy load_t from '" + csv_path + "';");
+  } else {
+    auto step = method == "insert" ? 1 : batch_size;
+    for (size_t i = 0; i < rows; i += step) {
+      std::string sql = "insert into load_t values ";
+      for (size_t j = i; j < std::min(rows, i + step); j++) {
+        sql += (j == i ? "(" : ", (") + RowValues(j) + ")";
+      }
+      Execute(*connection, sql + ";");
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  // 确认所有行均已导入
+  auto count = Execute(*connection, "select id from load_t where id = " + std::to_string(rows - 1) + ";");
+  if (count.find(std::to_string(rows - 1)) == std::string::npos) {
+    throw std::runtime_error(method + " did not load all rows");
+  }
+  return rows / std::chrono::duration<double>(end - begin).count();
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("bulk_load_benchmark");
+  program.add_argument("-r", "--rows").help("Number of rows to load").default_value(20000u).scan<'u', unsigned>();
+  program.add_argument("-b", "--batch-size")
+      .help("Number of rows per batched INSERT")
+      .default_value(100u)
+      .scan<'u', unsigned>();
+  program.add_argument("-m", "--buffer-bytes")
+      .help("Buffer pool memory in bytes")
+      .default_value(4194304u)
+      .scan<'u', unsigned>();
+  program.add_argument("page_sizes")
+      .help("Page sizes to benchmark")
+      .nargs(argparse::nargs_pattern::any)
+      .default_value(std::vector<std::string>{"4096"});
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  auto rows = program.get<unsigned>("--rows");
+  auto batch_size = program.get<unsigned>("--batch-size");
+  auto origin_path = std::filesystem::current_path();
+  auto base_path = std::filesystem::temp_directory_path() / ("huadb_benchmark_" + std::to_string(getpid()));
+  std::filesystem::create_directories(base_path);
+  // CSV 文件使用绝对路径，COPY 的相对路径相对于数据目录
+  auto csv_path = base_path / "load.csv";
+  {
+    std::ofstream csv(csv_path);
+    for (size_t i = 0; i < rows; i++) {
+      csv << i << ',' << i % 1000 << ',' << i << ".5,customer_" << i % 5000 << '\n';
+    }
+  }
+
+  std::cout << std::setw(10) << "page size" << std::setw(14) << "insert rows/s" << std::setw(14) << "batch rows/s"
+            << std::setw(14) << "copy rows/s" << std::setw(16) << "copy / insert" << std::setw(16) << "copy / batch"
+            << std::endl;
+  for (const auto &page_size : program.get<std::vector<std::string>>("page_sizes")) {
+    std::vector<double> speeds;
+    for (const auto &method : {"insert", "batch", "copy"}) {
+      auto work_path = base_path / (std::string(method) + "_" + page_size);
+      std::filesystem::create_directories(work_path);
+      std::filesystem::current_path(work_path);
+      speeds.push_back(Run(method, std::stoull(page_size), program.get<unsigned>("--buffer-bytes"), rows, batch_size,
+                           csv_path.string()));
+      std::filesystem::current_path(origin_path);
+    }
+    std::cout << std::setw(10) << page_size << std::fixed << std::setprecision(0) << std::setw(14) << speeds[0]
+              << std::setw(14) << speeds[1] << std::setw(14) << speeds[2] << std::setprecision(1) << std::setw(16)
+              << speeds[2] / speeds[0] << std::setw(16) << speeds[2] / speeds[1] << std::endl;
+  }
+  std::filesystem::remove_all(base_path);
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "argparse/argparse.hpp"
+#include "common/constants.h"
+#include "log/log_manager.h"
+#include "storage/buffer_pool.h"
+#include "storage/disk.h"
+#include "transaction/lock_manager.h"
+#include "transaction/transaction_manager.h"
+
+static constexpr huadb::oid_t BENCHMARK_DB_OID = huadb::PRESERVED_OID;
+static constexpr huadb::oid_t BENCHMARK_TABLE_OID = huadb::PRESERVED_OID + 1;
+
+// sessions 个线程并发顺序扫描表的所有页面，各线程起始页面错开，返回每秒扫描的页面数
+double Run(huadb::BufferPool &buffer_pool, size_t sessions, huadb::pageid_t page_count, size_t scans) {
+  std::atomic<uint64_t> checksum = 0;
+  std::vector<std::thread> threads;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < sessions; i++) {
+    threads.emplace_back([&, i]() {
+      uint64_t sum = 0;
+      auto start = static_cast<huadb::pageid_t>(i * page_count / sessions);
+      for (size_t scan = 0; scan < scans; scan++) {
+        for (huadb::pageid_t j = 0; j < page_count; j++) {
+          auto page = buffer_pool.GetPage(BENCHMARK_DB_OID, BENCHMARK_TABLE_OID, (start + j) % page_count);
+          sum += static_cast<unsigned char>(page->GetData()[0]);
+        }
+      }
+      checksum += sum;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+  // 每个页面首字节为 page_id % 256，校验所有线程读到的页面内容
+  uint64_t expected = 0;
+  for (huadb::pageid_t j = 0; j < page_count; j++) {
+    expected += j % 256;
+  }
+  if (checksum != expected * scans * sessions) {
+    throw std::runtime_error("checksum mismatch");
+  }
+  return sessions * scans * page_count / std::chrono::duration<double>(end - begin).count();
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("concurrent_scan_benchmark");
+  program.add_argument("-p", "--pages").help("Number of table pages").default_value(4096u).scan<'u', unsigned>();
+  program.add_argument("-b", "--buffer-pool-size")
+      .help("Number of buffer pool frames, smaller than the table so scans keep evicting")
+      .default_value(1024u)
+      .scan<'u', unsigned>();
+  program.add_argument("-s", "--scans").help("Number of scans per session").default_value(8u).scan<'u', unsigned>();
+  program.add_argument("sessions")
+      .help("Numbers of concurrent scan sessions to benchmark")
+      .nargs(argparse::nargs_pattern::any)
+      .default_value(std::vector<std::string>{"1", "2", "4", "8"});
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  auto page_count = program.get<unsigned>("--pages");
+  auto scans = program.get<unsigned>("--scans");
+  auto work_path = std::filesystem::temp_directory_path() / ("huadb_benchmark_" + std::to_string(getpid()));
+  std::filesystem::create_directories(work_path);
+  auto origin_path = std::filesystem::current_path();
+  std::filesystem::current_path(work_path);
+  {
+    huadb::Disk disk;
+    huadb::LockManager lock_manager;
+    huadb::TransactionManager transaction_manager(lock_manager, huadb::FIRST_XID);
+    huadb::LogManager log_manager(disk, transaction_manager, huadb::FIRST_LSN);
+    huadb::BufferPool buffer_pool(disk, log_manager, program.get<unsigned>("--buffer-pool-size"));
+
+    huadb::Disk::CreateDirectory(std::to_string(BENCHMARK_DB_OID));
+    huadb::Disk::CreateFile(huadb::Disk::GetFilePath(BENCHMARK_DB_OID, BENCHMARK_TABLE_OID));
+    std::vector<char> data(disk.GetPageSize());
+    for (huadb::pageid_t j = 0; j < page_count; j++) {
+      data[0] = static_cast<char>(j % 256);
+      disk.WritePage(BENCHMARK_DB_OID, BENCHMARK_TABLE_OID, j, data.data());
+    }
+
+    std::cout << "pages: " << page_count << ", buffer pool: " << buffer_pool.GetPoolSize() << " frames in "
+              << buffer_pool.GetPartitionCount() << " partitions" << std::endl;
+    std::cout << std::setw(10) << "sessions" << std::setw(16) << "pages/s" << std::setw(10) << "speedup" << std::endl;
+    double base = 0;
+    for (const auto &sessions : program.get<std::vector<std::string>>("sessions")) {
+      auto session_count = std::stoull(sessions);
+      buffer_pool.Flush(true);
+      auto throughput = Run(buffer_pool, session_count, page_count, scans);
+      if (base == 0) {
+        base = throughput;
+      }
+      std::cout << std::setw(10) << session_count << std::setw(16) << std::fixed << std::setprecision(0) << throughput
+                << std::setw(10) << std::setprecision(2) << throughput / base << std::endl;
+    }
+  }
+  std::filesystem::current_path(origin_path);
+  std::filesystem::remove_all(work_path);
+  return 0;
+}
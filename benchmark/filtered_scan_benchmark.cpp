@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "argparse/argparse.hpp"
+#include "common/constants.h"
+#include "common/result_writer.h"
+#include "database/connection.h"
+#include "database/database_engine.h"
+
+static constexpr size_t INSERT_BATCH_SIZE = 100;
+
+std::string Execute(const huadb::Connection &connection, const std::string &sql) {
+  std::ostringstream result;
+  huadb::SimpleWriter writer(result, true);
+  connection.SendQuery(sql, writer);
+  return result.str();
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("filtered_scan_benchmark");
+  program.add_argument("-r", "--rows").help("Number of table rows").default_value(20000u).scan<'u', unsigned>();
+  program.add_argument("-s", "--scans").help("Number of scans per predicate").default_value(20u).scan<'u', unsigned>();
+  program.add_argument("-p", "--page-size")
+      .help("Page size in bytes")
+      .default_value(static_cast<unsigned>(huadb::DEFAULT_DB_PAGE_SIZE))
+      .scan<'u', unsigned>();
+  program.add_argument("predicates")
+      .help("Where clauses to benchmark, columns are id int and info varchar(100)")
+      .nargs(argparse::nargs_pattern::any)
+      .default_value(std::vector<std::string>{"id = -1", "id < 200", "id < 2000", "id >= 0", "info = 'none'",
+                                              "id > 100 and id < 300"});
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  auto rows = program.get<unsigned>("--rows");
+  auto scans = program.get<unsigned>("--scans");
+  auto page_size = program.get<unsigned>("--page-size");
+
+  auto origin_path = std::filesystem::current_path();
+  auto work_path = std::filesystem::temp_directory_path() / ("huadb_benchmark_" + std::to_string(getpid()));
+  std::filesystem::create_directories(work_path);
+  std::filesystem::current_path(work_path);
+  {
+    // buffer pool 可容纳整张表，测量的是扫描和过滤本身的 CPU 开销
+    auto frames = rows * 128 / page_size + 16;
+    auto database = std::make_unique<huadb::DatabaseEngine>(frames, page_size);
+    auto connection = std::make_unique<huadb::Connection>(*database);
+    Execute(*connection, "create table scan_1(id int, info varchar(100));");
+    std::string padding(64, 'x');
+    for (size_t i = 0; i < rows; i += INSERT_BATCH_SIZE) {
+      std::string sql = "insert into scan_1 values ";
+      for (size_t j = i; j < std::min<size_t>(rows, i + INSERT_BATCH_SIZE); j++) {
+        sql += (j == i ? "(" : ", (") + std::to_string(j) + ", '" + padding + "')";
+      }
+      Execute(*connection, sql + ";");
+    }
+    // 预热，将所有页面读入 buffer pool
+    Execute(*connection, "select id from scan_1 where id = -1;");
+
+    std::cout << std::setw(28) << "predicate" << std::setw(12) << "matched" << std::setw(14) << "rows/s" << std::endl;
+    for (const auto &predicate : program.get<std::vector<std::string>>("predicates")) {
+      std::string sql = "select id from scan_1 where " + predicate + ";";
+      size_t matched = 0;
+      auto begin = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < scans; i++) {
+        auto result = Execute(*connection, sql);
+        matched = std::count(result.begin(), result.end(), '\n');
+      }
+      auto end = std::chrono::steady_clock::now();
+      auto seconds = std::chrono::duration<double>(end - begin).count();
+      std::cout << std::setw(28) << predicate << std::setw(12) << matched << std::setw(14) << std::fixed
+                << std::setprecision(0) << rows * scans / seconds << std::endl;
+    }
+  }
+  std::filesystem::current_path(origin_path);
+  std::filesystem::remove_all(work_path);
+  return 0;
+}
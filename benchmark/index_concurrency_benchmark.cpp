@@ -0,0 +1,193 @@
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "argparse/argparse.hpp"
+#include "common/constants.h"
+#include "index/b_plus_tree.h"
+#include "index/hash_index.h"
+#include "log/log_manager.h"
+#include "storage/buffer_pool.h"
+#include "storage/disk.h"
+#include "transaction/lock_manager.h"
+#include "transaction/transaction_manager.h"
+
+static constexpr huadb::oid_t BENCHMARK_DB_OID = huadb::PRESERVED_OID;
+static constexpr huadb::oid_t BENCHMARK_TABLE_OID = huadb::PRESERVED_OID + 1;
+
+// 新建索引并插入 keys 个偶数键，每次运行使用新的索引，保证各线程数下的初始状态相同
+std::unique_ptr<huadb::Index> CreateIndex(huadb::BufferPool &buffer_pool, huadb::LogManager &log_manager,
+                                          huadb::oid_t index_oid, unsigned keys, huadb::IndexType index_type) {
+  huadb::Disk::CreateFile(huadb::Disk::GetFilePath(BENCHMARK_DB_OID, index_oid));
+  std::vector<huadb::IndexColumn> key_columns{{0, huadb::ColumnDefinition("key", huadb::Type::INT)}};
+  std::unique_ptr<huadb::Index> index;
+  if (index_type == huadb::IndexType::HASH) {
+    index = std::make_unique<huadb::HashIndex>(buffer_pool, log_manager, index_oid, BENCHMARK_DB_OID,
+                                               BENCHMARK_TABLE_OID, std::move(key_columns), true);
+  } else {
+    index = std::make_unique<huadb::BPlusTree>(buffer_pool, log_manager, index_oid, BENCHMARK_DB_OID,
+                                               BENCHMARK_TABLE_OID, std::move(key_columns),
+                                               std::vector<huadb::IndexColumn>{}, true);
+  }
+  for (unsigned i = 0; i < keys; i++) {
+    index->InsertEntry({huadb::Value(static_cast<int32_t>(i * 2))}, {}, {i, 0}, huadb::DDL_XID, false);
+  }
+  return index;
+}
+
+// threads 个线程并发执行 ops 次操作，read_percent% 为等值查找已有的偶数键，其余为插入随机的奇数键
+// 写日志时每个线程使用各自的事务，事务在线程启动前开始，避免并发修改活跃事务表
+// 对所有可能的键做等值查找统计索引项数，哈希索引不支持范围扫描
+size_t CountEntries(huadb::Index &index, unsigned keys) {
+  size_t count = 0;
+  for (unsigned key = 0; key < keys * 2; key++) {
+    huadb::IndexRange range;
+    range.lower_ = range.upper_ = huadb::IndexKey{huadb::Value(static_cast<int32_t>(key))};
+    count += index.Scan(range).size();
+  }
+  return count;
+}
+
+// 返回每秒完成的操作数，结束后检查索引中的索引项数
+double Run(huadb::Index &index, huadb::TransactionManager &transaction_manager, huadb::LogManager &log_manager,
+           size_t threads, unsigned keys, unsigned ops, unsigned read_percent, bool write_log) {
+  std::vector<huadb::xid_t> xids(threads, huadb::DDL_XID);
+  if (write_log) {
+    for (auto &xid : xids) {
+      xid = transaction_manager.Begin();
+      log_manager.AppendBeginLog(xid);
+    }
+  }
+  std::atomic<uint64_t> missing = 0;
+  std::atomic<uint64_t> inserted = 0;
+  std::vector<std::thread> workers;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < threads; i++) {
+    workers.emplace_back([&, i]() {
+      std::mt19937 rng(i);
+      std::uniform_int_distribution<unsigned> key_dist(0, keys - 1);
+      std::uniform_int_distribution<unsigned> op_dist(0, 99);
+      for (unsigned op = 0; op < ops; op++) {
+        auto key = static_cast<int32_t>(key_dist(rng) * 2);
+        if (op_dist(rng) < read_percent) {
+          huadb::IndexRange range;
+          range.lower_ = range.upper_ = huadb::IndexKey{huadb::Value(key)};
+          if (index.Scan(range).empty()) {
+            missing++;
+          }
+        } else {
+          // rid 在线程之间不重复，插入的索引项均为新项
+          huadb::Rid rid{static_cast<huadb::pageid_t>(keys + i), static_cast<huadb::slotid_t>(op)};
+          index.InsertEntry({huadb::Value(key + 1)}, {}, rid, xids[i], write_log);
+          inserted++;
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+  if (write_log) {
+    for (auto xid : xids) {
+      log_manager.AppendCommitLog(xid);
+      transaction_manager.Commit(xid);
+    }
+  }
+  if (missing != 0) {
+    throw std::runtime_error(std::to_string(missing) + " lookups missed existing keys");
+  }
+  if (CountEntries(index, keys) != keys + inserted) {
+    throw std::runtime_error("entry count mismatch");
+  }
+  return threads * ops / std::chrono::duration<double>(end - begin).count();
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("index_concurrency_benchmark");
+  program.add_argument("-k", "--keys")
+      .help("Number of keys loaded before each run")
+      .default_value(100000u)
+      .scan<'u', unsigned>();
+  program.add_argument("-o", "--ops")
+      .help("Number of operations per thread")
+      .default_value(20000u)
+      .scan<'u', unsigned>();
+  program.add_argument("-r", "--read-percent")
+      .help("Percentage of lookups, the rest are inserts")
+      .default_value(80u)
+      .scan<'u', unsigned>();
+  program.add_argument("-b", "--buffer-pool-size")
+      .help("Number of buffer pool frames")
+      .default_value(65536u)
+      .scan<'u', unsigned>();
+  program.add_argument("-t", "--type").help("Index type, btree or hash").default_value(std::string("btree"));
+  program.add_argument("-l", "--log").help("Write logs for inserts").default_value(false).implicit_value(true);
+  program.add_argument("threads")
+      .help("Numbers of concurrent threads to benchmark")
+      .nargs(argparse::nargs_pattern::any)
+      .default_value(std::vector<std::string>{"1", "2", "4", "8", "16", "32"});
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  auto keys = program.get<unsigned>("--keys");
+  auto ops = program.get<unsigned>("--ops");
+  auto read_percent = program.get<unsigned>("--read-percent");
+  auto write_log = program.get<bool>("--log");
+  auto type = program.get<std::string>("--type");
+  if (type != "btree" && type != "hash") {
+    std::cerr << "index type must be btree or hash" << std::endl;
+    return 1;
+  }
+  auto index_type = type == "hash" ? huadb::IndexType::HASH : huadb::IndexType::BTREE;
+  if (keys == 0 || read_percent > 100) {
+    std::cerr << "keys must be positive and read percent must not exceed 100" << std::endl;
+    return 1;
+  }
+  auto work_path = std::filesystem::temp_directory_path() / ("huadb_benchmark_" + std::to_string(getpid()));
+  std::filesystem::create_directories(work_path);
+  auto origin_path = std::filesystem::current_path();
+  std::filesystem::current_path(work_path);
+  {
+    huadb::Disk disk;
+    huadb::LockManager lock_manager;
+    huadb::TransactionManager transaction_manager(lock_manager, huadb::FIRST_XID);
+    huadb::LogManager log_manager(disk, transaction_manager, huadb::FIRST_LSN);
+    huadb::BufferPool buffer_pool(disk, log_manager, program.get<unsigned>("--buffer-pool-size"));
+    huadb::Disk::CreateDirectory(std::to_string(BENCHMARK_DB_OID));
+
+    std::cout << "index: " << type << ", keys: " << keys << ", ops per thread: " << ops << ", lookups: " << read_percent
+              << "%, buffer pool: " << buffer_pool.GetPoolSize() << " frames" << std::endl;
+    std::cout << std::setw(10) << "threads" << std::setw(16) << "ops/s" << std::setw(10) << "speedup" << std::endl;
+    double base = 0;
+    auto index_oid = BENCHMARK_TABLE_OID + 1;
+    for (const auto &threads : program.get<std::vector<std::string>>("threads")) {
+      auto thread_count = std::stoull(threads);
+      auto index = CreateIndex(buffer_pool, log_manager, index_oid++, keys, index_type);
+      auto throughput = Run(*index, transaction_manager, log_manager, thread_count, keys, ops, read_percent, write_log);
+      if (base == 0) {
+        base = throughput;
+      }
+      std::cout << std::setw(10) << thread_count << std::setw(16) << std::fixed << std::setprecision(0) << throughput
+                << std::setw(10) << std::setprecision(2) << throughput / base << std::endl;
+    }
+  }
+  std::filesystem::current_path(origin_path);
+  std::filesystem::remove_all(work_path);
+  return 0;
+}
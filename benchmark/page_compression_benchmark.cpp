@@ -0,0 +1,140 @@
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "argparse/argparse.hpp"
+#include "common/constants.h"
+#include "common/result_writer.h"
+#include "database/connection.h"
+#include "database/database_engine.h"
+
+static constexpr size_t INSERT_BATCH_SIZE = 100;
+
+std::string Execute(const huadb::Connection &connection, const std::string &sql) {
+  std::ostringstream result;
+  huadb::SimpleWriter writer(result, true);
+  connection.SendQuery(sql, writer);
+  return result.str();
+}
+
+uint64_t GetStat(const huadb::Connection &connection, const std::string &stat_name) {
+  std::istringstream stats(Execute(connection, "show buffer_stats;"));
+  std::string name;
+  uint64_t value;
+  while (stats >> name >> value) {
+    if (name == stat_name) {
+      return value;
+    }
+  }
+  return 0;
+}
+
+// 统计用户表页面文件的文件大小和实际占用的磁盘空间，不包括系统数据库和空闲空间映射表
+void GetFileSizes(uint64_t &file_bytes, uint64_t &allocated_bytes) {
+  file_bytes = 0;
+  allocated_bytes = 0;
+  for (const auto &db_entry : std::filesystem::directory_iterator(huadb::BASE_PATH)) {
+    if (!db_entry.is_directory() || db_entry.path().filename() == std::to_string(huadb::SYSTEM_DATABASE_OID)) {
+      continue;
+    }
+    for (const auto &entry : std::filesystem::directory_iterator(db_entry.path())) {
+      if (entry.path().filename().string().find('_') != std::string::npos) {
+        continue;
+      }
+      struct stat file_stat;
+      if (stat(entry.path().c_str(), &file_stat) == 0) {
+        file_bytes += file_stat.st_size;
+        allocated_bytes += file_stat.st_blocks * 512;
+      }
+    }
+  }
+}
+
+// 在新数据库中以 compression 压缩方式建表并插入 rows 行，重启后全表扫描 scans 次
+// 表中的字符串列取值重复较多，模拟写入后很少修改的冷数据
+void Run(const std::string &compression, size_t page_size, size_t buffer_bytes, size_t rows, size_t scans) {
+  auto frames = std::max<size_t>(buffer_bytes / page_size, 1);
+  auto database = std::make_unique<huadb::DatabaseEngine>(frames, page_size);
+  auto connection = std::make_unique<huadb::Connection>(*database);
+  Execute(*connection, "create table cold_1(id int, amount int, status varchar(16), info varchar(64)) with "
+                       "(compression = '" + compression + "');");
+  const std::vector<std::string> statuses = {"created", "paid", "shipped", "delivered", "returned"};
+  for (size_t i = 0; i < rows; i += INSERT_BATCH_SIZE) {
+    std::string sql = "insert into cold_1 values ";
+    for (size_t j = i; j < std::min(rows, i + INSERT_BATCH_SIZE); j++) {
+      sql += (j == i ? "(" : ", (") + std::to_string(j) + ", " + std::to_string(j % 1000) + ", '" +
+             statuses[j % statuses.size()] + "', 'order from warehouse " + std::to_string(j % 8) + "')";
+    }
+    Execute(*connection, sql + ";");
+  }
+  // 插入过程中被淘汰的页面的压缩比
+  auto compressed_count = GetStat(*connection, "compressed_write_count");
+  auto compressed_bytes = GetStat(*connection, "compressed_write_bytes");
+  // 重启数据库，扫描从磁盘读取页面
+  connection.reset();
+  database.reset();
+  uint64_t file_bytes, allocated_bytes;
+  GetFileSizes(file_bytes, allocated_bytes);
+  database = std::make_unique<huadb::DatabaseEngine>(frames, page_size);
+  connection = std::make_unique<huadb::Connection>(*database);
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < scans; i++) {
+    // 过滤条件不满足任何记录，避免结果输出的开销
+    Execute(*connection, "select id from cold_1 where id = -1;");
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto seconds = std::chrono::duration<double>(end - begin).count();
+  std::cout << std::setw(12) << compression << std::setw(10) << page_size << std::setw(14) << file_bytes / 1024
+            << std::setw(14) << allocated_bytes / 1024 << std::setw(14) << std::fixed << std::setprecision(2)
+            << (compressed_bytes == 0 ? 1.0 : static_cast<double>(compressed_count * page_size) / compressed_bytes)
+            << std::setw(14) << std::setprecision(0) << rows * scans / seconds << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("page_compression_benchmark");
+  program.add_argument("-r", "--rows").help("Number of table rows").default_value(50000u).scan<'u', unsigned>();
+  program.add_argument("-s", "--scans").help("Number of full scans").default_value(5u).scan<'u', unsigned>();
+  program.add_argument("-m", "--buffer-bytes")
+      .help("Buffer pool memory in bytes, scans read most pages from disk")
+      .default_value(65536u)
+      .scan<'u', unsigned>();
+  program.add_argument("page_sizes")
+      .help("Page sizes to benchmark")
+      .nargs(argparse::nargs_pattern::any)
+      .default_value(std::vector<std::string>{"4096", "16384", "32768"});
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  auto origin_path = std::filesystem::current_path();
+  std::cout << std::setw(12) << "compression" << std::setw(10) << "page size" << std::setw(14) << "file KB"
+            << std::setw(14) << "allocated KB" << std::setw(14) << "write ratio" << std::setw(14) << "scan rows/s"
+            << std::endl;
+  for (const auto &page_size : program.get<std::vector<std::string>>("page_sizes")) {
+    for (const auto &compression : {"none", "lz"}) {
+      auto work_path = std::filesystem::temp_directory_path() /
+                       ("huadb_benchmark_" + std::to_string(getpid()) + "_" + compression + "_" + page_size);
+      std::filesystem::create_directories(work_path);
+      std::filesystem::current_path(work_path);
+      Run(compression, std::stoull(page_size), program.get<unsigned>("--buffer-bytes"),
+          program.get<unsigned>("--rows"), program.get<unsigned>("--scans"));
+      std::filesystem::current_path(origin_path);
+      std::filesystem::remove_all(work_path);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,105 @@
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "argparse/argparse.hpp"
+#include "common/constants.h"
+#include "common/result_writer.h"
+#include "database/connection.h"
+#include "database/database_engine.h"
+
+static constexpr size_t INSERT_BATCH_SIZE = 100;
+
+std::string Execute(const huadb::Connection &connection, const std::string &sql) {
+  std::ostringstream result;
+  huadb::SimpleWriter writer(result, true);
+  connection.SendQuery(sql, writer);
+  return result.str();
+}
+
+// 在 page_size 大小的新数据库中建表并插入 rows 行，重启后全表扫描 scans 次
+// buffer pool 页面数为 buffer_bytes / page_size，各页面大小下缓存占用的内存相同
+void Run(size_t page_size, size_t buffer_bytes, size_t rows, size_t scans) {
+  auto frames = std::max<size_t>(buffer_bytes / page_size, 1);
+  auto database = std::make_unique<huadb::DatabaseEngine>(frames, page_size);
+  auto connection = std::make_unique<huadb::Connection>(*database);
+  Execute(*connection, "create table scan_1(id int, info varchar(100));");
+  std::string padding(64, 'x');
+  for (size_t i = 0; i < rows; i += INSERT_BATCH_SIZE) {
+    std::string sql = "insert into scan_1 values ";
+    for (size_t j = i; j < std::min(rows, i + INSERT_BATCH_SIZE); j++) {
+      sql += (j == i ? "(" : ", (") + std::to_string(j) + ", '" + padding + "')";
+    }
+    Execute(*connection, sql + ";");
+  }
+  // 重启数据库，扫描从磁盘读取页面
+  connection.reset();
+  database.reset();
+  database = std::make_unique<huadb::DatabaseEngine>(frames, page_size);
+  connection = std::make_unique<huadb::Connection>(*database);
+
+  Execute(*connection, "reset buffer_stats;");
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < scans; i++) {
+    // 过滤条件不满足任何记录，避免结果输出的开销
+    Execute(*connection, "select id from scan_1 where id = -1;");
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::istringstream stats(Execute(*connection, "show buffer_stats;"));
+  std::string name;
+  uint64_t value;
+  uint64_t read_count = 0;
+  while (stats >> name >> value) {
+    if (name == "read_count") {
+      read_count = value;
+    }
+  }
+  auto seconds = std::chrono::duration<double>(end - begin).count();
+  std::cout << std::setw(10) << page_size << std::setw(10) << frames << std::setw(14) << std::fixed
+            << std::setprecision(1) << static_cast<double>(read_count) / scans << std::setw(14) << std::setprecision(0)
+            << rows * scans / seconds << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("page_size_benchmark");
+  program.add_argument("-r", "--rows").help("Number of table rows").default_value(20000u).scan<'u', unsigned>();
+  program.add_argument("-s", "--scans").help("Number of full scans").default_value(10u).scan<'u', unsigned>();
+  program.add_argument("-m", "--buffer-bytes")
+      .help("Buffer pool memory in bytes, shared by all page sizes")
+      .default_value(65536u)
+      .scan<'u', unsigned>();
+  program.add_argument("page_sizes")
+      .help("Page sizes to benchmark")
+      .nargs(argparse::nargs_pattern::any)
+      .default_value(std::vector<std::string>{"256", "4096", "8192", "16384", "32768"});
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  auto origin_path = std::filesystem::current_path();
+  std::cout << std::setw(10) << "page size" << std::setw(10) << "frames" << std::setw(14) << "reads/scan"
+            << std::setw(14) << "rows/s" << std::endl;
+  for (const auto &page_size : program.get<std::vector<std::string>>("page_sizes")) {
+    auto work_path = std::filesystem::temp_directory_path() /
+                     ("huadb_benchmark_" + std::to_string(getpid()) + "_" + page_size);
+    std::filesystem::create_directories(work_path);
+    std::filesystem::current_path(work_path);
+    Run(std::stoull(page_size), program.get<unsigned>("--buffer-bytes"), program.get<unsigned>("--rows"),
+        program.get<unsigned>("--scans"));
+    std::filesystem::current_path(origin_path);
+    std::filesystem::remove_all(work_path);
+  }
+  return 0;
+}
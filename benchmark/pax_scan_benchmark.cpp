@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "argparse/argparse.hpp"
+#include "common/result_writer.h"
+#include "database/connection.h"
+#include "database/database_engine.h"
+
+static constexpr size_t INSERT_BATCH_SIZE = 100;
+
+std::string Execute(const huadb::Connection &connection, const std::string &sql) {
+  std::ostringstream result;
+  huadb::SimpleWriter writer(result, true);
+  connection.SendQuery(sql, writer);
+  return result.str();
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("pax_scan_benchmark");
+  program.add_argument("-r", "--rows").help("Number of table rows").default_value(20000u).scan<'u', unsigned>();
+  program.add_argument("-s", "--scans").help("Number of scans per query").default_value(20u).scan<'u', unsigned>();
+  program.add_argument("-p", "--page-size").help("Page size in bytes").default_value(4096u).scan<'u', unsigned>();
+  program.add_argument("queries")
+      .help("Select lists and where clauses to benchmark, table is t with columns a int, b int, c double, "
+            "d varchar(64), e varchar(64)")
+      .nargs(argparse::nargs_pattern::any)
+      .default_value(std::vector<std::string>{"a from t", "a from t where b < 100", "a, b, c from t", "* from t"});
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  auto rows = program.get<unsigned>("--rows");
+  auto scans = program.get<unsigned>("--scans");
+  auto page_size = program.get<unsigned>("--page-size");
+
+  auto origin_path = std::filesystem::current_path();
+  auto work_path = std::filesystem::temp_directory_path() / ("huadb_benchmark_" + std::to_string(getpid()));
+  std::filesystem::create_directories(work_path);
+  std::filesystem::current_path(work_path);
+  {
+    // 同一份数据分别以行存和 PAX 布局建表，buffer pool 可容纳两张表，测量的是扫描和物化的 CPU 开销
+    auto frames = rows * 256 / page_size + 16;
+    auto database = std::make_unique<huadb::DatabaseEngine>(frames, page_size);
+    auto connection = std::make_unique<huadb::Connection>(*database);
+    const std::vector<std::string> layouts = {"row", "pax"};
+    std::string padding(48, 'x');
+    for (const auto &layout : layouts) {
+      Execute(*connection, "create table t_" + layout +
+                               "(a int, b int, c double, d varchar(64), e varchar(64)) with (layout = '" + layout +
+                               "');");
+      for (size_t i = 0; i < rows; i += INSERT_BATCH_SIZE) {
+        std::string sql = "insert into t_" + layout + " values ";
+        for (size_t j = i; j < std::min<size_t>(rows, i + INSERT_BATCH_SIZE); j++) {
+          sql += (j == i ? "(" : ", (") + std::to_string(j) + ", " + std::to_string(j % 1000) + ", " +
+                 std::to_string(j) + ".5, '" + padding + "', '" + padding + "')";
+        }
+        Execute(*connection, sql + ";");
+      }
+      // 预热，将所有页面读入 buffer pool
+      Execute(*connection, "select a from t_" + layout + " where a = -1;");
+    }
+
+    std::cout << std::setw(28) << "query" << std::setw(14) << "row rows/s" << std::setw(14) << "pax rows/s"
+              << std::endl;
+    for (const auto &query : program.get<std::vector<std::string>>("queries")) {
+      std::cout << std::setw(28) << query;
+      for (const auto &layout : layouts) {
+        // 将查询中的表名 t 替换为对应布局的表
+        auto sql = "select " + query + ";";
+        auto pos = sql.find(" from t");
+        if (pos != std::string::npos) {
+          sql.replace(pos, 7, " from t_" + layout);
+        }
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < scans; i++) {
+          Execute(*connection, sql);
+        }
+        auto end = std::chrono::steady_clock::now();
+        auto seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << std::setw(14) << std::fixed << std::setprecision(0) << rows * scans / seconds;
+      }
+      std::cout << std::endl;
+    }
+  }
+  std::filesystem::current_path(origin_path);
+  std::filesystem::remove_all(work_path);
+  return 0;
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "argparse/argparse.hpp"
+#include "common/constants.h"
+#include "common/result_writer.h"
+#include "common/value.h"
+#include "database/connection.h"
+#include "database/database_engine.h"
+#include "table/record.h"
+
+static constexpr size_t INSERT_BATCH_SIZE = 100;
+
+// 统计堆内存分配字节数，用于计算每行记录占用的内存
+static std::atomic<uint64_t> allocated_bytes = 0;
+
+void *operator new(size_t size) {
+  allocated_bytes += size;
+  if (auto *ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, size_t size) noexcept { std::free(ptr); }
+
+std::string Execute(const huadb::Connection &connection, const std::string &sql) {
+  std::ostringstream result;
+  huadb::SimpleWriter writer(result, true);
+  connection.SendQuery(sql, writer);
+  return result.str();
+}
+
+// 构造 rows 条 (int, 短 varchar, 长 varchar, double) 记录，返回每条记录占用的堆内存字节数
+double MemoryPerRow(size_t rows) {
+  std::string padding(64, 'x');
+  std::vector<std::shared_ptr<huadb::Record>> records;
+  records.reserve(rows);
+  auto begin = allocated_bytes.load();
+  for (size_t i = 0; i < rows; i++) {
+    std::vector<huadb::Value> values;
+    values.emplace_back(static_cast<int32_t>(i));
+    values.emplace_back("row" + std::to_string(i));
+    values.emplace_back(padding);
+    values.emplace_back(static_cast<double>(i));
+    records.push_back(std::make_shared<huadb::Record>(std::move(values)));
+  }
+  return static_cast<double>(allocated_bytes.load() - begin) / rows;
+}
+
+// 执行 sql times 次，返回每秒执行次数
+double Throughput(const huadb::Connection &connection, const std::string &sql, size_t times) {
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < times; i++) {
+    Execute(connection, sql);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return times / std::chrono::duration<double>(end - begin).count();
+}
+
+void CreateTable(const huadb::Connection &connection, const std::string &name, size_t rows) {
+  Execute(connection, "create table " + name + "(id int, name varchar(20), info varchar(100));");
+  std::string padding(64, 'x');
+  for (size_t i = 0; i < rows; i += INSERT_BATCH_SIZE) {
+    std::string sql = "insert into " + name + " values ";
+    for (size_t j = i; j < std::min(rows, i + INSERT_BATCH_SIZE); j++) {
+      sql += (j == i ? "(" : ", (") + std::to_string(j) + ", 'row" + std::to_string(j) + "', '" + padding + "')";
+    }
+    Execute(connection, sql + ";");
+  }
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("value_benchmark");
+  program.add_argument("-r", "--rows")
+      .help("Number of rows of the scanned table")
+      .default_value(5000u)
+      .scan<'u', unsigned>();
+  program.add_argument("-j", "--join-rows")
+      .help("Number of rows of each joined table")
+      .default_value(300u)
+      .scan<'u', unsigned>();
+  program.add_argument("-t", "--times").help("Number of executions per query").default_value(10u).scan<'u', unsigned>();
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+  auto rows = program.get<unsigned>("--rows");
+  auto join_rows = program.get<unsigned>("--join-rows");
+  auto times = program.get<unsigned>("--times");
+
+  std::cout << "sizeof(Value): " << sizeof(huadb::Value) << std::endl;
+  std::cout << "sizeof(Record): " << sizeof(huadb::Record) << std::endl;
+  std::cout << "heap bytes per row: " << std::fixed << std::setprecision(1) << MemoryPerRow(rows) << std::endl;
+
+  auto origin_path = std::filesystem::current_path();
+  auto work_path = std::filesystem::temp_directory_path() / ("huadb_benchmark_" + std::to_string(getpid()));
+  std::filesystem::create_directories(work_path);
+  std::filesystem::current_path(work_path);
+  {
+    // buffer pool 可容纳所有表，测量的是记录物化、求值和连接的 CPU 开销
+    auto database = std::make_unique<huadb::DatabaseEngine>(4096);
+    auto connection = std::make_unique<huadb::Connection>(*database);
+    // 连接条件在连接算子上方的 Filter 中求值，每对记录都需要物化连接结果
+    Execute(*connection, "set enable_optimizer = false;");
+    CreateTable(*connection, "scan_1", rows);
+    CreateTable(*connection, "join_1", join_rows);
+    CreateTable(*connection, "join_2", join_rows);
+
+    std::vector<std::pair<std::string, size_t>> queries = {
+        {"select * from scan_1;", times},
+        {"select id, name from scan_1 order by name;", times},
+        {"select join_1.id from join_1, join_2 where join_1.name = join_2.name;", std::max(times / 5, 1u)},
+    };
+    std::cout << std::setw(72) << "query" << std::setw(14) << "queries/s" << std::endl;
+    for (const auto &[sql, count] : queries) {
+      Execute(*connection, sql);
+      std::cout << std::setw(72) << sql << std::setw(14) << std::setprecision(2) << Throughput(*connection, sql, count)
+                << std::endl;
+    }
+  }
+  std::filesystem::current_path(origin_path);
+  std::filesystem::remove_all(work_path);
+  return 0;
+}
@@ -1,11 +1,20 @@
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "argparse/argparse.hpp"
+#include "catalog/system_schema.h"
 #include "common/constants.h"
+#include "common/type_util.h"
+#include "storage/disk.h"
+#include "table/pax_page.h"
 #include "table/table_page.h"
 
 namespace fs = std::filesystem;
@@ -28,42 +37,167 @@ void parse_control(const fs::path &path) {
   huadb::oid_t oid;
   bool normal_shutdown;
   file >> xid >> lsn >> oid >> normal_shutdown;
+  // 版本 1 的控制文件不含版本号和页面大小
+  uint32_t version;
+  size_t page_size;
+  if (!(file >> version >> page_size)) {
+    version = 1;
+    page_size = huadb::DEFAULT_DB_PAGE_SIZE;
+  }
   std::cout << "next xid: " << xid << std::endl;
   std::cout << "next lsn: " << lsn << std::endl;
   std::cout << "next oid: " << oid << std::endl;
   std::cout << "normal_shutdown: " << normal_shutdown << std::endl;
+  std::cout << "version: " << version << std::endl;
+  std::cout << "page size: " << page_size << std::endl;
 }
 
-void parse_data(const fs::path &path) {
-  if (!fs::is_regular_file(path)) {
-    std::cerr << "File not found: " << path << std::endl;
-    std::exit(1);
+// 数据文件路径为 BASE_PATH/db_oid/table_oid，从 BASE_PATH 下的控制文件读取页面大小
+size_t read_page_size(const fs::path &data_path) {
+  std::ifstream file(data_path.parent_path().parent_path() / huadb::CONTROL_NAME);
+  huadb::xid_t xid;
+  huadb::lsn_t lsn;
+  huadb::oid_t oid;
+  bool normal_shutdown;
+  uint32_t version;
+  size_t page_size;
+  if (file >> xid >> lsn >> oid >> normal_shutdown >> version >> page_size) {
+    return page_size;
   }
+  return huadb::DEFAULT_DB_PAGE_SIZE;
+}
+
+// 逐页读取页面文件，压缩页面解压后交给 visitor，解压失败时 page 为空指针
+void read_pages(const fs::path &path, size_t page_size,
+                const std::function<void(huadb::pageid_t, std::shared_ptr<huadb::Page>)> &visitor) {
   std::ifstream file(path, std::fstream::binary);
   if (file.fail()) {
     std::cerr << "Failed to open file: " << path << std::endl;
     std::exit(1);
   }
-  char buffer[huadb::DB_PAGE_SIZE];
+  std::vector<char> buffer(page_size);
   huadb::pageid_t page_id = 0;
   while (!file.eof()) {
-    file.read(buffer, huadb::DB_PAGE_SIZE);
+    file.read(buffer.data(), page_size);
     if (file.gcount() == 0) {
       break;
     }
-    if (file.gcount() != huadb::DB_PAGE_SIZE) {
+    if (static_cast<size_t>(file.gcount()) != page_size) {
       std::cerr << "Incorrect page size" << std::endl;
       std::exit(1);
     }
-    auto page = std::make_unique<huadb::Page>();
-    memcpy(page->GetData(), buffer, huadb::DB_PAGE_SIZE);
-    huadb::TablePage table_page(std::move(page));
-    std::cout << "page id: " << page_id << std::endl;
-    std::cout << table_page.ToString() << std::endl;
+    auto page = std::make_shared<huadb::Page>(page_size);
+    memcpy(page->GetData(), buffer.data(), page_size);
+    if (!huadb::Disk::DecompressPage(page->GetData(), page_size)) {
+      page = nullptr;
+    }
+    visitor(page_id, std::move(page));
     page_id++;
   }
 }
 
+// 遍历系统表中未删除的记录，系统表均为行存且不压缩
+void scan_system_table(const fs::path &base_path, huadb::oid_t oid, const huadb::ColumnList &column_list,
+                       size_t page_size, const std::function<void(const huadb::Record &)> &visitor) {
+  auto path = base_path / std::to_string(huadb::SYSTEM_DATABASE_OID) / std::to_string(oid);
+  if (!fs::is_regular_file(path)) {
+    return;
+  }
+  read_pages(path, page_size, [&](huadb::pageid_t page_id, std::shared_ptr<huadb::Page> page) {
+    if (page == nullptr) {
+      return;
+    }
+    huadb::TablePage table_page(std::move(page));
+    for (huadb::slotid_t slot_id = 0; slot_id < table_page.GetRecordCount(); slot_id++) {
+      if (!table_page.IsSlotUsed(slot_id)) {
+        continue;
+      }
+      auto record = table_page.GetRecord({page_id, slot_id}, column_list);
+      if (!record->IsDeleted()) {
+        visitor(*record);
+      }
+    }
+  });
+}
+
+// 表的页面格式，从系统表 huadb_table 中的表结构读取
+struct TableFormat {
+  huadb::ColumnList column_list_;
+  huadb::TableLayout layout_ = huadb::TableLayout::ROW;
+  huadb::CompressionType compression_ = huadb::CompressionType::NONE;
+};
+
+// 系统表均为行存，索引文件不是表页面，不在 huadb_table 中的文件无法确定页面格式，均报错退出
+TableFormat read_table_format(const fs::path &base_path, huadb::oid_t oid, size_t page_size) {
+  TableFormat format;
+  if (oid <= huadb::PRESERVED_OID) {
+    return format;
+  }
+  bool is_index = false;
+  auto index_oid_idx = huadb::index_meta_schema.GetColumnIndex("index_oid");
+  scan_system_table(base_path, huadb::INDEX_META_OID, huadb::index_meta_schema, page_size,
+                    [&](const huadb::Record &record) {
+                      is_index |= record.GetValue(index_oid_idx).GetValue<huadb::oid_t>() == oid;
+                    });
+  if (is_index) {
+    std::cerr << "Index files are not supported" << std::endl;
+    std::exit(1);
+  }
+  bool found = false;
+  auto table_oid_idx = huadb::table_meta_schema.GetColumnIndex("table_oid");
+  auto schema_idx = huadb::table_meta_schema.GetColumnIndex("schema");
+  scan_system_table(base_path, huadb::TABLE_META_OID, huadb::table_meta_schema, page_size,
+                    [&](const huadb::Record &record) {
+                      if (record.GetValue(table_oid_idx).GetValue<huadb::oid_t>() != oid) {
+                        return;
+                      }
+                      // 与 SystemCatalog::LoadTableMeta 相同，表选项以"选项名 值"的形式追加在列定义之后
+                      std::istringstream iss(record.GetValue(schema_idx).GetValue<std::string>());
+                      format.column_list_.FromString(iss);
+                      std::string option, option_value;
+                      while (iss >> option >> option_value) {
+                        if (option == "layout") {
+                          format.layout_ = huadb::TypeUtil::String2Layout(option_value);
+                        } else if (option == "compression") {
+                          format.compression_ = huadb::TypeUtil::String2Compression(option_value);
+                        }
+                      }
+                      found = true;
+                    });
+  if (!found) {
+    std::cerr << "Table with oid " << oid << " not found in " << huadb::TABLE_META_NAME << std::endl;
+    std::exit(1);
+  }
+  return format;
+}
+
+void parse_data(const fs::path &path) {
+  if (!fs::is_regular_file(path)) {
+    std::cerr << "File not found: " << path << std::endl;
+    std::exit(1);
+  }
+  // 页面文件以表的 oid 命名，空闲空间映射表等其他文件不是页面文件
+  auto file_name = path.filename().string();
+  if (file_name.empty() || !std::all_of(file_name.begin(), file_name.end(), ::isdigit)) {
+    std::cerr << "Not a data file: " << path << std::endl;
+    std::exit(1);
+  }
+  auto page_size = read_page_size(path);
+  auto format = read_table_format(path.parent_path().parent_path(), std::stoul(file_name), page_size);
+  std::cout << "layout: " << huadb::TypeUtil::Layout2String(format.layout_)
+            << ", compression: " << huadb::TypeUtil::Compression2String(format.compression_) << std::endl;
+  read_pages(path, page_size, [&](huadb::pageid_t page_id, std::shared_ptr<huadb::Page> page) {
+    std::cout << "page id: " << page_id << std::endl;
+    if (page == nullptr) {
+      std::cout << "***Error: corrupted compressed page***" << std::endl;
+    } else if (format.layout_ == huadb::TableLayout::PAX) {
+      std::cout << huadb::PaxPage(std::move(page), format.column_list_).ToString() << std::endl;
+    } else {
+      std::cout << huadb::TablePage(std::move(page)).ToString() << std::endl;
+    }
+  });
+}
+
 void parse_log(const fs::path &path) {
   auto next_lsn_name = path / huadb::NEXT_LSN_NAME;
   auto log_name = path / huadb::LOG_NAME;
@@ -28,6 +28,8 @@
 #include "binder/table_refs/table_refs.h"
 #include "catalog/column_definition.h"
 #include "common/exceptions.h"
+#include "common/string_util.h"
+#include "common/type_util.h"
 #include "common/value.h"
 #include "nodes/parsenodes.hpp"
 
@@ -109,7 +111,36 @@ std::unique_ptr<Statement> Binder::BindCreateTableStatement(duckdb_libpgquery::P
         throw DbException("Unsupported node type: " + NodeTagToString(node->type));
     }
   }
-  return std::make_unique<CreateTableStatement>(std::move(table_name), std::move(columns));
+  auto layout = TableLayout::ROW;
+  auto compression = CompressionType::NONE;
+  if (stmt->options != nullptr) {
+    for (auto *node = stmt->options->head; node != nullptr; node = lnext(node)) {
+      auto *elem = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(node->data.ptr_value);
+      std::string option = elem->defname;
+      std::transform(option.begin(), option.end(), option.begin(), ::tolower);
+      if (option != "layout" && option != "compression") {
+        throw DbException("Unknown table option: " + std::string(elem->defname));
+      }
+      // layout = pax 中的 pax 被解析为类型名，layout = 'pax' 被解析为字符串
+      std::string value;
+      if (elem->arg != nullptr && elem->arg->type == duckdb_libpgquery::T_PGTypeName) {
+        auto *type_name = reinterpret_cast<duckdb_libpgquery::PGTypeName *>(elem->arg);
+        auto *name = reinterpret_cast<duckdb_libpgquery::PGValue *>(type_name->names->tail->data.ptr_value);
+        value = name->val.str;
+      } else if (elem->arg != nullptr && elem->arg->type == duckdb_libpgquery::T_PGString) {
+        value = reinterpret_cast<duckdb_libpgquery::PGValue *>(elem->arg)->val.str;
+      } else {
+        throw DbException("Table option \"" + option + "\" requires a name");
+      }
+      std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+      if (option == "layout") {
+        layout = TypeUtil::String2Layout(value);
+      } else {
+        compression = TypeUtil::String2Compression(value);
+      }
+    }
+  }
+  return std::make_unique<CreateTableStatement>(std::move(table_name), std::move(columns), layout, compression);
 }
 
 std::unique_ptr<Statement> Binder::BindCreateIndexStatement(duckdb_libpgquery::PGIndexStmt *stmt) {
@@ -129,8 +160,41 @@ std::unique_ptr<Statement> Binder::BindCreateIndexStatement(duckdb_libpgquery::P
       throw DbException("Unknown node type in index statement: " + NodeTagToString(pg_node->type));
     }
   }
+  // 未指定 USING 时解析器给出默认的访问方法，按 B+ 树处理
+  auto index_type = IndexType::BTREE;
+  if (stmt->accessMethod != nullptr && std::string(stmt->accessMethod) != DEFAULT_INDEX_TYPE) {
+    index_type = TypeUtil::String2IndexType(stmt->accessMethod);
+  }
+  // 解析器不支持 INCLUDE 子句，附加列通过 WITH (include = 'c1, c2') 指定，单个列名也可以不加引号
+  std::vector<std::string> include_columns;
+  if (stmt->options != nullptr) {
+    for (auto *node = stmt->options->head; node != nullptr; node = lnext(node)) {
+      auto *elem = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(node->data.ptr_value);
+      std::string option = elem->defname;
+      std::transform(option.begin(), option.end(), option.begin(), ::tolower);
+      if (option != "include") {
+        throw DbException("Unknown index option: " + std::string(elem->defname));
+      }
+      std::string value;
+      if (elem->arg != nullptr && elem->arg->type == duckdb_libpgquery::T_PGTypeName) {
+        auto *type_name = reinterpret_cast<duckdb_libpgquery::PGTypeName *>(elem->arg);
+        value = reinterpret_cast<duckdb_libpgquery::PGValue *>(type_name->names->tail->data.ptr_value)->val.str;
+      } else if (elem->arg != nullptr && elem->arg->type == duckdb_libpgquery::T_PGString) {
+        value = reinterpret_cast<duckdb_libpgquery::PGValue *>(elem->arg)->val.str;
+      } else {
+        throw DbException("Index option \"include\" requires column names");
+      }
+      for (auto column : StringUtil::Split(value, ',')) {
+        column.erase(0, column.find_first_not_of(' '));
+        if (column.empty()) {
+          throw DbException("Empty column name in index option \"include\"");
+        }
+        include_columns.push_back(std::move(column));
+      }
+    }
+  }
   return std::make_unique<CreateIndexStatement>(std::move(index_name), std::move(stmt->relation->relname),
-                                                std::move(columns));
+                                                std::move(columns), index_type, std::move(include_columns));
 }
 
 ColumnDefinition Binder::BindColumnDefinition(duckdb_libpgquery::PGColumnDef *col_def) {
@@ -320,6 +384,8 @@ std::unique_ptr<Statement> Binder::BindExplainStatement(duckdb_libpgquery::PGExp
         explain_options |= ExplainOptions::PLANNER;
       } else if (strcasecmp(elem->defname, "optimizer") == 0) {
         explain_options |= ExplainOptions::OPTIMIZER;
+      } else if (strcasecmp(elem->defname, "analyze") == 0) {
+        explain_options |= ExplainOptions::ANALYZE;
       } else {
         throw DbException("Unknown explain option: " + std::string(elem->defname));
       }
@@ -362,6 +428,12 @@ std::unique_ptr<Statement> Binder::BindLockStatement(duckdb_libpgquery::PGLockSt
 }
 
 std::unique_ptr<Statement> Binder::BindVariableSetStatement(duckdb_libpgquery::PGVariableSetStmt *stmt) {
+  if (stmt->kind == duckdb_libpgquery::VAR_RESET) {
+    return std::make_unique<VariableSetStatement>(stmt->name, "", true);
+  }
+  if (stmt->kind != duckdb_libpgquery::VAR_SET_VALUE) {
+    throw DbException("Only SET variable = value and RESET variable are supported");
+  }
   auto expr = BindExpressionList(stmt->args);
   if (expr.size() != 1) {
     throw DbException("SET takes only one argument");
@@ -382,7 +454,59 @@ std::unique_ptr<Statement> Binder::BindVariableShowStatement(duckdb_libpgquery::
 }
 
 std::unique_ptr<Statement> Binder::BindCopyStatement(duckdb_libpgquery::PGCopyStmt *stmt) {
-  throw DbException("BindCopyStatement not implemented");
+  if (!stmt->is_from || stmt->is_program || stmt->filename == nullptr || stmt->query != nullptr) {
+    throw DbException("Only COPY table FROM 'file' is supported");
+  }
+  if (stmt->attlist != nullptr) {
+    throw DbException("Column list in COPY is not supported");
+  }
+  auto table = BindBaseTableRef(stmt->relation->relname, std::nullopt);
+  char delimiter = ',';
+  bool header = false;
+  if (stmt->options != nullptr) {
+    for (auto *node = stmt->options->head; node != nullptr; node = lnext(node)) {
+      auto *elem = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(node->data.ptr_value);
+      std::string option = elem->defname;
+      std::transform(option.begin(), option.end(), option.begin(), ::tolower);
+      // 选项值可能为空（如 HEADER）、整数、字符串或类型名（如 FORMAT csv）
+      std::string value;
+      if (elem->arg == nullptr) {
+        value = "true";
+      } else if (elem->arg->type == duckdb_libpgquery::T_PGInteger) {
+        value = std::to_string(reinterpret_cast<duckdb_libpgquery::PGValue *>(elem->arg)->val.ival);
+      } else if (elem->arg->type == duckdb_libpgquery::T_PGString) {
+        value = reinterpret_cast<duckdb_libpgquery::PGValue *>(elem->arg)->val.str;
+      } else if (elem->arg->type == duckdb_libpgquery::T_PGTypeName) {
+        auto *type_name = reinterpret_cast<duckdb_libpgquery::PGTypeName *>(elem->arg);
+        value = reinterpret_cast<duckdb_libpgquery::PGValue *>(type_name->names->tail->data.ptr_value)->val.str;
+      } else {
+        throw DbException("Invalid value for COPY option \"" + option + "\"");
+      }
+      if (option == "format") {
+        std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+        if (value != "csv") {
+          throw DbException("Unsupported COPY format: " + value);
+        }
+      } else if (option == "delimiter") {
+        if (value.size() != 1) {
+          throw DbException("COPY delimiter must be a single character");
+        }
+        delimiter = value[0];
+      } else if (option == "header") {
+        std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+        if (value == "true" || value == "1") {
+          header = true;
+        } else if (value == "false" || value == "0") {
+          header = false;
+        } else {
+          throw DbException("Invalid value for COPY option \"header\": " + value);
+        }
+      } else {
+        throw DbException("Unknown COPY option: " + std::string(elem->defname));
+      }
+    }
+  }
+  return std::make_unique<CopyStatement>(std::move(table), stmt->filename, delimiter, header);
 }
 
 std::unique_ptr<Statement> Binder::BindVacuumStatement(duckdb_libpgquery::PGVacuumStmt *stmt) {
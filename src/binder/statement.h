@@ -7,6 +7,7 @@ namespace huadb {
 enum class StatementType {
   ANALYZE_STATEMENT,
   CHECKPOINT_STATEMENT,
+  COPY_STATEMENT,
   CREATE_DATABASE_STATEMENT,
   CREATE_INDEX_STATEMENT,
   CREATE_TABLE_STATEMENT,
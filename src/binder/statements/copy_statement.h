@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+
+#include "binder/statement.h"
+#include "binder/table_refs/base_table_ref.h"
+#include "fmt/format.h"
+
+namespace huadb {
+
+class CopyStatement : public Statement {
+ public:
+  CopyStatement(std::unique_ptr<BaseTableRef> table, std::string file_path, char delimiter, bool header)
+      : Statement(StatementType::COPY_STATEMENT),
+        table_(std::move(table)),
+        file_path_(std::move(file_path)),
+        delimiter_(delimiter),
+        header_(header) {}
+  std::string ToString() const override {
+    return fmt::format("CopyStatement: {} from {}, delimiter={}, header={}\n", table_, file_path_, delimiter_,
+                       header_);
+  }
+
+  std::unique_ptr<BaseTableRef> table_;
+  std::string file_path_;  // 相对路径相对于数据目录
+  char delimiter_;
+  bool header_;  // 第一行是否为表头
+};
+
+}  // namespace huadb
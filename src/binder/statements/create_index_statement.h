@@ -2,20 +2,29 @@
 
 #include "binder/statement.h"
 #include "binder/table_refs/base_table_ref.h"
+#include "common/type_util.h"
 
 namespace huadb {
 
 class CreateIndexStatement : public Statement {
  public:
-  CreateIndexStatement(std::string index_name, std::string table_name, std::vector<std::string> column_names)
+  CreateIndexStatement(std::string index_name, std::string table_name, std::vector<std::string> column_names,
+                       IndexType index_type, std::vector<std::string> include_column_names = {})
       : Statement(StatementType::CREATE_INDEX_STATEMENT),
         index_name_(std::move(index_name)),
         table_name_(std::move(table_name)),
-        column_names_(std::move(column_names)) {}
-  std::string ToString() const override { return fmt::format("CreateIndexStatement: name={}\n", index_name_); }
+        column_names_(std::move(column_names)),
+        index_type_(index_type),
+        include_column_names_(std::move(include_column_names)) {}
+  std::string ToString() const override {
+    return fmt::format("CreateIndexStatement: name={} type={}\n", index_name_,
+                       TypeUtil::IndexType2String(index_type_));
+  }
   std::string index_name_;
   std::string table_name_;
   std::vector<std::string> column_names_;
+  IndexType index_type_;
+  std::vector<std::string> include_column_names_;  // 只保存在索引项中、不参与比较的附加列
 };
 
 }  // namespace huadb
@@ -3,19 +3,28 @@
 #include <string>
 
 #include "binder/statement.h"
+#include "common/type_util.h"
 #include "fmt/ranges.h"
 
 namespace huadb {
 
 class CreateTableStatement : public Statement {
  public:
-  CreateTableStatement(std::string table, std::vector<ColumnDefinition> columns)
-      : Statement(StatementType::CREATE_TABLE_STATEMENT), table_(std::move(table)), columns_(std::move(columns)) {}
+  CreateTableStatement(std::string table, std::vector<ColumnDefinition> columns, TableLayout layout,
+                       CompressionType compression)
+      : Statement(StatementType::CREATE_TABLE_STATEMENT),
+        table_(std::move(table)),
+        columns_(std::move(columns)),
+        layout_(layout),
+        compression_(compression) {}
   std::string ToString() const override {
-    return fmt::format("CreateTableStatement: table={} columns={}\n", table_, columns_);
+    return fmt::format("CreateTableStatement: table={} columns={} layout={} compression={}\n", table_, columns_,
+                       TypeUtil::Layout2String(layout_), TypeUtil::Compression2String(compression_));
   }
   std::string table_;
   std::vector<ColumnDefinition> columns_;
+  TableLayout layout_;
+  CompressionType compression_;
 };
 
 }  // namespace huadb
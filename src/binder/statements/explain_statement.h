@@ -11,6 +11,7 @@ enum ExplainOptions {
   BINDER = 1,
   PLANNER = 2,
   OPTIMIZER = 4,
+  ANALYZE = 8,  // 执行查询，输出结果行数和各顺序扫描检查、跳过的页面数
 };
 
 class ExplainStatement : public Statement {
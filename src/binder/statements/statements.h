@@ -2,6 +2,7 @@
 
 #include "binder/statements/analyze_statement.h"
 #include "binder/statements/checkpoint_statement.h"
+#include "binder/statements/copy_statement.h"
 #include "binder/statements/create_database_statement.h"
 #include "binder/statements/create_index_statement.h"
 #include "binder/statements/create_table_statement.h"
@@ -7,14 +7,19 @@ namespace huadb {
 
 class VariableSetStatement : public Statement {
  public:
-  VariableSetStatement(std::string variable, std::string value)
-      : Statement(StatementType::VARIABLE_SET_STATEMENT), variable_(std::move(variable)), value_(std::move(value)) {}
+  VariableSetStatement(std::string variable, std::string value, bool reset = false)
+      : Statement(StatementType::VARIABLE_SET_STATEMENT),
+        variable_(std::move(variable)),
+        value_(std::move(value)),
+        reset_(reset) {}
   std::string ToString() const override {
-    return fmt::format("VariableSetStatement: variable={}, value={}\n", variable_, value_);
+    return fmt::format("VariableSetStatement: variable={}, value={}, reset={}\n", variable_, value_, reset_);
   }
 
   std::string variable_;
   std::string value_;
+  // RESET 语句
+  bool reset_;
 };
 
 }  // namespace huadb
@@ -59,6 +59,10 @@ std::string ColumnList::ToString() const {
 
 void ColumnList::FromString(const std::string &str) {
   std::istringstream iss(str);
+  FromString(iss);
+}
+
+void ColumnList::FromString(std::istream &iss) {
   db_size_t size;
   iss >> size;
   columns_.resize(size);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <istream>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -32,6 +33,8 @@ class ColumnList {
   std::string ToString() const;
   // 字符串格式反序列化
   void FromString(const std::string &str);
+  // 从输入流中反序列化，读取结束后输入流停在列定义之后
+  void FromString(std::istream &iss);
 
  private:
   std::vector<ColumnDefinition> columns_;
@@ -1,10 +1,13 @@
 #include "catalog/simple_catalog.h"
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 
 #include "common/constants.h"
 #include "common/exceptions.h"
+#include "common/type_util.h"
+#include "table/pax_page.h"
 #include "table/table.h"
 
 namespace huadb {
@@ -39,17 +42,21 @@ void SimpleCatalog::LoadSystemTables() {
   for (const auto &table_name : table_names) {
     std::ifstream table_in(std::to_string(current_database_oid_) + "/" + table_name + ".meta");
     oid_t oid, db_oid;
-    std::string name, desc;
+    std::string name;
     table_in >> oid >> db_oid >> name;
-    while (!table_in.eof()) {
-      std::string tmp;
-      table_in >> tmp;
-      desc += " ";
-      desc += tmp;
-    }
     ColumnList column_list;
-    column_list.FromString(desc);
-    CreateTable(name, column_list, oid, db_oid, false);
+    column_list.FromString(table_in);
+    auto layout = TableLayout::ROW;
+    auto compression = CompressionType::NONE;
+    std::string option, option_value;
+    while (table_in >> option >> option_value) {
+      if (option == "layout") {
+        layout = TypeUtil::String2Layout(option_value);
+      } else if (option == "compression") {
+        compression = TypeUtil::String2Compression(option_value);
+      }
+    }
+    CreateTable(name, column_list, oid, db_oid, false, layout, compression);
   }
 }
 
@@ -74,7 +81,7 @@ void SimpleCatalog::ChangeDatabase(const std::string &database_name) {
 }
 
 void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList &column_list, oid_t oid, oid_t db_oid,
-                                bool new_table) {
+                                bool new_table, TableLayout layout, CompressionType compression) {
   // Step1. 约束检测
   if (db_oid == INVALID_OID) {
     db_oid = current_database_oid_;
@@ -82,6 +89,9 @@ void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList
   if (oid_manager_.EntryExists(OidType::TABLE, table_name)) {
     throw DbException("Table \"" + table_name + "\" already exists");
   }
+  if (new_table && layout == TableLayout::PAX) {
+    PaxPage::ComputeCapacity(column_list, buffer_pool_.GetPageSize());
+  }
   // Step2. OidManager添加对应项
   if (oid == INVALID_OID) {
     oid = oid_manager_.CreateEntry(OidType::TABLE, table_name);
@@ -98,7 +108,7 @@ void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList
   }
   name2oid_[table_name] = oid;
   oid2table_[oid] = std::make_shared<Table>(buffer_pool_, log_manager_, oid, db_oid, column_list, new_table,
-                                            Disk::EmptyFile(Disk::GetFilePath(db_oid, oid)));
+                                            Disk::EmptyFile(Disk::GetFilePath(db_oid, oid)), layout, compression);
 
   // 检查：非新表不需要添加到Meta中
   if (!new_table) {
@@ -108,6 +118,12 @@ void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList
   // Step4. 写入到持久化文件table_name.meta
   std::ofstream out(std::to_string(current_database_oid_) + "/" + table_name + ".meta");
   out << oid << " " << current_database_oid_ << " " << table_name << " " << column_list.ToString();
+  if (layout != TableLayout::ROW) {
+    out << "layout " << TypeUtil::Layout2String(layout) << "\n";
+  }
+  if (compression != CompressionType::NONE) {
+    out << "compression " << TypeUtil::Compression2String(compression) << "\n";
+  }
   std::ofstream db_out(std::to_string(current_database_oid_) + "/tables", std::ios::app);
   db_out << table_name << " ";
 }
@@ -121,8 +137,13 @@ void SimpleCatalog::DropTable(const std::string &table_name) {
   // Step2. 实际删除表
   // 磁盘中删除对应项
   Disk::RemoveFile(Disk::GetFilePath(current_database_oid_, table_oid));
+  Disk::RemoveFile(Disk::GetFreeSpaceMapPath(current_database_oid_, table_oid));
   name2oid_.erase(table_name);
   oid2table_.erase(table_oid);
+  {
+    std::scoped_lock lock(modifications_mutex_);
+    oid2modifications_.erase(table_oid);
+  }
 
   // Step3. OidManager删除对应项
   oid_manager_.DropEntry(OidType::TABLE, table_name);
@@ -132,14 +153,32 @@ void SimpleCatalog::DropTable(const std::string &table_name) {
   db_out << "~" << table_name << " ";
 }
 
-void SimpleCatalog::CreateIndex(const std::string &index_name, const std::string &table_name) {
-  throw DbException("ChangeIndex not implemented in SimpleCatalog");
+void SimpleCatalog::CreateIndex(const std::string &index_name, const std::string &table_name,
+                                const std::vector<std::string> &column_names, IndexType index_type,
+                                const std::vector<std::string> &include_column_names) {
+  throw DbException("CreateIndex not implemented in SimpleCatalog");
 }
 
-void SimpleCatalog::DropIndex(const std::string &index_name) {
+void SimpleCatalog::DropIndex(const std::string &index_name, bool missing_ok) {
   throw DbException("DropIndex not implemented in SimpleCatalog");
 }
 
+std::shared_ptr<Index> SimpleCatalog::GetIndex(oid_t oid) const {
+  throw DbException("GetIndex not implemented in SimpleCatalog");
+}
+
+oid_t SimpleCatalog::GetIndexOid(const std::string &index_name) const {
+  throw DbException("GetIndexOid not implemented in SimpleCatalog");
+}
+
+std::string SimpleCatalog::GetIndexName(oid_t oid) const {
+  throw DbException("GetIndexName not implemented in SimpleCatalog");
+}
+
+std::vector<std::shared_ptr<Index>> SimpleCatalog::GetTableIndexes(oid_t table_oid) const { return {}; }
+
+bool SimpleCatalog::IndexExists(oid_t oid) const { return false; }
+
 std::vector<std::string> SimpleCatalog::GetTableNames() const {
   std::vector<std::string> table_names;
   for (const auto &[name, _] : name2oid_) {
@@ -183,4 +222,35 @@ void SimpleCatalog::SetCardinality(const std::string &table_name, uint32_t cardi
 
 void SimpleCatalog::SetDistinct(const std::string &table_name, const std::string &column_name, uint32_t distinct) {}
 
+void SimpleCatalog::SaveFreeSpaceMaps() const {
+  for (const auto &[_, table] : oid2table_) {
+    table->SaveFreeSpaceMap();
+  }
+}
+
+void SimpleCatalog::CountTableModifications(oid_t oid, uint32_t inserted, uint32_t updated, uint32_t deleted) {
+  std::scoped_lock lock(modifications_mutex_);
+  auto &stats = oid2modifications_[oid];
+  stats.n_tup_ins_ += inserted;
+  stats.n_tup_upd_ += updated;
+  stats.n_tup_del_ += deleted;
+  stats.n_dead_tup_ += updated + deleted;
+}
+
+void SimpleCatalog::CountVacuumedTuples(oid_t oid, uint32_t dead_tuples) {
+  std::scoped_lock lock(modifications_mutex_);
+  auto &stats = oid2modifications_[oid];
+  stats.n_dead_tup_ -= std::min(stats.n_dead_tup_, dead_tuples);
+}
+
+TableModificationStats SimpleCatalog::GetTableModificationStats(oid_t oid) const {
+  std::scoped_lock lock(modifications_mutex_);
+  if (oid2modifications_.find(oid) == oid2modifications_.end()) {
+    return {};
+  }
+  return oid2modifications_.at(oid);
+}
+
+void SimpleCatalog::SaveTableModificationStats() {}
+
 }  // namespace huadb
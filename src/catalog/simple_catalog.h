@@ -1,11 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "catalog/column_list.h"
 #include "catalog/oid_manager.h"
+#include "catalog/table_modification_stats.h"
 #include "common/constants.h"
 
 namespace huadb {
@@ -35,15 +37,29 @@ class SimpleCatalog {
   // 获取表所在的数据库的oid
   oid_t GetDatabaseOid(oid_t table_oid) const;
 
-  // 创建表
+  // 创建表，layout 为表的页面布局，compression 为页面写回磁盘时的压缩方式
   void CreateTable(const std::string &table_name, const ColumnList &column_list, oid_t oid = INVALID_OID,
-                   oid_t db_oid = INVALID_OID, bool new_table = true);
+                   oid_t db_oid = INVALID_OID, bool new_table = true, TableLayout layout = TableLayout::ROW,
+                   CompressionType compression = CompressionType::NONE);
   // 删除表
   void DropTable(const std::string &table_name);
-  // 创建索引
-  void CreateIndex(const std::string &index_name, const std::string &table_name);
+  // 创建索引，索引建立后为空，column_names 为按顺序比较的键列，index_type 为索引的组织方式
+  // include_column_names 为只保存在 B+ 树叶节点索引项中的附加列
+  void CreateIndex(const std::string &index_name, const std::string &table_name,
+                   const std::vector<std::string> &column_names, IndexType index_type = IndexType::BTREE,
+                   const std::vector<std::string> &include_column_names = {});
   // 删除索引
-  void DropIndex(const std::string &index_name);
+  void DropIndex(const std::string &index_name, bool missing_ok);
+  // 获取索引
+  std::shared_ptr<Index> GetIndex(oid_t oid) const;
+  // 获取索引oid
+  oid_t GetIndexOid(const std::string &index_name) const;
+  // 获取索引名
+  std::string GetIndexName(oid_t oid) const;
+  // 获取表上的所有索引
+  std::vector<std::shared_ptr<Index>> GetTableIndexes(oid_t table_oid) const;
+  // 索引是否存在
+  bool IndexExists(oid_t oid) const;
   // 获取当前数据库下所有表名
   std::vector<std::string> GetTableNames() const;
   // 获取表
@@ -63,6 +79,16 @@ class SimpleCatalog {
   // 设置统计信息
   void SetCardinality(const std::string &table_name, uint32_t cardinality);
   void SetDistinct(const std::string &table_name, const std::string &column_name, uint32_t distinct);
+  // 持久化已加载表的空闲空间映射表，需在 buffer pool 写回页面后调用
+  void SaveFreeSpaceMaps() const;
+  // 累加表的修改计数，由 DML 执行器调用
+  void CountTableModifications(oid_t oid, uint32_t inserted, uint32_t updated, uint32_t deleted);
+  // 清理完整扫描过表后调用，dead_tuples 为开始清理时表的失效版本数
+  // 开始清理时仍被快照引用的版本不会被回收，也不再计入，需等待之后的修改再次触发清理
+  void CountVacuumedTuples(oid_t oid, uint32_t dead_tuples);
+  TableModificationStats GetTableModificationStats(oid_t oid) const;
+  // 修改计数仅保存在内存中
+  void SaveTableModificationStats();
 
  private:
   BufferPool &buffer_pool_;
@@ -75,6 +101,9 @@ class SimpleCatalog {
   std::unordered_map<oid_t, std::shared_ptr<Index>> oid2index_;
   std::unordered_map<std::string, uint32_t> table2cardinality_;
   std::unordered_map<std::string, uint32_t> col2distinct_;
+  // 表级修改计数，执行器可能在多个连接的线程中同时更新
+  std::unordered_map<oid_t, TableModificationStats> oid2modifications_;
+  mutable std::mutex modifications_mutex_;
 
   oid_t current_database_oid_ = INVALID_OID;
 };
@@ -1,17 +1,57 @@
 #include "catalog/system_catalog.h"
 
+#include <algorithm>
 #include <cassert>
+#include <sstream>
+#include <unordered_set>
 
 #include "catalog/system_schema.h"
 #include "common/constants.h"
 #include "common/exceptions.h"
+#include "common/string_util.h"
+#include "common/type_util.h"
 #include "common/value.h"
+#include "index/b_plus_tree.h"
+#include "index/hash_index.h"
+#include "table/pax_page.h"
 #include "table/record.h"
 #include "table/table.h"
 #include "table/table_scan.h"
 
 namespace huadb {
 
+// 按索引的组织方式创建索引对象
+static std::shared_ptr<Index> MakeIndex(IndexType index_type, BufferPool &buffer_pool, LogManager &log_manager,
+                                        oid_t oid, oid_t db_oid, oid_t table_oid,
+                                        std::vector<IndexColumn> key_columns,
+                                        std::vector<IndexColumn> include_columns, bool new_index) {
+  if (index_type == IndexType::HASH) {
+    return std::make_shared<HashIndex>(buffer_pool, log_manager, oid, db_oid, table_oid, std::move(key_columns),
+                                       new_index);
+  }
+  return std::make_shared<BPlusTree>(buffer_pool, log_manager, oid, db_oid, table_oid, std::move(key_columns),
+                                     std::move(include_columns), new_index);
+}
+
+// 按列名查找索引中的列，列名在索引元信息中以逗号分隔保存
+static std::vector<IndexColumn> GetIndexColumns(const ColumnList &column_list,
+                                                const std::vector<std::string> &column_names) {
+  std::vector<IndexColumn> columns;
+  for (const auto &column_name : column_names) {
+    auto col_idx = column_list.GetColumnIndex(column_name);
+    columns.push_back({col_idx, column_list.GetColumn(col_idx)});
+  }
+  return columns;
+}
+
+static std::string JoinColumnNames(const std::vector<std::string> &column_names) {
+  std::string result;
+  for (const auto &column_name : column_names) {
+    result += (result.empty() ? "" : ",") + column_name;
+  }
+  return result;
+}
+
 SystemCatalog::SystemCatalog(BufferPool &buffer_pool, LogManager &log_manager, oid_t next_oid)
     : buffer_pool_(buffer_pool), log_manager_(log_manager), oid_manager_(next_oid) {}
 
@@ -22,6 +62,8 @@ void SystemCatalog::CreateSystemTables() {
   CreateTable(TABLE_META_NAME, table_meta_schema, TABLE_META_OID, SYSTEM_DATABASE_OID, true);
   CreateTable(DATABASE_META_NAME, database_meta_schema, DATABASE_META_OID, SYSTEM_DATABASE_OID, true);
   CreateTable(STATISTIC_META_NAME, statistic_schema, STATISTIC_META_OID, SYSTEM_DATABASE_OID, true);
+  CreateTable(INDEX_META_NAME, index_meta_schema, INDEX_META_OID, SYSTEM_DATABASE_OID, true);
+  CreateTable(MODIFICATION_META_NAME, modification_meta_schema, MODIFICATION_META_OID, SYSTEM_DATABASE_OID, true);
   // 插入默认数据库
   CreateDatabase(SYSTEM_DATABASE_NAME, false, SYSTEM_DATABASE_OID);
   CreateDatabase(DEFAULT_DATABASE_NAME, false);
@@ -35,6 +77,12 @@ void SystemCatalog::LoadSystemTables() {
   CreateTable(TABLE_META_NAME, table_meta_schema, TABLE_META_OID, SYSTEM_DATABASE_OID, false);
   CreateTable(DATABASE_META_NAME, database_meta_schema, DATABASE_META_OID, SYSTEM_DATABASE_OID, false);
   CreateTable(STATISTIC_META_NAME, statistic_schema, STATISTIC_META_OID, SYSTEM_DATABASE_OID, false);
+  // 索引表在支持索引之前创建的系统中不存在，此时新建
+  CreateTable(INDEX_META_NAME, index_meta_schema, INDEX_META_OID, SYSTEM_DATABASE_OID,
+              !Disk::FileExists(Disk::GetFilePath(SYSTEM_DATABASE_OID, INDEX_META_OID)));
+  // 修改计数表同理
+  CreateTable(MODIFICATION_META_NAME, modification_meta_schema, MODIFICATION_META_OID, SYSTEM_DATABASE_OID,
+              !Disk::FileExists(Disk::GetFilePath(SYSTEM_DATABASE_OID, MODIFICATION_META_OID)));
   // 加载数据库信息
   LoadDatabaseMeta();
 
@@ -90,6 +138,27 @@ void SystemCatalog::DropDatabase(const std::string &database_name, bool missing_
     }
   }
 
+  // IndexMeta 中删除包含的索引，索引文件随数据库文件夹删除
+  auto index_meta = GetTable(INDEX_META_OID);
+  scan = std::make_shared<TableScan>(buffer_pool_, index_meta, Rid{index_meta->GetFirstPageId(), 0});
+  db_oid_idx = index_meta_schema.GetColumnIndex("db_oid");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == db_oid) {
+      index_meta->DeleteRecord(record->GetRid(), DDL_XID, false);
+    }
+  }
+
+  // ModificationMeta 中删除包含的表的修改计数
+  auto modification_meta = GetTable(MODIFICATION_META_OID);
+  scan = std::make_shared<TableScan>(buffer_pool_, modification_meta,
+                                       Rid{modification_meta->GetFirstPageId(), 0});
+  db_oid_idx = modification_meta_schema.GetColumnIndex("db_oid");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == db_oid) {
+      modification_meta->DeleteRecord(record->GetRid(), DDL_XID, false);
+    }
+  }
+
   // Step 4. DatabaseMeta 中删除对应项
   bool deleted = false;
   auto db_meta = GetTable(DATABASE_META_OID);
@@ -150,15 +219,20 @@ void SystemCatalog::ChangeDatabase(const std::string &database_name) {
   }
   // 设定当前数据库 id
   current_database_oid_ = db_oid;
-  // 加载切换数据库的所有表
+  // 加载切换数据库的所有表和索引
   LoadTableMeta();
+  LoadIndexMeta();
   LoadStatistics();
+  LoadModificationMeta();
 }
 
 oid_t SystemCatalog::GetDatabaseOid(oid_t table_oid) const {
   if (oid2table_.find(table_oid) != oid2table_.end()) {
     return current_database_oid_;
   }
+  if (oid2index_.find(table_oid) != oid2index_.end()) {
+    return oid2index_.at(table_oid)->GetDbOid();
+  }
   auto table_meta = GetTable(TABLE_META_OID);
   auto scan = std::make_shared<TableScan>(buffer_pool_, table_meta, Rid{table_meta->GetFirstPageId(), 0});
   auto table_oid_idx = table_meta_schema.GetColumnIndex("table_oid");
@@ -172,7 +246,7 @@ oid_t SystemCatalog::GetDatabaseOid(oid_t table_oid) const {
 }
 
 void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList &column_list, oid_t oid, oid_t db_oid,
-                                bool new_table) {
+                                bool new_table, TableLayout layout, CompressionType compression) {
   // Step 1. 约束检测
   if (db_oid == INVALID_OID) {
     CheckUsingDatabase();
@@ -181,6 +255,9 @@ void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList
   if (oid_manager_.EntryExists(OidType::TABLE, table_name)) {
     throw DbException("Table \"" + table_name + "\" already exists");
   }
+  if (new_table && layout == TableLayout::PAX) {
+    PaxPage::ComputeCapacity(column_list, buffer_pool_.GetPageSize());
+  }
   // Step 2. OidManager 添加对应项
   if (oid == INVALID_OID) {
     oid = oid_manager_.CreateEntry(OidType::TABLE, table_name);
@@ -196,12 +273,17 @@ void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList
     Disk::CreateFile(Disk::GetFilePath(db_oid, oid));
   }
   oid2table_[oid] = std::make_shared<Table>(buffer_pool_, log_manager_, oid, db_oid, column_list, new_table,
-                                            Disk::EmptyFile(Disk::GetFilePath(db_oid, oid)));
+                                            Disk::EmptyFile(Disk::GetFilePath(db_oid, oid)), layout, compression);
 
   // 检查：非新表不需要添加到 Meta 中
   if (!new_table) {
     return;
   }
+  // 新表的修改计数从零开始
+  {
+    std::scoped_lock lock(modifications_mutex_);
+    oid2modifications_[oid] = TableModificationStats();
+  }
 
   // Step 4. TableMeta 中添加对应记录
   assert(db_oid != INVALID_OID);
@@ -209,7 +291,15 @@ void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList
   values.emplace_back(oid);
   values.emplace_back(db_oid);
   values.emplace_back(table_name);
-  values.emplace_back(column_list.ToString());
+  // 非默认的表选项以"选项名 值"的形式追加在列定义之后，默认选项的表保持原有格式
+  auto schema = column_list.ToString();
+  if (layout != TableLayout::ROW) {
+    schema += "layout " + TypeUtil::Layout2String(layout) + "\n";
+  }
+  if (compression != CompressionType::NONE) {
+    schema += "compression " + TypeUtil::Compression2String(compression) + "\n";
+  }
+  values.emplace_back(std::move(schema));
   values.emplace_back(INVALID_CARDINALITY);
   GetTable(TABLE_META_OID)->InsertRecord(std::make_shared<Record>(std::move(values)), DDL_XID, DDL_CID, false);
 }
@@ -222,10 +312,19 @@ void SystemCatalog::DropTable(const std::string &table_name) {
     throw DbException("Table \"" + table_name + "\" does not exist");
   }
   oid_t table_oid = oid_manager_.GetEntryOid(OidType::TABLE, table_name);
+  // 先删除表上的索引
+  for (const auto &index : GetTableIndexes(table_oid)) {
+    DropIndex(index->GetOid());
+  }
   // Step 2. 实际删除表
   // 磁盘中删除对应项
   Disk::RemoveFile(Disk::GetFilePath(current_database_oid_, table_oid));
+  Disk::RemoveFile(Disk::GetFreeSpaceMapPath(current_database_oid_, table_oid));
   oid2table_.erase(table_oid);
+  {
+    std::scoped_lock lock(modifications_mutex_);
+    oid2modifications_.erase(table_oid);
+  }
 
   // Step 3. OidManager 删除对应项
   oid_manager_.DropEntry(OidType::TABLE, table_name);
@@ -244,11 +343,117 @@ void SystemCatalog::DropTable(const std::string &table_name) {
   if (!deleted) {
     throw DbException("Table \"" + table_name + "\" does not exist in table_meta");
   }
+  // ModificationMeta 删除对应条目，表尚未保存过修改计数时不存在
+  auto modification_meta = GetTable(MODIFICATION_META_OID);
+  scan = std::make_shared<TableScan>(buffer_pool_, modification_meta,
+                                       Rid{modification_meta->GetFirstPageId(), 0});
+  table_oid_idx = modification_meta_schema.GetColumnIndex("table_oid");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(table_oid_idx).GetValue<oid_t>() == table_oid) {
+      modification_meta->DeleteRecord(record->GetRid(), DDL_XID, false);
+      break;
+    }
+  }
+}
+
+void SystemCatalog::CreateIndex(const std::string &index_name, const std::string &table_name,
+                                const std::vector<std::string> &column_names, IndexType index_type,
+                                const std::vector<std::string> &include_column_names) {
+  // Step 1. 约束检测
+  CheckUsingDatabase();
+  if (oid_manager_.EntryExists(OidType::INDEX, index_name)) {
+    throw DbException("Index \"" + index_name + "\" already exists");
+  }
+  auto table_oid = GetTableOid(table_name);
+  const auto &column_list = GetTableColumnList(table_oid);
+  if (column_names.empty()) {
+    throw DbException("Index requires at least one key column");
+  }
+  std::unordered_set<std::string> seen_names;
+  for (const auto &column_name : column_names) {
+    if (!seen_names.insert(column_name).second) {
+      throw DbException("Column \"" + column_name + "\" appears more than once in index");
+    }
+  }
+  for (const auto &column_name : include_column_names) {
+    if (!seen_names.insert(column_name).second) {
+      throw DbException("Column \"" + column_name + "\" appears more than once in index");
+    }
+  }
+  auto key_columns = GetIndexColumns(column_list, column_names);
+  auto include_columns = GetIndexColumns(column_list, include_column_names);
+  if (index_type == IndexType::HASH) {
+    if (!include_columns.empty()) {
+      throw DbException("Hash indexes do not support INCLUDE columns");
+    }
+    HashIndex::CheckKeySize(key_columns, buffer_pool_.GetPageSize());
+  } else {
+    BPlusTree::CheckKeySize(key_columns, include_columns, buffer_pool_.GetPageSize());
+  }
+  // Step 2. OidManager 添加对应项
+  auto oid = oid_manager_.CreateEntry(OidType::INDEX, index_name);
+  // Step 3. 创建新的索引
+  Disk::CreateFile(Disk::GetFilePath(current_database_oid_, oid));
+  oid2index_[oid] = MakeIndex(index_type, buffer_pool_, log_manager_, oid, current_database_oid_, table_oid,
+                              std::move(key_columns), std::move(include_columns), true);
+  // Step 4. IndexMeta 中添加对应记录
+  std::vector<Value> values;
+  values.emplace_back(oid);
+  values.emplace_back(current_database_oid_);
+  values.emplace_back(index_name);
+  values.emplace_back(table_oid);
+  values.emplace_back(TypeUtil::IndexType2String(index_type));
+  values.emplace_back(JoinColumnNames(column_names));
+  values.emplace_back(JoinColumnNames(include_column_names));
+  GetTable(INDEX_META_OID)->InsertRecord(std::make_shared<Record>(std::move(values)), DDL_XID, DDL_CID, false);
+}
+
+void SystemCatalog::DropIndex(const std::string &index_name, bool missing_ok) {
+  CheckUsingDatabase();
+  if (!oid_manager_.EntryExists(OidType::INDEX, index_name)) {
+    if (missing_ok) {
+      return;
+    }
+    throw DbException("Index \"" + index_name + "\" does not exist");
+  }
+  DropIndex(oid_manager_.GetEntryOid(OidType::INDEX, index_name));
+}
+
+std::shared_ptr<Index> SystemCatalog::GetIndex(oid_t oid) const {
+  if (oid2index_.find(oid) == oid2index_.end()) {
+    throw DbException("Index with oid " + std::to_string(oid) + " does not exist");
+  }
+  return oid2index_.at(oid);
 }
 
-void SystemCatalog::CreateIndex(const std::string &index_name, const std::string &table_name) {}
+oid_t SystemCatalog::GetIndexOid(const std::string &index_name) const {
+  if (!oid_manager_.EntryExists(OidType::INDEX, index_name)) {
+    throw DbException("Index \"" + index_name + "\" does not exist");
+  }
+  return oid_manager_.GetEntryOid(OidType::INDEX, index_name);
+}
 
-void SystemCatalog::DropIndex(const std::string &index_name) {}
+std::string SystemCatalog::GetIndexName(oid_t oid) const {
+  // oid 管理器中的条目名称带有类型前缀
+  auto entry_name = oid_manager_.GetEntryName(oid);
+  return entry_name.substr(entry_name.find('.') + 1);
+}
+
+std::vector<std::shared_ptr<Index>> SystemCatalog::GetTableIndexes(oid_t table_oid) const {
+  std::vector<std::shared_ptr<Index>> indexes;
+  for (const auto &[_, index] : oid2index_) {
+    if (index->GetTableOid() == table_oid) {
+      indexes.push_back(index);
+    }
+  }
+  // 按 oid 排序，保证选择索引的结果稳定
+  std::sort(indexes.begin(), indexes.end(), [](const auto &left, const auto &right) {
+    return left->GetOid() < right->GetOid();
+  });
+  return indexes;
+}
+
+bool SystemCatalog::IndexExists(oid_t oid) const { return oid2index_.find(oid) != oid2index_.end(); }
 
 std::vector<std::string> SystemCatalog::GetTableNames() const {
   if (current_database_oid_ == INVALID_OID) {
@@ -265,6 +470,8 @@ std::vector<std::string> SystemCatalog::GetTableNames() const {
       table_names.push_back(record->GetValue(table_name_idx).GetValue<std::string>());
     }
   }
+  // 记录在 TableMeta 中的位置取决于页面空闲空间，按表名排序使结果稳定
+  std::sort(table_names.begin(), table_names.end());
   return table_names;
 }
 
@@ -332,34 +539,51 @@ void SystemCatalog::SetCardinality(const std::string &table_name, uint32_t cardi
 }
 
 void SystemCatalog::SetDistinct(const std::string &table_name, const std::string &column_name, uint32_t distinct) {
-  auto statistic = GetTable(STATISTIC_META_OID);
-  auto scan = std::make_shared<TableScan>(buffer_pool_, statistic, Rid{statistic->GetFirstPageId(), 0});
-  auto table_name_idx = statistic_schema.GetColumnIndex("table_name");
-  auto db_oid_idx = statistic_schema.GetColumnIndex("db_oid");
-  auto column_name_idx = statistic_schema.GetColumnIndex("column_name");
-  auto n_distinct_idx = statistic_schema.GetColumnIndex("n_distinct");
-  bool found = false;
-  while (auto record = scan->GetNextRecord()) {
-    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == current_database_oid_ &&
-        record->GetValue(table_name_idx).GetValue<std::string>() == table_name &&
-        record->GetValue(column_name_idx).GetValue<std::string>() == column_name) {
-      if (found) {
-        throw DbException(table_name + "." + column_name + " has more than one record in statistic_meta");
-      }
-      record->SetValue(n_distinct_idx, Value(distinct));
-      statistic->UpdateRecordInPlace(*record);
-      col2distinct_[table_name + "." + column_name] = distinct;
-      found = true;
-    }
+  WriteStatistic(table_name, column_name, distinct);
+  col2distinct_[table_name + "." + column_name] = distinct;
+}
+
+void SystemCatalog::SaveFreeSpaceMaps() const {
+  for (const auto &[_, table] : oid2table_) {
+    table->SaveFreeSpaceMap();
   }
-  if (!found) {
-    std::vector<Value> values;
-    values.emplace_back(table_name);
-    values.emplace_back(current_database_oid_);
-    values.emplace_back(column_name);
-    values.emplace_back(distinct);
-    statistic->InsertRecord(std::make_shared<Record>(std::move(values)), DDL_XID, DDL_CID, false);
-    col2distinct_[table_name + "." + column_name] = distinct;
+}
+
+void SystemCatalog::CountTableModifications(oid_t oid, uint32_t inserted, uint32_t updated, uint32_t deleted) {
+  std::scoped_lock lock(modifications_mutex_);
+  auto &stats = oid2modifications_[oid];
+  stats.n_tup_ins_ += inserted;
+  stats.n_tup_upd_ += updated;
+  stats.n_tup_del_ += deleted;
+  // 更新和删除各留下一个失效版本
+  stats.n_dead_tup_ += updated + deleted;
+}
+
+void SystemCatalog::CountVacuumedTuples(oid_t oid, uint32_t dead_tuples) {
+  std::scoped_lock lock(modifications_mutex_);
+  auto &stats = oid2modifications_[oid];
+  stats.n_dead_tup_ -= std::min(stats.n_dead_tup_, dead_tuples);
+}
+
+TableModificationStats SystemCatalog::GetTableModificationStats(oid_t oid) const {
+  std::scoped_lock lock(modifications_mutex_);
+  if (oid2modifications_.find(oid) == oid2modifications_.end()) {
+    return {};
+  }
+  return oid2modifications_.at(oid);
+}
+
+void SystemCatalog::SaveTableModificationStats() {
+  std::unordered_map<oid_t, TableModificationStats> modifications;
+  {
+    std::scoped_lock lock(modifications_mutex_);
+    modifications = oid2modifications_;
+  }
+  for (const auto &[oid, stats] : modifications) {
+    if (oid2table_.find(oid) == oid2table_.end()) {
+      continue;
+    }
+    WriteModificationMeta(oid, stats);
   }
 }
 
@@ -370,13 +594,15 @@ void SystemCatalog::ExitDatabase() {
   if (current_database_oid_ == SYSTEM_DATABASE_OID) {
     return;
   }
+  SaveTableModificationStats();
   buffer_pool_.Flush(true);
   // 直接利用 OidManager 信息进行删除
   std::vector<oid_t> deleted_oids{};
-  for (const auto &[oid, _] : oid2table_) {
+  for (const auto &[oid, table] : oid2table_) {
     if (oid <= PRESERVED_OID) {
       continue;
     }
+    table->SaveFreeSpaceMap();
     deleted_oids.push_back(oid);
   }
   for (const auto &oid : deleted_oids) {
@@ -384,6 +610,14 @@ void SystemCatalog::ExitDatabase() {
     oid_manager_.DropEntry(OidType::TABLE, table_name);
     oid2table_.erase(oid);
   }
+  for (const auto &[oid, _] : oid2index_) {
+    oid_manager_.DropEntry(OidType::INDEX, oid_manager_.GetEntryName(oid));
+  }
+  oid2index_.clear();
+  {
+    std::scoped_lock lock(modifications_mutex_);
+    oid2modifications_.clear();
+  }
   // 设定数据库 id 为无效值
   current_database_oid_ = INVALID_OID;
 }
@@ -400,6 +634,22 @@ bool SystemCatalog::DatabaseExists(const std::string &database_name) const {
 
 void SystemCatalog::DropTable(oid_t oid) { DropTable(oid_manager_.GetEntryName(oid)); }
 
+void SystemCatalog::DropIndex(oid_t index_oid) {
+  Disk::RemoveFile(Disk::GetFilePath(current_database_oid_, index_oid));
+  oid2index_.erase(index_oid);
+  oid_manager_.DropEntry(OidType::INDEX, oid_manager_.GetEntryName(index_oid));
+  auto index_meta = GetTable(INDEX_META_OID);
+  auto scan = std::make_shared<TableScan>(buffer_pool_, index_meta, Rid{index_meta->GetFirstPageId(), 0});
+  auto index_oid_idx = index_meta_schema.GetColumnIndex("index_oid");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(index_oid_idx).GetValue<oid_t>() == index_oid) {
+      index_meta->DeleteRecord(record->GetRid(), DDL_XID, false);
+      return;
+    }
+  }
+  throw DbException("Index with oid " + std::to_string(index_oid) + " does not exist in index_meta");
+}
+
 void SystemCatalog::LoadDatabaseMeta() {
   assert(oid2table_.find(DATABASE_META_OID) != oid2table_.end());
   auto db_meta = GetTable(DATABASE_META_OID);
@@ -429,17 +679,58 @@ void SystemCatalog::LoadTableMeta() {
       auto column_list_string = record->GetValue(schema_idx).GetValue<std::string>();
       auto cardinality = record->GetValue(cardinality_idx).GetValue<uint32_t>();
       ColumnList column_list;
-      column_list.FromString(column_list_string);
+      std::istringstream iss(column_list_string);
+      column_list.FromString(iss);
+      auto layout = TableLayout::ROW;
+      auto compression = CompressionType::NONE;
+      std::string option, option_value;
+      while (iss >> option >> option_value) {
+        if (option == "layout") {
+          layout = TypeUtil::String2Layout(option_value);
+        } else if (option == "compression") {
+          compression = TypeUtil::String2Compression(option_value);
+        }
+      }
 
       // 添加数据表
       oid_manager_.SetEntryOid(OidType::TABLE, table_name, oid);
-      oid2table_[oid] = std::make_shared<Table>(buffer_pool_, log_manager_, oid, current_database_oid_, column_list,
-                                                false, Disk::EmptyFile(Disk::GetFilePath(GetDatabaseOid(oid), oid)));
+      oid2table_[oid] =
+          std::make_shared<Table>(buffer_pool_, log_manager_, oid, current_database_oid_, column_list, false,
+                                  Disk::EmptyFile(Disk::GetFilePath(GetDatabaseOid(oid), oid)), layout,
+                                  compression);
       table2cardinality_[table_name] = cardinality;
     }
   }
 }
 
+void SystemCatalog::LoadIndexMeta() {
+  auto index_meta = GetTable(INDEX_META_OID);
+  auto scan = std::make_shared<TableScan>(buffer_pool_, index_meta, Rid{index_meta->GetFirstPageId(), 0});
+  auto index_oid_idx = index_meta_schema.GetColumnIndex("index_oid");
+  auto db_oid_idx = index_meta_schema.GetColumnIndex("db_oid");
+  auto index_name_idx = index_meta_schema.GetColumnIndex("index_name");
+  auto table_oid_idx = index_meta_schema.GetColumnIndex("table_oid");
+  auto index_type_idx = index_meta_schema.GetColumnIndex("index_type");
+  auto key_columns_idx = index_meta_schema.GetColumnIndex("key_columns");
+  auto include_columns_idx = index_meta_schema.GetColumnIndex("include_columns");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == current_database_oid_) {
+      auto oid = record->GetValue(index_oid_idx).GetValue<oid_t>();
+      auto index_name = record->GetValue(index_name_idx).GetValue<std::string>();
+      auto table_oid = record->GetValue(table_oid_idx).GetValue<oid_t>();
+      const auto &column_list = GetTableColumnList(table_oid);
+      auto key_columns = GetIndexColumns(
+          column_list, StringUtil::Split(record->GetValue(key_columns_idx).GetValue<std::string>(), ','));
+      auto include_columns = GetIndexColumns(
+          column_list, StringUtil::Split(record->GetValue(include_columns_idx).GetValue<std::string>(), ','));
+      oid_manager_.SetEntryOid(OidType::INDEX, index_name, oid);
+      auto index_type = TypeUtil::String2IndexType(record->GetValue(index_type_idx).GetValue<std::string>());
+      oid2index_[oid] = MakeIndex(index_type, buffer_pool_, log_manager_, oid, current_database_oid_, table_oid,
+                                  std::move(key_columns), std::move(include_columns), false);
+    }
+  }
+}
+
 void SystemCatalog::LoadStatistics() {
   auto statistic = GetTable(STATISTIC_META_OID);
   auto scan = std::make_shared<TableScan>(buffer_pool_, statistic, Rid{statistic->GetFirstPageId(), 0});
@@ -457,4 +748,85 @@ void SystemCatalog::LoadStatistics() {
   }
 }
 
+void SystemCatalog::LoadModificationMeta() {
+  auto modification_meta = GetTable(MODIFICATION_META_OID);
+  auto scan = std::make_shared<TableScan>(buffer_pool_, modification_meta,
+                                            Rid{modification_meta->GetFirstPageId(), 0});
+  auto table_oid_idx = modification_meta_schema.GetColumnIndex("table_oid");
+  auto db_oid_idx = modification_meta_schema.GetColumnIndex("db_oid");
+  auto n_tup_ins_idx = modification_meta_schema.GetColumnIndex("n_tup_ins");
+  auto n_tup_upd_idx = modification_meta_schema.GetColumnIndex("n_tup_upd");
+  auto n_tup_del_idx = modification_meta_schema.GetColumnIndex("n_tup_del");
+  auto n_dead_tup_idx = modification_meta_schema.GetColumnIndex("n_dead_tup");
+  std::scoped_lock lock(modifications_mutex_);
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == current_database_oid_) {
+      auto &stats = oid2modifications_[record->GetValue(table_oid_idx).GetValue<oid_t>()];
+      stats.n_tup_ins_ = record->GetValue(n_tup_ins_idx).GetValue<uint32_t>();
+      stats.n_tup_upd_ = record->GetValue(n_tup_upd_idx).GetValue<uint32_t>();
+      stats.n_tup_del_ = record->GetValue(n_tup_del_idx).GetValue<uint32_t>();
+      stats.n_dead_tup_ = record->GetValue(n_dead_tup_idx).GetValue<uint32_t>();
+    }
+  }
+}
+
+void SystemCatalog::WriteStatistic(const std::string &table_name, const std::string &column_name, uint32_t value) {
+  auto statistic = GetTable(STATISTIC_META_OID);
+  auto scan = std::make_shared<TableScan>(buffer_pool_, statistic, Rid{statistic->GetFirstPageId(), 0});
+  auto table_name_idx = statistic_schema.GetColumnIndex("table_name");
+  auto db_oid_idx = statistic_schema.GetColumnIndex("db_oid");
+  auto column_name_idx = statistic_schema.GetColumnIndex("column_name");
+  auto n_distinct_idx = statistic_schema.GetColumnIndex("n_distinct");
+  bool found = false;
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == current_database_oid_ &&
+        record->GetValue(table_name_idx).GetValue<std::string>() == table_name &&
+        record->GetValue(column_name_idx).GetValue<std::string>() == column_name) {
+      if (found) {
+        throw DbException(table_name + "." + column_name + " has more than one record in statistic_meta");
+      }
+      record->SetValue(n_distinct_idx, Value(value));
+      statistic->UpdateRecordInPlace(*record);
+      found = true;
+    }
+  }
+  if (!found) {
+    std::vector<Value> values;
+    values.emplace_back(table_name);
+    values.emplace_back(current_database_oid_);
+    values.emplace_back(column_name);
+    values.emplace_back(value);
+    statistic->InsertRecord(std::make_shared<Record>(std::move(values)), DDL_XID, DDL_CID, false);
+  }
+}
+
+void SystemCatalog::WriteModificationMeta(oid_t oid, const TableModificationStats &stats) {
+  auto modification_meta = GetTable(MODIFICATION_META_OID);
+  auto scan = std::make_shared<TableScan>(buffer_pool_, modification_meta,
+                                            Rid{modification_meta->GetFirstPageId(), 0});
+  auto table_oid_idx = modification_meta_schema.GetColumnIndex("table_oid");
+  auto n_tup_ins_idx = modification_meta_schema.GetColumnIndex("n_tup_ins");
+  auto n_tup_upd_idx = modification_meta_schema.GetColumnIndex("n_tup_upd");
+  auto n_tup_del_idx = modification_meta_schema.GetColumnIndex("n_tup_del");
+  auto n_dead_tup_idx = modification_meta_schema.GetColumnIndex("n_dead_tup");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(table_oid_idx).GetValue<oid_t>() == oid) {
+      record->SetValue(n_tup_ins_idx, Value(stats.n_tup_ins_));
+      record->SetValue(n_tup_upd_idx, Value(stats.n_tup_upd_));
+      record->SetValue(n_tup_del_idx, Value(stats.n_tup_del_));
+      record->SetValue(n_dead_tup_idx, Value(stats.n_dead_tup_));
+      modification_meta->UpdateRecordInPlace(*record);
+      return;
+    }
+  }
+  std::vector<Value> values;
+  values.emplace_back(oid);
+  values.emplace_back(current_database_oid_);
+  values.emplace_back(stats.n_tup_ins_);
+  values.emplace_back(stats.n_tup_upd_);
+  values.emplace_back(stats.n_tup_del_);
+  values.emplace_back(stats.n_dead_tup_);
+  modification_meta->InsertRecord(std::make_shared<Record>(std::move(values)), DDL_XID, DDL_CID, false);
+}
+
 }  // namespace huadb
@@ -1,19 +1,34 @@
+#pragma once
+
 #include "catalog/column_list.h"
 
 namespace huadb {
 
 // clang-format off
-ColumnList table_meta_schema({ColumnDefinition("table_oid", Type::UINT),
-                              ColumnDefinition("db_oid", Type::UINT),
-                              ColumnDefinition("table_name", Type::VARCHAR, 32),
-                              ColumnDefinition("schema", Type::VARCHAR, 1024),
-                              ColumnDefinition("cardinality", Type::UINT)});
-ColumnList database_meta_schema({ColumnDefinition("db_oid", Type::UINT),
-                                 ColumnDefinition("db_name", Type::VARCHAR, 32)});
-ColumnList statistic_schema({ColumnDefinition("table_name", Type::VARCHAR, 32),
-                             ColumnDefinition("db_oid", Type::UINT),
-                             ColumnDefinition("column_name", Type::VARCHAR, 32),
-                             ColumnDefinition("n_distinct", Type::UINT)});
+inline ColumnList table_meta_schema({ColumnDefinition("table_oid", Type::UINT),
+                                     ColumnDefinition("db_oid", Type::UINT),
+                                     ColumnDefinition("table_name", Type::VARCHAR, 32),
+                                     ColumnDefinition("schema", Type::VARCHAR, 1024),
+                                     ColumnDefinition("cardinality", Type::UINT)});
+inline ColumnList database_meta_schema({ColumnDefinition("db_oid", Type::UINT),
+                                        ColumnDefinition("db_name", Type::VARCHAR, 32)});
+inline ColumnList statistic_schema({ColumnDefinition("table_name", Type::VARCHAR, 32),
+                                    ColumnDefinition("db_oid", Type::UINT),
+                                    ColumnDefinition("column_name", Type::VARCHAR, 32),
+                                    ColumnDefinition("n_distinct", Type::UINT)});
+inline ColumnList index_meta_schema({ColumnDefinition("index_oid", Type::UINT),
+                                     ColumnDefinition("db_oid", Type::UINT),
+                                     ColumnDefinition("index_name", Type::VARCHAR, 32),
+                                     ColumnDefinition("table_oid", Type::UINT),
+                                     ColumnDefinition("index_type", Type::VARCHAR, 16),
+                                     ColumnDefinition("key_columns", Type::VARCHAR, 256),
+                                     ColumnDefinition("include_columns", Type::VARCHAR, 256)});
+inline ColumnList modification_meta_schema({ColumnDefinition("table_oid", Type::UINT),
+                                            ColumnDefinition("db_oid", Type::UINT),
+                                            ColumnDefinition("n_tup_ins", Type::UINT),
+                                            ColumnDefinition("n_tup_upd", Type::UINT),
+                                            ColumnDefinition("n_tup_del", Type::UINT),
+                                            ColumnDefinition("n_dead_tup", Type::UINT)});
 // clang-format on
 
 }  // namespace huadb
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace huadb {
+
+// 表级修改计数，由 DML 执行器维护，自动清理据此判断表中失效版本的比例
+struct TableModificationStats {
+  uint32_t n_tup_ins_ = 0;   // 插入的记录数
+  uint32_t n_tup_upd_ = 0;   // 更新的记录数
+  uint32_t n_tup_del_ = 0;   // 删除的记录数
+  uint32_t n_dead_tup_ = 0;  // 尚未被清理的失效版本数，更新和删除各产生一个
+
+  // 估计的有效记录数
+  uint32_t GetLiveTuples() const { return n_tup_ins_ > n_tup_del_ ? n_tup_ins_ - n_tup_del_ : 0; }
+};
+
+}  // namespace huadb
@@ -0,0 +1,68 @@
+#include "common/arena.h"
+
+#include <algorithm>
+
+namespace huadb {
+
+Arena::Arena(size_t block_size)
+    : block_size_(block_size), free_lists_(ARENA_MAX_RECYCLE_SIZE / ARENA_SIZE_CLASS + 1) {}
+
+ArenaStats Arena::GetStats() const { return stats_; }
+
+void *Arena::do_allocate(size_t bytes, size_t alignment) {
+  void *result;
+  if (bytes <= ARENA_MAX_RECYCLE_SIZE && alignment <= ARENA_SIZE_CLASS) {
+    auto size_class = GetSizeClass(bytes);
+    bytes = size_class * ARENA_SIZE_CLASS;
+    if (free_lists_[size_class] != nullptr) {
+      result = free_lists_[size_class];
+      free_lists_[size_class] = free_lists_[size_class]->next_;
+    } else {
+      result = AllocateFromBlock(bytes, ARENA_SIZE_CLASS);
+    }
+  } else {
+    result = AllocateFromBlock(bytes, alignment);
+  }
+  used_bytes_ += bytes;
+  stats_.allocation_count_++;
+  stats_.allocated_bytes_ += bytes;
+  stats_.peak_bytes_ = std::max(stats_.peak_bytes_, used_bytes_);
+  return result;
+}
+
+void Arena::do_deallocate(void *p, size_t bytes, size_t alignment) {
+  if (bytes <= ARENA_MAX_RECYCLE_SIZE && alignment <= ARENA_SIZE_CLASS) {
+    auto size_class = GetSizeClass(bytes);
+    auto *chunk = static_cast<FreeChunk *>(p);
+    chunk->next_ = free_lists_[size_class];
+    free_lists_[size_class] = chunk;
+    used_bytes_ -= size_class * ARENA_SIZE_CLASS;
+  } else {
+    used_bytes_ -= bytes;
+  }
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept { return this == &other; }
+
+size_t Arena::GetSizeClass(size_t bytes) {
+  return (std::max<size_t>(bytes, 1) + ARENA_SIZE_CLASS - 1) / ARENA_SIZE_CLASS;
+}
+
+void *Arena::AllocateFromBlock(size_t bytes, size_t alignment) {
+  auto padding = (alignment - reinterpret_cast<uintptr_t>(current_) % alignment) % alignment;
+  if (current_ == nullptr || padding + bytes > static_cast<size_t>(end_ - current_)) {
+    // 当前内存块剩余空间不足，申请新的内存块，超过块大小的分配单独占用一个内存块
+    // operator new[] 返回的地址满足 max_align_t 对齐，更大的对齐要求需要额外预留空间
+    auto size = std::max(block_size_, bytes + alignment);
+    blocks_.emplace_back(new std::byte[size]);
+    current_ = blocks_.back().get();
+    end_ = current_ + size;
+    stats_.reserved_bytes_ += size;
+    padding = (alignment - reinterpret_cast<uintptr_t>(current_) % alignment) % alignment;
+  }
+  auto *result = current_ + padding;
+  current_ = result + bytes;
+  return result;
+}
+
+}  // namespace huadb
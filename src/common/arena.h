@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace huadb {
+
+// 查询内存区统计
+struct ArenaStats {
+  uint64_t allocation_count_ = 0;  // 分配次数
+  uint64_t allocated_bytes_ = 0;   // 累计分配的字节数
+  uint64_t peak_bytes_ = 0;        // 同一时刻占用的最大字节数
+  uint64_t reserved_bytes_ = 0;    // 向系统申请的内存块总字节数
+};
+
+// 查询级内存区，从内存块中顺序分配，析构时整体释放
+// 释放的小块内存按大小分类挂入空闲链表，供之后相同大小的分配复用，流式执行的查询占用的内存不会随行数增长
+// 大块内存不复用，留到查询结束时统一释放
+// 仅供执行查询的线程使用，不加锁
+class Arena : public std::pmr::memory_resource {
+ public:
+  explicit Arena(size_t block_size);
+
+  ArenaStats GetStats() const;
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+ private:
+  // 小块内存按 ARENA_SIZE_CLASS 字节对齐并分类，超过 ARENA_MAX_RECYCLE_SIZE 的内存不复用
+  static constexpr size_t ARENA_SIZE_CLASS = 16;
+  static constexpr size_t ARENA_MAX_RECYCLE_SIZE = 1024;
+
+  struct FreeChunk {
+    FreeChunk *next_;
+  };
+
+  // 大小类别，即按 ARENA_SIZE_CLASS 向上对齐后的字节数除以 ARENA_SIZE_CLASS
+  static size_t GetSizeClass(size_t bytes);
+  // 从当前内存块顺序分配，空间不足时申请新的内存块
+  void *AllocateFromBlock(size_t bytes, size_t alignment);
+
+  size_t block_size_;
+  std::vector<std::unique_ptr<std::byte[]>> blocks_;
+  std::byte *current_ = nullptr;  // 当前内存块中下一个可分配的位置
+  std::byte *end_ = nullptr;      // 当前内存块的结束位置
+  uint64_t used_bytes_ = 0;       // 当前占用的字节数
+  std::vector<FreeChunk *> free_lists_;  // 下标为大小类别
+  ArenaStats stats_;
+};
+
+}  // namespace huadb
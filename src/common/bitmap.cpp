@@ -6,7 +6,9 @@
 
 namespace huadb {
 
-Bitmap::Bitmap(db_size_t size) : size_(size) { Resize(size); }
+Bitmap::Bitmap(db_size_t size, const allocator_type &alloc) : size_(size), bits_(alloc) { Resize(size); }
+
+Bitmap::Bitmap(const Bitmap &other, const allocator_type &alloc) : size_(other.size_), bits_(other.bits_, alloc) {}
 
 void Bitmap::Resize(db_size_t size) {
   size_ = size;
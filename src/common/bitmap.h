@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory_resource>
 #include <vector>
 
 #include "common/types.h"
@@ -9,8 +10,11 @@ namespace huadb {
 
 class Bitmap {
  public:
+  using allocator_type = std::pmr::polymorphic_allocator<uint8_t>;
+
   Bitmap() = default;
-  explicit Bitmap(db_size_t size);
+  explicit Bitmap(db_size_t size, const allocator_type &alloc = {});
+  Bitmap(const Bitmap &other, const allocator_type &alloc);
 
   void Resize(db_size_t size);
 
@@ -28,7 +32,7 @@ class Bitmap {
 
  private:
   db_size_t size_ = 0;
-  std::vector<uint8_t> bits_;
+  std::pmr::vector<uint8_t> bits_;
 };
 
 }  // namespace huadb
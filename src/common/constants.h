@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "common/types.h"
 
 // 通过 SIMPLE_CATALOG 宏来切换 Catalog 实现
@@ -24,13 +26,52 @@ static constexpr const char *NEXT_LSN_NAME = "next_lsn";
 static constexpr const char *MASTER_RECORD_NAME = "master_record";
 
 static constexpr size_t LOG_SEGMENT_SIZE = (1 << 20);
-static constexpr size_t DB_PAGE_SIZE = (1 << 8);
-static constexpr size_t MAX_RECORD_SIZE = 230;
-// 日志记录最长长度
-static constexpr size_t MAX_LOG_SIZE = sizeof(enum_t) + sizeof(xid_t) + sizeof(lsn_t) + sizeof(oid_t) + sizeof(oid_t) +
-                                       sizeof(pageid_t) + sizeof(slotid_t) + sizeof(db_size_t) + sizeof(db_size_t) +
-                                       MAX_RECORD_SIZE + sizeof(lsn_t);
-static constexpr size_t BUFFER_SIZE = 5;
+// 页面大小在新建数据库时确定并记录在控制文件中，默认值用于实验测试
+// 可选值为 DEFAULT_DB_PAGE_SIZE 以及 MIN_DB_PAGE_SIZE 到 MAX_DB_PAGE_SIZE 之间的 2 的幂
+static constexpr size_t DEFAULT_DB_PAGE_SIZE = (1 << 8);
+static constexpr size_t MIN_DB_PAGE_SIZE = (1 << 12);
+// 页内偏移使用 db_size_t 表示，页面大小不能超过 32K
+static constexpr size_t MAX_DB_PAGE_SIZE = (1 << 15);
+// 页头、槽位等记录以外的保留空间，记录最长长度为页面大小减去该值
+static constexpr size_t PAGE_RESERVED_SIZE = 26;
+// 控制文件格式版本，版本 1 不含版本号和页面大小
+static constexpr uint32_t CONTROL_FILE_VERSION = 2;
+
+// 记录最长长度
+constexpr size_t MaxRecordSize(size_t page_size) { return page_size - PAGE_RESERVED_SIZE; }
+// 日志记录最长长度，为包含最长记录的日志和包含整个页面的批量导入日志中的较大者
+constexpr size_t MaxLogSize(size_t page_size) {
+  return std::max(sizeof(enum_t) + sizeof(xid_t) + sizeof(lsn_t) + sizeof(oid_t) + sizeof(oid_t) + sizeof(pageid_t) +
+                      sizeof(slotid_t) + sizeof(db_size_t) + sizeof(db_size_t) + MaxRecordSize(page_size) +
+                      sizeof(lsn_t),
+                  sizeof(enum_t) + sizeof(xid_t) + sizeof(lsn_t) + sizeof(oid_t) + sizeof(pageid_t) +
+                      sizeof(pageid_t) + sizeof(slotid_t) + sizeof(db_size_t) + page_size);
+}
+// 普通表缓存默认页面数，可通过 server 命令行参数或 SET buffer_pool_size 调整
+static constexpr size_t DEFAULT_BUFFER_POOL_SIZE = 5;
+// buffer pool 分区数上限，每个分区至少 MIN_PARTITION_FRAMES 个页面，较小的 buffer pool 只有一个分区
+static constexpr size_t MAX_BUFFER_POOL_PARTITIONS = 16;
+static constexpr size_t MIN_PARTITION_FRAMES = 64;
+// 顺序扫描默认预读页面数，0 表示不预读；预读会改变缺页和磁盘访问次数，实验测试依赖精确计数，默认关闭
+static constexpr size_t DEFAULT_READ_AHEAD_PAGES = 0;
+// 预读线程数
+static constexpr size_t PREFETCH_THREAD_COUNT = 2;
+// 后台写进程两轮写回之间的间隔（毫秒），0 表示关闭；后台写回会改变写盘次数，实验测试依赖精确计数，默认关闭
+static constexpr size_t DEFAULT_BGWRITER_DELAY_MS = 0;
+// 后台写进程每轮最多写回的页面数
+static constexpr size_t DEFAULT_BGWRITER_MAX_PAGES = 100;
+// 后台写进程保持干净的页面比例（百分比），每个分区中按淘汰顺序排在前面的这部分页面会被提前写回
+static constexpr size_t DEFAULT_BGWRITER_CLEAN_PERCENT = 20;
+// 自动清理进程两轮检查之间的间隔（毫秒），0 表示关闭；后台清理会改变页面布局和磁盘访问次数，实验测试依赖精确结果，默认关闭
+static constexpr size_t DEFAULT_AUTOVACUUM_NAPTIME_MS = 0;
+// 失效版本数超过该值，且占表中版本的比例不低于 DEFAULT_AUTOVACUUM_DEAD_PERCENT 时，自动清理该表
+static constexpr size_t DEFAULT_AUTOVACUUM_THRESHOLD = 50;
+static constexpr size_t DEFAULT_AUTOVACUUM_DEAD_PERCENT = 20;
+// 自动清理每批清理的页面数，批次之间释放语句锁并休眠 DEFAULT_AUTOVACUUM_BATCH_DELAY_MS 毫秒，限制对前台查询延迟的影响
+static constexpr size_t DEFAULT_AUTOVACUUM_BATCH_PAGES = 16;
+static constexpr size_t DEFAULT_AUTOVACUUM_BATCH_DELAY_MS = 2;
+// 查询内存区每次向系统申请的内存块大小
+static constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;
 
 static constexpr lsn_t FIRST_LSN = 0;
 static constexpr lsn_t NULL_LSN = -1;
@@ -54,6 +95,8 @@ static constexpr oid_t TEMP_DATABASE_OID = 2;
 static constexpr oid_t TABLE_META_OID = 501;
 static constexpr oid_t DATABASE_META_OID = 502;
 static constexpr oid_t STATISTIC_META_OID = 503;
+static constexpr oid_t INDEX_META_OID = 504;
+static constexpr oid_t MODIFICATION_META_OID = 505;
 
 static constexpr uint32_t INVALID_CARDINALITY = -1;
 static constexpr uint32_t INVALID_DISTINCT = -1;
@@ -63,6 +106,8 @@ static constexpr const char *SYSTEM_DATABASE_NAME = "system";
 static constexpr const char *TABLE_META_NAME = "huadb_table";
 static constexpr const char *DATABASE_META_NAME = "huadb_database";
 static constexpr const char *STATISTIC_META_NAME = "huadb_statistic";
+static constexpr const char *INDEX_META_NAME = "huadb_index";
+static constexpr const char *MODIFICATION_META_NAME = "huadb_modification";
 
 static constexpr const char *DEFAULT_DATABASE_NAME = "huadb";
 
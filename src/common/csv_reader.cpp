@@ -0,0 +1,118 @@
+#include "common/csv_reader.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
+#include "common/exceptions.h"
+#include "common/type_util.h"
+
+namespace huadb {
+
+CsvReader::CsvReader(const std::string &path, char delimiter) : file_(path), delimiter_(delimiter) {
+  if (!file_.is_open()) {
+    throw DbException("Cannot open file: " + path);
+  }
+}
+
+bool CsvReader::ReadRow(std::vector<std::optional<std::string>> &fields) {
+  fields.clear();
+  if (!std::getline(file_, line_)) {
+    return false;
+  }
+  line_number_++;
+  row_line_number_ = line_number_;
+  std::string field;
+  bool quoted = false;     // 当前字段是否包含引号，包含引号的空字段为空字符串而非 NULL
+  bool in_quotes = false;  // 是否在引号内
+  size_t pos = 0;
+  while (true) {
+    if (pos == line_.size()) {
+      if (in_quotes) {
+        // 引号内的换行属于字段内容，继续读取下一行
+        if (!std::getline(file_, line_)) {
+          throw DbException("Unterminated quoted field in CSV line " + std::to_string(row_line_number_));
+        }
+        line_number_++;
+        field.push_back('\n');
+        pos = 0;
+        continue;
+      }
+      break;
+    }
+    char c = line_[pos++];
+    if (in_quotes) {
+      if (c != '"') {
+        field.push_back(c);
+      } else if (pos < line_.size() && line_[pos] == '"') {
+        field.push_back('"');
+        pos++;
+      } else {
+        in_quotes = false;
+      }
+    } else if (c == '"') {
+      in_quotes = true;
+      quoted = true;
+    } else if (c == delimiter_) {
+      fields.emplace_back(field.empty() && !quoted ? std::nullopt : std::optional<std::string>(std::move(field)));
+      field.clear();
+      quoted = false;
+    } else if (c == '\r' && pos == line_.size()) {
+      // Windows 换行符
+    } else {
+      field.push_back(c);
+    }
+  }
+  fields.emplace_back(field.empty() && !quoted ? std::nullopt : std::optional<std::string>(std::move(field)));
+  return true;
+}
+
+size_t CsvReader::GetLineNumber() const { return row_line_number_; }
+
+Value CsvReader::ParseField(const std::optional<std::string> &field, Type type, db_size_t max_size) {
+  if (!field.has_value()) {
+    return Value();
+  }
+  const auto &str = *field;
+  auto invalid = [&]() {
+    return DbException("Invalid input for type " + TypeUtil::Type2String(type) + ": \"" + str + "\"");
+  };
+  char *end;
+  errno = 0;
+  switch (type) {
+    case Type::INT: {
+      auto value = strtol(str.c_str(), &end, 10);
+      if (str.empty() || *end != '\0' || errno != 0 || value < std::numeric_limits<int32_t>::min() ||
+          value > std::numeric_limits<int32_t>::max()) {
+        throw invalid();
+      }
+      return Value(static_cast<int32_t>(value));
+    }
+    case Type::UINT: {
+      auto value = strtoul(str.c_str(), &end, 10);
+      if (str.empty() || str[0] == '-' || *end != '\0' || errno != 0 ||
+          value > std::numeric_limits<uint32_t>::max()) {
+        throw invalid();
+      }
+      return Value(static_cast<uint32_t>(value));
+    }
+    case Type::DOUBLE: {
+      auto value = strtod(str.c_str(), &end);
+      if (str.empty() || *end != '\0' || errno != 0) {
+        throw invalid();
+      }
+      return Value(value);
+    }
+    case Type::CHAR:
+    case Type::VARCHAR:
+      if (str.size() > max_size) {
+        throw DbException("Value too long for type " + TypeUtil::Type2String(type) + "(" + std::to_string(max_size) +
+                          ")");
+      }
+      return Value(str);
+    default:
+      throw DbException("Unsupported column type in COPY");
+  }
+}
+
+}  // namespace huadb
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+#include "common/value.h"
+
+namespace huadb {
+
+// 流式读取 CSV 文件，格式与 PostgreSQL COPY 的 CSV 格式相同
+// 字段可用双引号包围，引号内的 "" 表示一个双引号，且可以包含分隔符和换行；未加引号的空字段为 NULL
+class CsvReader {
+ public:
+  CsvReader(const std::string &path, char delimiter);
+
+  // 读取下一行的所有字段，文件结束时返回 false
+  bool ReadRow(std::vector<std::optional<std::string>> &fields);
+  // 最近读取的一行在文件中的起始行号，从 1 开始
+  size_t GetLineNumber() const;
+
+  // 将字段转换为 type 类型的值，NULL 字段返回空值，格式错误或字符串超过 max_size 时抛出异常
+  static Value ParseField(const std::optional<std::string> &field, Type type, db_size_t max_size);
+
+ private:
+  std::ifstream file_;
+  char delimiter_;
+  std::string line_;
+  size_t line_number_ = 0;       // 已读取的物理行数
+  size_t row_line_number_ = 0;  // 最近读取的一行的起始行号
+};
+
+}  // namespace huadb
@@ -95,4 +95,67 @@ bool TypeUtil::TypeCompatible(Type type1, Type type2) {
   return type1 == type2;
 }
 
+std::string TypeUtil::Layout2String(TableLayout layout) {
+  switch (layout) {
+    case TableLayout::ROW:
+      return "row";
+    case TableLayout::PAX:
+      return "pax";
+    default:
+      throw DbException("Unknown layout in Layout2String");
+  }
+}
+
+TableLayout TypeUtil::String2Layout(const std::string &str) {
+  if (str == "row") {
+    return TableLayout::ROW;
+  } else if (str == "pax") {
+    return TableLayout::PAX;
+  } else {
+    throw DbException("Unknown table layout \"" + str + "\"");
+  }
+}
+
+std::string TypeUtil::Compression2String(CompressionType compression) {
+  switch (compression) {
+    case CompressionType::NONE:
+      return "none";
+    case CompressionType::LZ:
+      return "lz";
+    default:
+      throw DbException("Unknown compression in Compression2String");
+  }
+}
+
+CompressionType TypeUtil::String2Compression(const std::string &str) {
+  if (str == "none") {
+    return CompressionType::NONE;
+  } else if (str == "lz") {
+    return CompressionType::LZ;
+  } else {
+    throw DbException("Unknown table compression \"" + str + "\"");
+  }
+}
+
+std::string TypeUtil::IndexType2String(IndexType index_type) {
+  switch (index_type) {
+    case IndexType::BTREE:
+      return "btree";
+    case IndexType::HASH:
+      return "hash";
+    default:
+      throw DbException("Unknown index type in IndexType2String");
+  }
+}
+
+IndexType TypeUtil::String2IndexType(const std::string &str) {
+  if (str == "btree") {
+    return IndexType::BTREE;
+  } else if (str == "hash") {
+    return IndexType::HASH;
+  } else {
+    throw DbException("Unknown index type \"" + str + "\"");
+  }
+}
+
 }  // namespace huadb
@@ -2,6 +2,8 @@
 
 #include <string>
 
+#include "common/types.h"
+
 namespace huadb {
 
 enum class Type { BOOL, INT, UINT, DOUBLE, CHAR, VARCHAR, NULL_TYPE, LIST };
@@ -14,6 +16,12 @@ class TypeUtil {
   static bool IsNumeric(Type type);
   static bool IsString(Type type);
   static bool TypeCompatible(Type type1, Type type2);
+  static std::string Layout2String(TableLayout layout);
+  static TableLayout String2Layout(const std::string &str);
+  static std::string Compression2String(CompressionType compression);
+  static CompressionType String2Compression(const std::string &str);
+  static std::string IndexType2String(IndexType index_type);
+  static IndexType String2IndexType(const std::string &str);
 };
 
 }  // namespace huadb
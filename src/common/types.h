@@ -14,6 +14,13 @@ using slotid_t = uint16_t;
 using db_size_t = uint16_t;
 using enum_t = uint8_t;
 
+// 表的页面布局：ROW 为按行存放的分槽页面，PAX 为页内按列存放
+enum class TableLayout : enum_t { ROW, PAX };
+// 表页面写回磁盘时的压缩方式：NONE 为不压缩，LZ 为 LZ4 块格式的整页压缩
+enum class CompressionType : enum_t { NONE, LZ };
+// 索引的组织方式：BTREE 为 B+ 树，HASH 为线性哈希，只支持等值查找
+enum class IndexType : enum_t { BTREE, HASH };
+
 struct Rid {
   pageid_t page_id_;
   slotid_t slot_id_;
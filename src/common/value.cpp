@@ -19,17 +19,20 @@ Value::Value(uint32_t val) : type_(Type::UINT), size_(TypeUtil::TypeSize(Type::U
 
 Value::Value(double val) : type_(Type::DOUBLE), size_(TypeUtil::TypeSize(Type::DOUBLE)) { val_.double_ = val; }
 
-Value::Value(const char *val, Type type) : type_(type) {
-  str_ = val;
-  size_ = str_.size();
-}
+Value::Value(const char *val, Type type) : type_(type) { SetString(val, strlen(val)); }
 
 Value::Value(std::string val, Type type) : type_(type) {
-  str_ = std::move(val);
-  size_ = str_.size();
+  if (val.size() <= INLINE_STRING_SIZE) {
+    SetString(val.data(), val.size());
+  } else {
+    size_ = val.size();
+    heap_ = std::make_shared<const HeapData>(HeapData{std::move(val), {}});
+  }
 }
 
-Value::Value(std::vector<Value> values) : values_(std::move(values)), type_(Type::LIST) {}
+Value::Value(std::vector<Value> values) : type_(Type::LIST), size_(0) {
+  heap_ = std::make_shared<const HeapData>(HeapData{{}, std::move(values)});
+}
 
 bool Value::IsNull() const { return is_null_ || type_ == Type::NULL_TYPE; }
 
@@ -57,7 +60,7 @@ std::string Value::ToString() const {
     }
     case Type::CHAR:
     case Type::VARCHAR:
-      return str_;
+      return std::string(GetStringView());
     default:
       throw DbException("Unknown value type in ToString");
   }
@@ -80,9 +83,10 @@ db_size_t Value::SerializeTo(char *data) const {
       break;
     case Type::VARCHAR:
     case Type::CHAR: {
-      db_size_t str_size = str_.size();
+      auto str = GetStringView();
+      db_size_t str_size = str.size();
       memcpy(data, &str_size, 2);
-      memcpy(data + 2, str_.c_str(), size_);
+      memcpy(data + 2, str.data(), str_size);
       result = str_size + 2;
       break;
     }
@@ -110,9 +114,10 @@ db_size_t Value::DeserializeFrom(const char *data) {
       break;
     case Type::VARCHAR:
     case Type::CHAR: {
-      memcpy(&size_, data, 2);
-      str_ = std::string(data + 2, data + size_ + 2);
-      result = size_ + 2;
+      db_size_t str_size;
+      memcpy(&str_size, data, 2);
+      SetString(data + 2, str_size);
+      result = str_size + 2;
       break;
     }
     default:
@@ -123,7 +128,10 @@ db_size_t Value::DeserializeFrom(const char *data) {
 
 Type Value::GetType() const { return type_; }
 
-const std::vector<Value> &Value::GetValues() const { return values_; }
+const std::vector<Value> &Value::GetValues() const {
+  static const std::vector<Value> empty_values;
+  return heap_ != nullptr ? heap_->values_ : empty_values;
+}
 
 template <>
 bool Value::GetValue<bool>() const {
@@ -162,7 +170,15 @@ std::string Value::GetValue<std::string>() const {
   if (!TypeUtil::IsString(type_)) {
     throw DbException("Type mismatch (expected char/varchar)");
   }
-  return str_;
+  return std::string(GetStringView());
+}
+
+template <>
+std::string_view Value::GetValue<std::string_view>() const {
+  if (!TypeUtil::IsString(type_)) {
+    throw DbException("Type mismatch (expected char/varchar)");
+  }
+  return GetStringView();
 }
 
 template <>
@@ -170,7 +186,7 @@ const char *Value::GetValue<const char *>() const {
   if (!TypeUtil::IsString(type_)) {
     throw DbException("Type mismatch (expected char/varchar)");
   }
-  return str_.c_str();
+  return heap_ != nullptr ? heap_->str_.c_str() : val_.str_;
 }
 
 bool Value::Less(const Value &other) const {
@@ -184,7 +200,7 @@ bool Value::Less(const Value &other) const {
       return val_.double_ < other.val_.double_;
     case Type::CHAR:
     case Type::VARCHAR:
-      return str_ < other.str_;
+      return GetStringView() < other.GetStringView();
     default:
       throw DbException("Type unsupported for Less operation");
   }
@@ -203,7 +219,7 @@ bool Value::Equal(const Value &other) const {
       return val_.double_ == other.val_.double_;
     case Type::CHAR:
     case Type::VARCHAR:
-      return str_ == other.str_;
+      return GetStringView() == other.GetStringView();
     default:
       throw DbException("Type unsupported for Equal operation");
   }
@@ -220,7 +236,7 @@ bool Value::Greater(const Value &other) const {
       return val_.double_ > other.val_.double_;
     case Type::CHAR:
     case Type::VARCHAR:
-      return str_ > other.str_;
+      return GetStringView() > other.GetStringView();
     default:
       throw DbException("Type unsupported for Greater operation");
   }
@@ -283,12 +299,13 @@ Value Value::CastAsBool() const {
       return Value(val_.bool_);
     case Type::CHAR:
     case Type::VARCHAR: {
-      if (str_ == "t") {
+      auto str = GetStringView();
+      if (str == "t") {
         return Value(true);
-      } else if (str_ == "f") {
+      } else if (str == "f") {
         return Value(false);
       } else {
-        throw DbException("Unknown str in CastAsBool: " + str_);
+        throw DbException("Unknown str in CastAsBool: " + std::string(str));
       }
     }
     default:
@@ -298,6 +315,24 @@ Value Value::CastAsBool() const {
 
 bool Value::operator==(const Value &other) const { return Equal(other); }
 
+void Value::SetString(const char *data, size_t size) {
+  size_ = size;
+  if (size <= INLINE_STRING_SIZE) {
+    memcpy(val_.str_, data, size);
+    val_.str_[size] = '\0';
+    heap_.reset();
+  } else {
+    heap_ = std::make_shared<const HeapData>(HeapData{std::string(data, size), {}});
+  }
+}
+
+std::string_view Value::GetStringView() const {
+  if (heap_ != nullptr) {
+    return heap_->str_;
+  }
+  return std::string_view(val_.str_, size_);
+}
+
 }  // namespace huadb
 
 namespace std {
@@ -314,7 +349,7 @@ uint64_t hash<huadb::Value>::operator()(const huadb::Value &other) const {
       return std::hash<double>()(other.GetValue<double>());
     case huadb::Type::VARCHAR:
     case huadb::Type::CHAR:
-      return std::hash<std::string>()(other.GetValue<std::string>());
+      return std::hash<std::string_view>()(other.GetValue<std::string_view>());
     default:
       throw huadb::DbException("Unknown value type in hash");
   }
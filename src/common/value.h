@@ -1,7 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "common/type_util.h"
@@ -48,18 +50,31 @@ class Value {
   bool operator==(const Value &other) const;
 
  private:
+  // 不超过该长度的字符串直接存放在 val_ 中，无需分配堆内存
+  static constexpr size_t INLINE_STRING_SIZE = 15;
+
+  // 长字符串和列表存放在只读的堆对象中，复制 Value 时共享该对象
+  struct HeapData {
+    std::string str_;
+    std::vector<Value> values_;
+  };
+
+  // 设置字符串内容，size_ 设为字符串长度
+  void SetString(const char *data, size_t size);
+  std::string_view GetStringView() const;
+
   Type type_;
   bool is_null_ = false;
+  db_size_t size_;  // 定长类型的字节数，或字符串的长度
   union {
     bool bool_;
     int32_t int_;
     uint32_t uint_;
     uint64_t uint64_;
     double double_;
+    char str_[INLINE_STRING_SIZE + 1];  // 短字符串，以 '\0' 结尾
   } val_;
-  std::string str_;
-  std::vector<Value> values_;
-  db_size_t size_;
+  std::shared_ptr<const HeapData> heap_;
 };
 
 }  // namespace huadb
@@ -0,0 +1,58 @@
+#include "database/autovacuum.h"
+
+#include <chrono>
+#include <utility>
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+AutoVacuum::AutoVacuum(std::function<void(AutoVacuum &)> work)
+    : work_(std::move(work)), thread_(&AutoVacuum::Work, this) {}
+
+AutoVacuum::~AutoVacuum() {
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void AutoVacuum::SetNaptime(size_t naptime_ms) {
+  {
+    std::scoped_lock lock(mutex_);
+    naptime_ms_ = naptime_ms;
+  }
+  cv_.notify_all();
+}
+
+bool AutoVacuum::Sleep(size_t delay_ms) {
+  std::unique_lock lock(mutex_);
+  return !cv_.wait_for(lock, std::chrono::milliseconds(delay_ms), [this] { return stop_; });
+}
+
+void AutoVacuum::Work() {
+  std::unique_lock lock(mutex_);
+  while (!stop_) {
+    if (naptime_ms_ == 0) {
+      cv_.wait(lock, [this] { return stop_ || naptime_ms_ > 0; });
+      continue;
+    }
+    auto naptime_ms = naptime_ms_;
+    if (cv_.wait_for(lock, std::chrono::milliseconds(naptime_ms), [this, naptime_ms] {
+          return stop_ || naptime_ms_ != naptime_ms;
+        })) {
+      continue;
+    }
+    lock.unlock();
+    try {
+      work_(*this);
+    } catch (DbException &e) {
+      // 清理失败的表保留失效版本计数，下一轮检查时重试
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace huadb
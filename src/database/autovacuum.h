@@ -0,0 +1,34 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace huadb {
+
+// 自动清理进程，每隔一段时间执行一轮检查，由数据库引擎清理失效版本比例超过阈值的表
+class AutoVacuum {
+ public:
+  // work 为每轮检查执行的操作，批次之间通过传入的 AutoVacuum 休眠
+  explicit AutoVacuum(std::function<void(AutoVacuum &)> work);
+  ~AutoVacuum();
+
+  // 设置两轮检查之间的间隔（毫秒），0 表示暂停
+  void SetNaptime(size_t naptime_ms);
+  // 清理批次之间的休眠，返回 false 表示进程需要停止
+  bool Sleep(size_t delay_ms);
+
+ private:
+  void Work();
+
+  std::function<void(AutoVacuum &)> work_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;  // 间隔被修改或需要停止
+  size_t naptime_ms_ = 0;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+}  // namespace huadb
@@ -5,19 +5,22 @@
 #include "binder/binder.h"
 #include "binder/statements/statements.h"
 #include "common/constants.h"
+#include "common/csv_reader.h"
 #include "common/exceptions.h"
 #include "common/result_writer.h"
 #include "common/string_util.h"
 #include "database/connection.h"
 #include "executors/executor_context.h"
 #include "executors/executor_factory.h"
+#include "index/index.h"
 #include "operators/expressions/column_value.h"
 #include "postgres_parser.hpp"
+#include "table/bulk_loader.h"
 #include "table/record.h"
 
 namespace huadb {
 
-DatabaseEngine::DatabaseEngine() {
+DatabaseEngine::DatabaseEngine(size_t buffer_pool_size, size_t page_size) {
   // 数据库是否正常关闭
   bool normal_shutdown = true;
   disk_ = std::make_unique<Disk>();
@@ -30,18 +33,28 @@ DatabaseEngine::DatabaseEngine() {
     lsn_t lsn;
     // 下一个事务id，lsn，oid，以及是否正常关闭
     in >> xid >> lsn >> oid >> normal_shutdown;
-    std::ofstream out(CONTROL_NAME);
-    out.flush();
-    out << xid << " " << lsn << " " << oid << " " << false << std::endl;
+    // 版本 2 起记录控制文件版本和页面大小，已有数据库的页面大小以控制文件为准
+    uint32_t version;
+    if (in >> version) {
+      in >> page_size;
+    } else {
+      version = 1;
+      page_size = DEFAULT_DB_PAGE_SIZE;
+    }
+    if (version > CONTROL_FILE_VERSION) {
+      throw DbException("Unsupported control file version " + std::to_string(version));
+    }
+    disk_->SetPageSize(page_size);
+    WriteControl(xid, lsn, oid, false);
     transaction_manager_ = std::make_unique<TransactionManager>(*lock_manager_, xid);
     log_manager_ = std::make_unique<LogManager>(*disk_, *transaction_manager_, lsn);
   } else {
-    std::ofstream out(CONTROL_NAME);
-    out << FIRST_XID << " " << FIRST_LSN << " " << PRESERVED_OID << " " << false;
+    disk_->SetPageSize(page_size);
+    WriteControl(FIRST_XID, FIRST_LSN, PRESERVED_OID, false);
     transaction_manager_ = std::make_unique<TransactionManager>(*lock_manager_, FIRST_XID);
     log_manager_ = std::make_unique<LogManager>(*disk_, *transaction_manager_, FIRST_LSN);
   }
-  buffer_pool_ = std::make_shared<BufferPool>(*disk_, *log_manager_);
+  buffer_pool_ = std::make_shared<BufferPool>(*disk_, *log_manager_, buffer_pool_size);
   log_manager_->SetBufferPool(buffer_pool_);
 
   catalog_ = std::make_unique<Catalog>(*buffer_pool_, *log_manager_, oid);
@@ -59,9 +72,15 @@ DatabaseEngine::DatabaseEngine() {
   if (!normal_shutdown) {
     Recover();
   }
+
+  autovacuum_ = std::make_unique<AutoVacuum>([this](AutoVacuum &autovacuum) { AutoVacuumTables(autovacuum); });
+  autovacuum_->SetNaptime(autovacuum_naptime_);
 }
 
 DatabaseEngine::~DatabaseEngine() {
+  // 后台线程会访问 Disk 和 LogManager，需先停止
+  autovacuum_.reset();
+  buffer_pool_->Shutdown();
   // 如果数据库不是崩溃状态，关闭数据库
   if (std::uncaught_exceptions() == 0 && !crashed_) {
     CloseDatabase();
@@ -75,6 +94,7 @@ bool DatabaseEngine::InTransaction(const Connection &connection) const {
 }
 
 void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, const Connection &connection) {
+  std::shared_lock statement_lock(statement_mutex_);
   if (!sql.empty() && sql[0] == '\\') {
     if (sql[1] == 'l') {
       ShowDatabases(writer);
@@ -137,7 +157,7 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
           WriteOneCell("COMMIT", writer);
           break;
         case TransactionType::ROLLBACK:
-          Rollback(connection);
+          RollbackTransaction(connection);
           WriteOneCell("ROLLBACK", writer);
           break;
       }
@@ -171,7 +191,8 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
             throw DbException("Cannot execute DDL statement within a transaction block");
           }
           const auto &create_table_statement = dynamic_cast<CreateTableStatement &>(*statement);
-          CreateTable(create_table_statement.table_, ColumnList(create_table_statement.columns_), writer);
+          CreateTable(create_table_statement.table_, ColumnList(create_table_statement.columns_),
+                      create_table_statement.layout_, create_table_statement.compression_, writer);
           break;
         }
         case StatementType::CREATE_INDEX_STATEMENT: {
@@ -180,7 +201,8 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
           }
           const auto &create_index_statement = dynamic_cast<CreateIndexStatement &>(*statement);
           CreateIndex(create_index_statement.index_name_, create_index_statement.table_name_,
-                      create_index_statement.column_names_, writer);
+                      create_index_statement.column_names_, create_index_statement.index_type_,
+                      create_index_statement.include_column_names_, writer);
           break;
         }
         case StatementType::DROP_DATABASE_STATEMENT: {
@@ -204,12 +226,12 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
             throw DbException("Cannot execute DDL statement within a transaction block");
           }
           const auto &drop_index_statement = dynamic_cast<DropIndexStatement &>(*statement);
-          DropIndex(drop_index_statement.index_name_, writer);
+          DropIndex(drop_index_statement.index_name_, drop_index_statement.missing_ok_, writer);
           break;
         }
         case StatementType::EXPLAIN_STATEMENT: {
           const auto &explain_statement = dynamic_cast<ExplainStatement &>(*statement);
-          Explain(explain_statement, writer);
+          Explain(connection, explain_statement, writer);
           break;
         }
         case StatementType::LOCK_STATEMENT: {
@@ -233,8 +255,28 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
           break;
         }
         case StatementType::VACUUM_STATEMENT: {
+          if (CheckInTransaction(connection)) {
+            throw DbException("VACUUM cannot run inside a transaction block");
+          }
           const auto &vacuum_statement = dynamic_cast<VacuumStatement &>(*statement);
-          Vacuum(vacuum_statement, writer);
+          // 清理会整理页面、移动记录，与自动清理相同，需独占语句锁，避免与其他连接的语句并发访问同一页面
+          statement_lock.unlock();
+          std::unique_lock vacuum_lock(statement_mutex_);
+          try {
+            Vacuum(xids_[&connection], vacuum_statement, writer);
+          } catch (...) {
+            vacuum_lock.unlock();
+            statement_lock.lock();
+            throw;
+          }
+          vacuum_lock.unlock();
+          statement_lock.lock();
+          break;
+        }
+        case StatementType::COPY_STATEMENT: {
+          const auto &copy_statement = dynamic_cast<CopyStatement &>(*statement);
+          Copy(xids_[&connection], transaction_manager_->GetCidAndIncrement(xids_[&connection]), copy_statement,
+               writer);
           break;
         }
         case StatementType::UPDATE_STATEMENT:
@@ -283,11 +325,12 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
               writer.EndRow();
               record_count++;
             }
+            query_memory_stats_[&connection] = executor_context->GetArenaStats();
             writer.EndTable();
             writer.WriteRowCount(record_count);
           } catch (DbException &e) {
             if (auto_transaction_set_.find(&connection) != auto_transaction_set_.end()) {
-              Rollback(connection);
+              RollbackTransaction(connection);
               auto_transaction_set_.erase(&connection);
             }
             throw e;
@@ -297,7 +340,7 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
       }
     } catch (DbException &e) {
       if (auto_transaction_set_.find(&connection) != auto_transaction_set_.end()) {
-        Rollback(connection);
+        RollbackTransaction(connection);
         auto_transaction_set_.erase(&connection);
       }
       throw e;
@@ -311,6 +354,7 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
 }
 
 void DatabaseEngine::Crash() {
+  autovacuum_.reset();
   buffer_pool_->Clear();
   log_manager_->Clear();
   crashed_ = true;
@@ -368,21 +412,29 @@ void DatabaseEngine::DropDatabase(const std::string &db_name, bool missing_ok, R
     throw DbException("Cannot drop the currently open database");
   }
   catalog_->DropDatabase(db_name, missing_ok);
+  disk_->CloseFiles();
   WriteOneCell("DROP DATABASE", writer);
 }
 
 void DatabaseEngine::CloseDatabase() {
+  catalog_->SaveTableModificationStats();
   buffer_pool_->Flush();
+  catalog_->SaveFreeSpaceMaps();
   log_manager_->Flush();
   log_manager_->Checkpoint();
 
+  WriteControl(transaction_manager_->GetNextXid(), log_manager_->GetNextLSN(), catalog_->GetNextOid(), true);
+}
+
+void DatabaseEngine::WriteControl(xid_t xid, lsn_t lsn, oid_t oid, bool normal_shutdown) const {
   std::ofstream control(CONTROL_NAME);
-  control << transaction_manager_->GetNextXid() << " " << log_manager_->GetNextLSN() << " " << catalog_->GetNextOid()
-          << " " << true;
+  control << xid << " " << lsn << " " << oid << " " << normal_shutdown << " " << CONTROL_FILE_VERSION << " "
+          << disk_->GetPageSize() << std::endl;
 }
 
-void DatabaseEngine::CreateTable(const std::string &table_name, const ColumnList &column_list, ResultWriter &writer) {
-  catalog_->CreateTable(table_name, column_list);
+void DatabaseEngine::CreateTable(const std::string &table_name, const ColumnList &column_list, TableLayout layout,
+                                 CompressionType compression, ResultWriter &writer) {
+  catalog_->CreateTable(table_name, column_list, INVALID_OID, INVALID_OID, true, layout, compression);
   WriteOneCell("CREATE TABLE", writer);
 }
 
@@ -425,20 +477,41 @@ void DatabaseEngine::ShowTables(ResultWriter &writer) const {
 
 void DatabaseEngine::DropTable(const std::string &table_name, ResultWriter &writer) {
   catalog_->DropTable(table_name);
+  disk_->CloseFiles();
   WriteOneCell("DROP TABLE", writer);
 }
 
 void DatabaseEngine::CreateIndex(const std::string &index_name, const std::string &table_name,
-                                 const std::vector<std::string> &column_names, ResultWriter &writer) {
-  // Not implemented yet
+                                 const std::vector<std::string> &column_names, IndexType index_type,
+                                 const std::vector<std::string> &include_column_names, ResultWriter &writer) {
+  catalog_->CreateIndex(index_name, table_name, column_names, index_type, include_column_names);
+  // 为表中所有未被回收的记录版本建立索引项，建立过程不写日志，完成后将页面写回磁盘
+  auto index = catalog_->GetIndex(catalog_->GetIndexOid(index_name));
+  catalog_->GetTable(index->GetTableOid())->ForEachTuple([&index](const TupleView &tuple) {
+    index->InsertEntry(index->GetKey(tuple), index->GetIncludeValues(tuple), tuple.GetRid(), NULL_XID, false);
+  });
+  buffer_pool_->Flush(true);
   WriteOneCell("CREATE INDEX", writer);
 }
 
-void DatabaseEngine::DropIndex(const std::string &index_name, ResultWriter &writer) {
-  // Not implemented yet
+void DatabaseEngine::DropIndex(const std::string &index_name, bool missing_ok, ResultWriter &writer) {
+  catalog_->DropIndex(index_name, missing_ok);
+  disk_->CloseFiles();
   WriteOneCell("DROP INDEX", writer);
 }
 
+TupleVisitor DatabaseEngine::GetIndexEntryRemover(oid_t table_oid, xid_t xid) const {
+  auto indexes = catalog_->GetTableIndexes(table_oid);
+  if (indexes.empty()) {
+    return nullptr;
+  }
+  return [indexes = std::move(indexes), xid](const TupleView &tuple) {
+    for (const auto &index : indexes) {
+      index->DeleteEntry(index->GetKey(tuple), tuple.GetRid(), xid);
+    }
+  };
+}
+
 void DatabaseEngine::Begin(const Connection &connection) {
   if (InTransaction(connection)) {
     throw DbException("There is already a transaction in progress");
@@ -460,6 +533,11 @@ void DatabaseEngine::Commit(const Connection &connection) {
 }
 
 void DatabaseEngine::Rollback(const Connection &connection) {
+  std::shared_lock statement_lock(statement_mutex_);
+  RollbackTransaction(connection);
+}
+
+void DatabaseEngine::RollbackTransaction(const Connection &connection) {
   if (!InTransaction(connection)) {
     throw DbException("There is no transaction in process");
   } else {
@@ -488,7 +566,73 @@ void DatabaseEngine::Lock(xid_t xid, const LockStatement &stmt, ResultWriter &wr
   }
 }
 
-void DatabaseEngine::Explain(const ExplainStatement &stmt, ResultWriter &writer) {
+void DatabaseEngine::Copy(xid_t xid, cid_t cid, const CopyStatement &stmt, ResultWriter &writer) {
+  auto oid = stmt.table_->oid_;
+  // 只追加新页面，不修改已有记录，与插入相同只需对表加 IX 锁
+  if (!lock_manager_->LockTable(xid, LockType::IX, oid)) {
+    throw DbException("Cannot acquire lock");
+  }
+  auto table = catalog_->GetTable(oid);
+  const auto &column_list = stmt.table_->column_list_;
+  auto column_count = column_list.Length();
+  // 空表导入后直接得到准确的统计信息，无需再次分析
+  bool was_empty = table->GetFirstPageId() == NULL_PAGE_ID;
+  std::vector<std::unordered_set<Value>> value_set(was_empty ? column_count : 0);
+
+  CsvReader reader(stmt.file_path_, stmt.delimiter_);
+  // 导入的记录追加到表中后插入表上所有索引
+  auto indexes = catalog_->GetTableIndexes(oid);
+  BulkLoader::RecordCallback on_append = nullptr;
+  if (!indexes.empty()) {
+    on_append = [&indexes, xid](const Record &record) {
+      for (const auto &index : indexes) {
+        index->InsertEntry(index->GetKey(record), index->GetIncludeValues(record), record.GetRid(), xid, true);
+      }
+    };
+  }
+  BulkLoader loader(*table, buffer_pool_->GetPageSize(), xid, cid, on_append);
+  std::vector<std::optional<std::string>> fields;
+  if (stmt.header_) {
+    reader.ReadRow(fields);
+  }
+  while (reader.ReadRow(fields)) {
+    auto line = std::to_string(reader.GetLineNumber());
+    if (fields.size() != column_count) {
+      throw DbException("COPY expects " + std::to_string(column_count) + " columns but line " + line + " has " +
+                        std::to_string(fields.size()));
+    }
+    std::vector<Value> values;
+    values.reserve(column_count);
+    for (size_t i = 0; i < column_count; i++) {
+      const auto &column = column_list.GetColumn(i);
+      try {
+        values.push_back(CsvReader::ParseField(fields[i], column.type_, column.GetMaxSize()));
+      } catch (const DbException &e) {
+        throw DbException(std::string(e.what()) + " (line " + line + ", column " + column.name_ + ")");
+      }
+      // 不同值个数不统计空值
+      if (was_empty && !values.back().IsNull()) {
+        value_set[i].insert(values.back());
+      }
+    }
+    loader.Append(std::make_shared<Record>(std::move(values)));
+  }
+  auto count = loader.Finish();
+
+  catalog_->CountTableModifications(oid, count, 0, 0);
+  auto table_name = stmt.table_->table_;
+  if (was_empty) {
+    catalog_->SetCardinality(table_name, count);
+    for (size_t i = 0; i < column_count; i++) {
+      catalog_->SetDistinct(table_name, column_list.GetColumn(i).name_, value_set[i].size());
+    }
+  } else if (auto cardinality = catalog_->GetCardinality(table_name); cardinality != INVALID_CARDINALITY) {
+    catalog_->SetCardinality(table_name, cardinality + count);
+  }
+  WriteOneCell(std::to_string(count), writer);
+}
+
+void DatabaseEngine::Explain(const Connection &connection, const ExplainStatement &stmt, ResultWriter &writer) {
   std::string output;
   if ((stmt.options_ & ExplainOptions::BINDER) != 0) {
     output += "===Binder===\n";
@@ -513,10 +657,55 @@ void DatabaseEngine::Explain(const ExplainStatement &stmt, ResultWriter &writer)
     output += plan->ToString();
   }
 
+  if ((stmt.options_ & ExplainOptions::ANALYZE) != 0) {
+    // 执行查询并丢弃结果，统计由各顺序扫描执行器登记到查询上下文中
+    IsolationLevel isolation_level = DEFAULT_ISOLATION_LEVEL;
+    if (isolation_levels_.find(&connection) != isolation_levels_.end()) {
+      isolation_level = isolation_levels_[&connection];
+    }
+    bool is_modification_sql = stmt.statement_->type_ == StatementType::UPDATE_STATEMENT ||
+                               stmt.statement_->type_ == StatementType::DELETE_STATEMENT;
+    auto executor_context = std::make_unique<ExecutorContext>(
+        *buffer_pool_, *catalog_, *transaction_manager_, *lock_manager_, xids_[&connection], isolation_level,
+        transaction_manager_->GetCidAndIncrement(xids_[&connection]), is_modification_sql);
+    size_t record_count = 0;
+    {
+      auto executor = ExecutorFactory::CreateExecutor(*executor_context, plan);
+      executor->Init();
+      while (executor->Next() != nullptr) {
+        record_count++;
+      }
+    }
+    if (!output.empty() && output.back() != '\n') {
+      output += "\n";
+    }
+    output += "===Analyze===\n";
+    output += "Rows: " + std::to_string(record_count) + "\n";
+    for (const auto &[table_name, stats] : executor_context->GetScanStats()) {
+      output += "SeqScan: " + table_name + " scanned pages: " + std::to_string(stats.scanned_pages_) +
+                ", skipped pages: " + std::to_string(stats.skipped_pages_) + "\n";
+    }
+    for (const auto &[table_name, stats] : executor_context->GetIndexScanStats()) {
+      output += "IndexScan: " + table_name + " heap fetches: " + std::to_string(stats.heap_fetches_) +
+                ", heap fetches avoided: " + std::to_string(stats.heap_fetches_avoided_) + "\n";
+    }
+    // 与其他部分一致，结尾不换行
+    output.pop_back();
+  }
+
   WriteOneCell(output, writer);
 }
 
 void DatabaseEngine::VariableSet(const Connection &connection, const VariableSetStatement &stmt, ResultWriter &writer) {
+  if (stmt.reset_) {
+    if (stmt.variable_ != "buffer_stats") {
+      throw DbException("RESET is only supported for buffer_stats");
+    }
+    buffer_pool_->ResetStats();
+    disk_->ResetStats();
+    WriteOneCell("RESET", writer);
+    return;
+  }
   if (stmt.variable_ == "isolation_level") {
     isolation_levels_[&connection] = String2IsolationLevel(stmt.value_);
   } else if (stmt.variable_ == "join_order_algorithm") {
@@ -529,6 +718,35 @@ void DatabaseEngine::VariableSet(const Connection &connection, const VariableSet
     enable_projection_pushdown_ = String2Bool(stmt.value_);
   } else if (stmt.variable_ == "deadlock") {
     lock_manager_->SetDeadLockType(String2DeadlockType(stmt.value_));
+  } else if (stmt.variable_ == "buffer_pool_size") {
+    buffer_pool_->SetPoolSize(String2Size(stmt.value_));
+  } else if (stmt.variable_ == "read_ahead_pages") {
+    buffer_pool_->SetReadAheadPages(String2Size(stmt.value_, true));
+  } else if (stmt.variable_ == "bgwriter_delay") {
+    buffer_pool_->SetBgWriterDelay(String2Size(stmt.value_, true));
+  } else if (stmt.variable_ == "bgwriter_max_pages") {
+    buffer_pool_->SetBgWriterMaxPages(String2Size(stmt.value_));
+  } else if (stmt.variable_ == "bgwriter_clean_percent") {
+    buffer_pool_->SetBgWriterCleanPercent(String2Size(stmt.value_));
+  } else if (stmt.variable_ == "autovacuum_naptime") {
+    autovacuum_naptime_ = String2Size(stmt.value_, true);
+    autovacuum_->SetNaptime(autovacuum_naptime_);
+  } else if (stmt.variable_ == "autovacuum_threshold") {
+    autovacuum_threshold_ = String2Size(stmt.value_, true);
+  } else if (stmt.variable_ == "autovacuum_dead_percent") {
+    auto dead_percent = String2Size(stmt.value_);
+    if (dead_percent > 100) {
+      throw DbException("autovacuum_dead_percent must be between 1 and 100");
+    }
+    autovacuum_dead_percent_ = dead_percent;
+  } else if (stmt.variable_ == "autovacuum_batch_pages") {
+    autovacuum_batch_pages_ = String2Size(stmt.value_);
+  } else if (stmt.variable_ == "autovacuum_batch_delay") {
+    autovacuum_batch_delay_ = String2Size(stmt.value_, true);
+  } else if (stmt.variable_ == "page_size") {
+    throw DbException("page_size can only be specified when the database is created");
+  } else if (stmt.variable_ == "buffer_strategy") {
+    buffer_pool_->SetBufferStrategy(String2BufferStrategyType(stmt.value_));
   }
   client_variables_[&connection][stmt.variable_] = stmt.value_;
   WriteOneCell("SET", writer);
@@ -543,10 +761,46 @@ void DatabaseEngine::VariableShow(const Connection &connection, const VariableSh
   } else if (stmt.variable_ == "databases") {
     ShowDatabases(writer);
     return;
+  } else if (stmt.variable_ == "buffer_stats") {
+    ShowBufferStats(writer);
+    return;
+  } else if (stmt.variable_ == "buffer_strategy_stats") {
+    ShowBufferStrategyStats(writer);
+    return;
+  } else if (stmt.variable_ == "query_memory_stats") {
+    ShowQueryMemoryStats(connection, writer);
+    return;
+  } else if (stmt.variable_ == "table_stats") {
+    ShowTableStats(writer);
+    return;
   } else if (stmt.variable_ == "disk_access_count") {
     result = std::to_string(disk_->GetAccessCount());
   } else if (stmt.variable_ == "redo_count") {
     result = std::to_string(log_manager_->GetRedoCount());
+  } else if (stmt.variable_ == "buffer_pool_size") {
+    result = std::to_string(buffer_pool_->GetPoolSize());
+  } else if (stmt.variable_ == "read_ahead_pages") {
+    result = std::to_string(buffer_pool_->GetReadAheadPages());
+  } else if (stmt.variable_ == "bgwriter_delay") {
+    result = std::to_string(buffer_pool_->GetBgWriterDelay());
+  } else if (stmt.variable_ == "bgwriter_max_pages") {
+    result = std::to_string(buffer_pool_->GetBgWriterMaxPages());
+  } else if (stmt.variable_ == "bgwriter_clean_percent") {
+    result = std::to_string(buffer_pool_->GetBgWriterCleanPercent());
+  } else if (stmt.variable_ == "autovacuum_naptime") {
+    result = std::to_string(autovacuum_naptime_);
+  } else if (stmt.variable_ == "autovacuum_threshold") {
+    result = std::to_string(autovacuum_threshold_);
+  } else if (stmt.variable_ == "autovacuum_dead_percent") {
+    result = std::to_string(autovacuum_dead_percent_);
+  } else if (stmt.variable_ == "autovacuum_batch_pages") {
+    result = std::to_string(autovacuum_batch_pages_);
+  } else if (stmt.variable_ == "autovacuum_batch_delay") {
+    result = std::to_string(autovacuum_batch_delay_);
+  } else if (stmt.variable_ == "page_size") {
+    result = std::to_string(disk_->GetPageSize());
+  } else if (stmt.variable_ == "buffer_strategy") {
+    result = BufferStrategyType2String(buffer_pool_->GetBufferStrategy());
   } else {
     if (client_variables_.find(&connection) == client_variables_.end() ||
         client_variables_.at(&connection).find(stmt.variable_) == client_variables_.at(&connection).end()) {
@@ -567,7 +821,6 @@ void DatabaseEngine::VariableShow(const Connection &connection, const VariableSh
 
 void DatabaseEngine::Analyze(const AnalyzeStatement &stmt, ResultWriter &writer) {
   std::vector<std::string> table_names;
-  std::vector<uint32_t> column_idxs;
   std::vector<ColumnValue> columns;
   if (stmt.table_ == nullptr) {
     table_names = catalog_->GetTableNames();
@@ -584,40 +837,255 @@ void DatabaseEngine::Analyze(const AnalyzeStatement &stmt, ResultWriter &writer)
       }
     }
   }
+  for (const auto &table_name : table_names) {
+    AnalyzeTable(table_name, columns);
+  }
+  WriteOneCell("Analyze", writer);
+}
+
+void DatabaseEngine::AnalyzeTable(const std::string &table_name, std::vector<ColumnValue> columns) {
+  auto oid = catalog_->GetTableOid(table_name);
+  auto table = catalog_->GetTable(oid);
+  if (columns.empty()) {
+    auto column_list = catalog_->GetTableColumnList(table_name);
+    for (size_t i = 0; i < column_list.Length(); i++) {
+      auto col_type = column_list.GetColumn(i).type_;
+      auto col_name = column_list.GetColumn(i).name_;
+      auto col_size = column_list.GetColumn(i).GetMaxSize();
+      columns.emplace_back(i, col_type, col_name, col_size, true);
+    }
+  }
+  auto scan = std::make_unique<TableScan>(*buffer_pool_, table, Rid{table->GetFirstPageId(), 0});
+  uint32_t record_count = 0;
+  std::vector<std::unordered_set<Value>> value_set;
+  value_set.resize(columns.size());
+  while (auto record = scan->GetNextRecord()) {
+    for (size_t i = 0; i < columns.size(); i++) {
+      value_set[i].insert(record->GetValue(columns[i].GetColumnIndex()));
+    }
+    record_count++;
+  }
+  catalog_->SetCardinality(table_name, record_count);
+  for (size_t i = 0; i < columns.size(); i++) {
+    catalog_->SetDistinct(table_name, columns[i].name_, value_set[i].size());
+  }
+}
+
+void DatabaseEngine::Vacuum(xid_t xid, const VacuumStatement &stmt, ResultWriter &writer) {
+  // LAB 1 ADVANCED BEGIN
+  std::vector<std::string> table_names;
+  if (stmt.table_ == nullptr) {
+    table_names = catalog_->GetTableNames();
+  } else {
+    table_names.push_back(stmt.table_->table_);
+  }
+  // 清理事务本身也是活跃事务，oldest_xmin 不会超过其 xid
+  auto oldest_xmin = transaction_manager_->GetOldestXmin();
+  writer.BeginTable();
+  writer.BeginHeader();
+  writer.WriteHeaderCell("table");
+  writer.WriteHeaderCell("compacted_pages");
+  writer.WriteHeaderCell("removed_records");
+  writer.WriteHeaderCell("freed_bytes");
+  writer.EndHeader();
   for (const auto &table_name : table_names) {
     auto oid = catalog_->GetTableOid(table_name);
-    auto table = catalog_->GetTable(oid);
-    if (stmt.columns_.empty()) {
-      auto column_list = catalog_->GetTableColumnList(table_name);
-      columns.clear();
-      for (size_t i = 0; i < column_list.Length(); i++) {
-        auto col_type = column_list.GetColumn(i).type_;
-        auto col_name = column_list.GetColumn(i).name_;
-        auto col_size = column_list.GetColumn(i).GetMaxSize();
-        columns.emplace_back(i, col_type, col_name, col_size, true);
+    auto dead_tuples = catalog_->GetTableModificationStats(oid).n_dead_tup_;
+    auto stats = catalog_->GetTable(oid)->Vacuum(xid, oldest_xmin, GetIndexEntryRemover(oid, xid));
+    catalog_->CountVacuumedTuples(oid, dead_tuples);
+    writer.BeginRow();
+    writer.WriteCell(table_name);
+    writer.WriteCell(std::to_string(stats.compacted_pages_));
+    writer.WriteCell(std::to_string(stats.removed_records_));
+    writer.WriteCell(std::to_string(stats.freed_bytes_));
+    writer.EndRow();
+  }
+  writer.EndTable();
+  writer.WriteRowCount(table_names.size());
+}
+
+void DatabaseEngine::AutoVacuumTables(AutoVacuum &autovacuum) {
+  std::vector<std::pair<std::string, oid_t>> tables;
+  {
+    std::unique_lock statement_lock(statement_mutex_);
+    for (const auto &table_name : catalog_->GetTableNames()) {
+      auto oid = catalog_->GetTableOid(table_name);
+      if (NeedsAutoVacuum(catalog_->GetTableModificationStats(oid))) {
+        tables.emplace_back(table_name, oid);
       }
     }
-    auto scan = std::make_unique<TableScan>(*buffer_pool_, table, Rid{table->GetFirstPageId(), 0});
-    uint32_t record_count = 0;
-    std::vector<std::unordered_set<Value>> value_set;
-    value_set.resize(columns.size());
-    while (auto record = scan->GetNextRecord()) {
-      for (size_t i = 0; i < columns.size(); i++) {
-        value_set[i].insert(record->GetValue(columns[i].GetColumnIndex()));
+  }
+  for (const auto &[table_name, oid] : tables) {
+    if (!AutoVacuumTable(autovacuum, table_name, oid)) {
+      return;
+    }
+  }
+}
+
+bool DatabaseEngine::AutoVacuumTable(AutoVacuum &autovacuum, const std::string &table_name, oid_t oid) {
+  pageid_t page_id;
+  uint32_t dead_tuples;
+  {
+    std::unique_lock statement_lock(statement_mutex_);
+    if (!catalog_->TableExists(oid)) {
+      return true;
+    }
+    page_id = catalog_->GetTable(oid)->GetFirstPageId();
+    dead_tuples = catalog_->GetTableModificationStats(oid).n_dead_tup_;
+  }
+  while (page_id != NULL_PAGE_ID) {
+    size_t batch_delay;
+    {
+      std::unique_lock statement_lock(statement_mutex_);
+      // 批次之间表可能已被删除，或当前数据库已被切换
+      if (!catalog_->TableExists(oid)) {
+        return true;
+      }
+      auto table = catalog_->GetTable(oid);
+      // 每个批次使用单独的事务，避免长时间持有的 xid 阻止其他清理回收失效版本
+      auto xid = transaction_manager_->Begin();
+      log_manager_->AppendBeginLog(xid);
+      try {
+        VacuumStats stats;
+        auto oldest_xmin = transaction_manager_->GetOldestXmin();
+        page_id = table->VacuumPages(xid, oldest_xmin, page_id, autovacuum_batch_pages_, stats,
+                                     GetIndexEntryRemover(oid, xid));
+      } catch (DbException &e) {
+        log_manager_->Rollback(xid);
+        log_manager_->AppendRollbackLog(xid);
+        transaction_manager_->Rollback(xid);
+        throw e;
       }
-      record_count++;
+      log_manager_->AppendCommitLog(xid);
+      transaction_manager_->Commit(xid);
+      batch_delay = autovacuum_batch_delay_;
     }
-    catalog_->SetCardinality(table_name, record_count);
-    for (size_t i = 0; i < columns.size(); i++) {
-      catalog_->SetDistinct(table_name, columns[i].name_, value_set[i].size());
+    if (page_id != NULL_PAGE_ID && !autovacuum.Sleep(batch_delay)) {
+      return false;
     }
   }
-  WriteOneCell("Analyze", writer);
+  std::unique_lock statement_lock(statement_mutex_);
+  if (!catalog_->TableExists(oid)) {
+    return true;
+  }
+  catalog_->CountVacuumedTuples(oid, dead_tuples);
+  AnalyzeTable(table_name, {});
+  return true;
 }
 
-void DatabaseEngine::Vacuum(const VacuumStatement &stmt, ResultWriter &writer) {
-  // LAB 1 ADVANCED BEGIN
-  WriteOneCell("Vacuum", writer);
+bool DatabaseEngine::NeedsAutoVacuum(const TableModificationStats &stats) const {
+  uint64_t dead = stats.n_dead_tup_;
+  uint64_t total = dead + stats.GetLiveTuples();
+  return dead > autovacuum_threshold_ && dead * 100 >= autovacuum_dead_percent_ * total;
+}
+
+void DatabaseEngine::ShowBufferStats(ResultWriter &writer) const {
+  auto buffer_stats = buffer_pool_->GetStats();
+  auto disk_stats = disk_->GetStats();
+  std::vector<std::pair<std::string, uint64_t>> stats = {
+      {"hit_count", buffer_stats.hit_count_},
+      {"miss_count", buffer_stats.miss_count_},
+      {"eviction_count", buffer_stats.eviction_count_},
+      {"dirty_flush_count", buffer_stats.dirty_flush_count_},
+      {"prefetch_count", buffer_stats.prefetch_count_},
+      {"bgwriter_flush_count", buffer_stats.bgwriter_flush_count_},
+      {"read_count", disk_stats.read_count_},
+      {"read_bytes", disk_stats.read_bytes_},
+      {"read_time_us", disk_stats.read_time_ns_ / 1000},
+      {"write_count", disk_stats.write_count_},
+      {"write_bytes", disk_stats.write_bytes_},
+      {"write_time_us", disk_stats.write_time_ns_ / 1000},
+      {"compressed_write_count", disk_stats.compressed_write_count_},
+      {"compressed_write_bytes", disk_stats.compressed_write_bytes_},
+  };
+  writer.BeginTable();
+  writer.BeginHeader();
+  writer.WriteHeaderCell("name");
+  writer.WriteHeaderCell("value");
+  writer.EndHeader();
+  for (const auto &[name, value] : stats) {
+    writer.BeginRow();
+    writer.WriteCell(name);
+    writer.WriteCell(std::to_string(value));
+    writer.EndRow();
+  }
+  writer.EndTable();
+  writer.WriteRowCount(stats.size());
+}
+
+void DatabaseEngine::ShowBufferStrategyStats(ResultWriter &writer) const {
+  writer.BeginTable();
+  writer.BeginHeader();
+  writer.WriteHeaderCell("strategy");
+  writer.WriteHeaderCell("hit_count");
+  writer.WriteHeaderCell("miss_count");
+  writer.WriteHeaderCell("eviction_count");
+  writer.EndHeader();
+  size_t row_count = 0;
+  for (const auto &[type, stats] : buffer_pool_->GetStrategyStats()) {
+    writer.BeginRow();
+    writer.WriteCell(BufferStrategyType2String(type));
+    writer.WriteCell(std::to_string(stats.hit_count_));
+    writer.WriteCell(std::to_string(stats.miss_count_));
+    writer.WriteCell(std::to_string(stats.eviction_count_));
+    writer.EndRow();
+    row_count++;
+  }
+  writer.EndTable();
+  writer.WriteRowCount(row_count);
+}
+
+void DatabaseEngine::ShowQueryMemoryStats(const Connection &connection, ResultWriter &writer) const {
+  ArenaStats arena_stats;
+  if (query_memory_stats_.find(&connection) != query_memory_stats_.end()) {
+    arena_stats = query_memory_stats_.at(&connection);
+  }
+  std::vector<std::pair<std::string, uint64_t>> stats = {
+      {"allocation_count", arena_stats.allocation_count_},
+      {"allocated_bytes", arena_stats.allocated_bytes_},
+      {"peak_bytes", arena_stats.peak_bytes_},
+      {"reserved_bytes", arena_stats.reserved_bytes_},
+  };
+  writer.BeginTable();
+  writer.BeginHeader();
+  writer.WriteHeaderCell("name");
+  writer.WriteHeaderCell("value");
+  writer.EndHeader();
+  for (const auto &[name, value] : stats) {
+    writer.BeginRow();
+    writer.WriteCell(name);
+    writer.WriteCell(std::to_string(value));
+    writer.EndRow();
+  }
+  writer.EndTable();
+  writer.WriteRowCount(stats.size());
+}
+
+void DatabaseEngine::ShowTableStats(ResultWriter &writer) const {
+  writer.BeginTable();
+  writer.BeginHeader();
+  writer.WriteHeaderCell("table_name");
+  writer.WriteHeaderCell("n_tup_ins");
+  writer.WriteHeaderCell("n_tup_upd");
+  writer.WriteHeaderCell("n_tup_del");
+  writer.WriteHeaderCell("n_live_tup");
+  writer.WriteHeaderCell("n_dead_tup");
+  writer.EndHeader();
+  size_t table_count = 0;
+  for (const auto &table_name : catalog_->GetTableNames()) {
+    auto stats = catalog_->GetTableModificationStats(catalog_->GetTableOid(table_name));
+    writer.BeginRow();
+    writer.WriteCell(table_name);
+    writer.WriteCell(std::to_string(stats.n_tup_ins_));
+    writer.WriteCell(std::to_string(stats.n_tup_upd_));
+    writer.WriteCell(std::to_string(stats.n_tup_del_));
+    writer.WriteCell(std::to_string(stats.GetLiveTuples()));
+    writer.WriteCell(std::to_string(stats.n_dead_tup_));
+    writer.EndRow();
+    table_count++;
+  }
+  writer.EndTable();
+  writer.WriteRowCount(table_count);
 }
 
 void DatabaseEngine::WriteOneCell(const std::string &str, ResultWriter &writer) const {
@@ -676,6 +1144,35 @@ DeadlockType DatabaseEngine::String2DeadlockType(const std::string &str) {
   }
 }
 
+BufferStrategyType DatabaseEngine::String2BufferStrategyType(const std::string &str) {
+  if (str == "lru") {
+    return BufferStrategyType::LRU;
+  } else if (str == "lru2") {
+    return BufferStrategyType::LRU_K;
+  } else if (str == "2q") {
+    return BufferStrategyType::TWO_QUEUE;
+  } else if (str == "clock") {
+    return BufferStrategyType::CLOCK;
+  } else {
+    throw DbException("Unknown buffer strategy " + str);
+  }
+}
+
+std::string DatabaseEngine::BufferStrategyType2String(BufferStrategyType type) {
+  switch (type) {
+    case BufferStrategyType::LRU:
+      return "lru";
+    case BufferStrategyType::LRU_K:
+      return "lru2";
+    case BufferStrategyType::TWO_QUEUE:
+      return "2q";
+    case BufferStrategyType::CLOCK:
+      return "clock";
+    default:
+      throw DbException("Unknown buffer strategy type");
+  }
+}
+
 bool DatabaseEngine::String2Bool(const std::string &str) {
   if (str == "true" || str == "1" || str == "on") {
     return true;
@@ -685,4 +1182,15 @@ bool DatabaseEngine::String2Bool(const std::string &str) {
   throw DbException("Unknown boolean value " + str);
 }
 
+size_t DatabaseEngine::String2Size(const std::string &str, bool allow_zero) {
+  if (str.empty() || str.size() > 18 || str.find_first_not_of("0123456789") != std::string::npos) {
+    throw DbException("Invalid size value " + str);
+  }
+  auto size = std::stoull(str);
+  if (size == 0 && !allow_zero) {
+    throw DbException("Invalid size value " + str);
+  }
+  return size;
+}
+
 }  // namespace huadb
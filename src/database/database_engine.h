@@ -1,18 +1,23 @@
 #pragma once
 
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "catalog/catalog.h"
 #include "catalog/column_definition.h"
+#include "common/arena.h"
+#include "common/constants.h"
 #include "common/types.h"
+#include "database/autovacuum.h"
 #include "log/log_manager.h"
 #include "optimizer/optimizer.h"
 #include "planner/planner.h"
 #include "storage/buffer_pool.h"
 #include "storage/disk.h"
+#include "table/table.h"
 #include "transaction/lock_manager.h"
 #include "transaction/transaction_manager.h"
 
@@ -22,14 +27,17 @@ class Connection;
 class ResultWriter;
 class ExplainStatement;
 class LockStatement;
+class CopyStatement;
 class VariableSetStatement;
 class VariableShowStatement;
 class AnalyzeStatement;
 class VacuumStatement;
+class ColumnValue;
 
 class DatabaseEngine {
  public:
-  DatabaseEngine();
+  // page_size 仅在新建数据库时生效，已有数据库使用控制文件中记录的页面大小
+  explicit DatabaseEngine(size_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE, size_t page_size = DEFAULT_DB_PAGE_SIZE);
   ~DatabaseEngine();
 
   const std::string &GetCurrentDatabase() const;
@@ -52,30 +60,52 @@ class DatabaseEngine {
   void ChangeDatabase(const std::string &db_name, ResultWriter &writer);
   void DropDatabase(const std::string &db_name, bool missing_ok, ResultWriter &writer);
   void CloseDatabase();
+  // 写控制文件：下一个事务 id，lsn，oid，是否正常关闭，控制文件版本，页面大小
+  void WriteControl(xid_t xid, lsn_t lsn, oid_t oid, bool normal_shutdown) const;
 
-  void CreateTable(const std::string &table_name, const ColumnList &column_list, ResultWriter &writer);
+  void CreateTable(const std::string &table_name, const ColumnList &column_list, TableLayout layout,
+                   CompressionType compression, ResultWriter &writer);
   void DescribeTable(const std::string &table_name, ResultWriter &writer) const;
   void ShowTables(ResultWriter &writer) const;
   void DropTable(const std::string &table_name, ResultWriter &writer);
 
   void CreateIndex(const std::string &index_name, const std::string &table_name,
-                   const std::vector<std::string> &column_names, ResultWriter &writer);
-  void DropIndex(const std::string &index_name, ResultWriter &writer);
+                   const std::vector<std::string> &column_names, IndexType index_type,
+                   const std::vector<std::string> &include_column_names, ResultWriter &writer);
+  void DropIndex(const std::string &index_name, bool missing_ok, ResultWriter &writer);
+  // 清理回收记录时删除表上所有索引中对应的索引项，表上没有索引时返回空
+  TupleVisitor GetIndexEntryRemover(oid_t table_oid, xid_t xid) const;
 
   void Begin(const Connection &connection);
   void Commit(const Connection &connection);
+  void RollbackTransaction(const Connection &connection);
 
   void Checkpoint();
   void Recover();
 
-  void Explain(const ExplainStatement &stmt, ResultWriter &writer);
+  void Explain(const Connection &connection, const ExplainStatement &stmt, ResultWriter &writer);
   void Lock(xid_t xid, const LockStatement &stmt, ResultWriter &writer);
+  // 从 CSV 文件批量导入记录，输出导入的记录数
+  void Copy(xid_t xid, cid_t cid, const CopyStatement &stmt, ResultWriter &writer);
 
   void VariableSet(const Connection &connection, const VariableSetStatement &stmt, ResultWriter &writer);
   void VariableShow(const Connection &connection, const VariableShowStatement &stmt, ResultWriter &writer) const;
 
   void Analyze(const AnalyzeStatement &stmt, ResultWriter &writer);
-  void Vacuum(const VacuumStatement &stmt, ResultWriter &writer);
+  // 收集表的统计信息，columns 为空时收集所有列
+  void AnalyzeTable(const std::string &table_name, std::vector<ColumnValue> columns);
+  void Vacuum(xid_t xid, const VacuumStatement &stmt, ResultWriter &writer);
+
+  // 自动清理进程的一轮检查，清理并分析失效版本比例超过阈值的表
+  void AutoVacuumTables(AutoVacuum &autovacuum);
+  // 分批清理一张表，返回 false 表示自动清理进程需要停止
+  bool AutoVacuumTable(AutoVacuum &autovacuum, const std::string &table_name, oid_t oid);
+  bool NeedsAutoVacuum(const TableModificationStats &stats) const;
+
+  void ShowBufferStats(ResultWriter &writer) const;
+  void ShowBufferStrategyStats(ResultWriter &writer) const;
+  void ShowQueryMemoryStats(const Connection &connection, ResultWriter &writer) const;
+  void ShowTableStats(ResultWriter &writer) const;
 
   void WriteOneCell(const std::string &str, ResultWriter &writer) const;
 
@@ -83,7 +113,10 @@ class DatabaseEngine {
   static ForceJoin String2ForceJoin(const std::string &str);
   static JoinOrderAlgorithm String2JoinOrderAlgorithm(const std::string &str);
   static DeadlockType String2DeadlockType(const std::string &str);
+  static BufferStrategyType String2BufferStrategyType(const std::string &str);
+  static std::string BufferStrategyType2String(BufferStrategyType type);
   static bool String2Bool(const std::string &str);
+  static size_t String2Size(const std::string &str, bool allow_zero = false);
 
   std::string current_db_;
 
@@ -98,12 +131,24 @@ class DatabaseEngine {
   std::unordered_map<const Connection *, xid_t> xids_;
   std::unordered_map<const Connection *, IsolationLevel> isolation_levels_;
   std::unordered_set<const Connection *> auto_transaction_set_;
+  // 各连接上一条执行器查询的内存区统计
+  std::unordered_map<const Connection *, ArenaStats> query_memory_stats_;
 
   ForceJoin force_join_ = ForceJoin::NONE;
   JoinOrderAlgorithm join_order_algorithm_ = DEFAULT_JOIN_ORDER_ALGORITHM;
   bool enable_optimizer_ = true;
   bool enable_projection_pushdown_ = false;
 
+  // 语句执行时持有共享锁，自动清理每个批次持有排他锁
+  std::shared_mutex statement_mutex_;
+  size_t autovacuum_naptime_ = DEFAULT_AUTOVACUUM_NAPTIME_MS;
+  size_t autovacuum_threshold_ = DEFAULT_AUTOVACUUM_THRESHOLD;
+  size_t autovacuum_dead_percent_ = DEFAULT_AUTOVACUUM_DEAD_PERCENT;
+  size_t autovacuum_batch_pages_ = DEFAULT_AUTOVACUUM_BATCH_PAGES;
+  size_t autovacuum_batch_delay_ = DEFAULT_AUTOVACUUM_BATCH_DELAY_MS;
+  // 需在其访问的组件之前析构
+  std::unique_ptr<AutoVacuum> autovacuum_;
+
   bool crashed_ = false;
 };
 
@@ -35,6 +35,7 @@ std::shared_ptr<Record> DeleteExecutor::Next() {
 
     count++;
   }
+  context_.GetCatalog().CountTableModifications(table_->GetOid(), 0, 0, count);
   finished_ = true;
   return std::make_shared<Record>(std::vector{Value(count)});
 }
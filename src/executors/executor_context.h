@@ -1,11 +1,26 @@
 #pragma once
 
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+
 #include "catalog/catalog.h"
+#include "common/arena.h"
+#include "common/constants.h"
+#include "table/record.h"
+#include "table/table_scan.h"
 #include "transaction/lock_manager.h"
 #include "transaction/transaction_manager.h"
 
 namespace huadb {
 
+// 索引扫描统计
+struct IndexScanStats {
+  uint64_t heap_fetches_ = 0;          // 到表中取回记录的索引项数
+  uint64_t heap_fetches_avoided_ = 0;  // 仅索引扫描中页面全部可见，直接由索引项构造记录的索引项数
+};
+
 class ExecutorContext {
  public:
   ExecutorContext(BufferPool &buffer_pool, Catalog &catalog, TransactionManager &transaction_manager,
@@ -18,7 +33,8 @@ class ExecutorContext {
         xid_(xid),
         isolation_level_(isolation_level),
         cid_(cid),
-        is_modification_sql_(is_modification_sql) {}
+        is_modification_sql_(is_modification_sql),
+        arena_(ARENA_BLOCK_SIZE) {}
 
   BufferPool &GetBufferPool() const { return buffer_pool_; }
   Catalog &GetCatalog() const { return catalog_; }
@@ -29,6 +45,26 @@ class ExecutorContext {
   cid_t GetCid() const { return cid_; }
   bool IsModificationSql() const { return is_modification_sql_; }
 
+  // 查询内存区，查询结束时随上下文一起释放
+  // 执行器树和执行器返回的记录需要在上下文之前析构
+  std::pmr::memory_resource *GetMemoryResource() { return &arena_; }
+  ArenaStats GetArenaStats() const { return arena_.GetStats(); }
+  // 在查询内存区中创建记录，args 为 Record 带分配器的构造函数中分配器之后的参数
+  template <typename... Args>
+  std::shared_ptr<Record> MakeRecord(Args &&...args) {
+    return std::allocate_shared<Record>(std::pmr::polymorphic_allocator<Record>(&arena_), std::forward<Args>(args)...);
+  }
+  // 登记一个顺序扫描，返回的统计由扫描累加，EXPLAIN ANALYZE 时输出
+  TableScanStats &AddScanStats(std::string table_name) {
+    return scan_stats_.emplace_back(std::move(table_name), TableScanStats()).second;
+  }
+  const std::deque<std::pair<std::string, TableScanStats>> &GetScanStats() const { return scan_stats_; }
+  // 登记一个索引扫描，统计访问表和避免访问表的索引项数
+  IndexScanStats &AddIndexScanStats(std::string table_name) {
+    return index_scan_stats_.emplace_back(std::move(table_name), IndexScanStats()).second;
+  }
+  const std::deque<std::pair<std::string, IndexScanStats>> &GetIndexScanStats() const { return index_scan_stats_; }
+
  private:
   BufferPool &buffer_pool_;
   Catalog &catalog_;
@@ -38,6 +74,9 @@ class ExecutorContext {
   IsolationLevel isolation_level_;
   cid_t cid_;
   bool is_modification_sql_;
+  Arena arena_;
+  std::deque<std::pair<std::string, TableScanStats>> scan_stats_;  // deque 扩展时不移动已有元素
+  std::deque<std::pair<std::string, IndexScanStats>> index_scan_stats_;
 };
 
 }  // namespace huadb
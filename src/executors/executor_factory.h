@@ -9,6 +9,7 @@
 #include "executors/executor_factory.h"
 #include "executors/filter_executor.h"
 #include "executors/hash_join_executor.h"
+#include "executors/index_scan_executor.h"
 #include "executors/insert_executor.h"
 #include "executors/limit_executor.h"
 #include "executors/lock_rows_executor.h"
@@ -19,6 +20,7 @@
 #include "executors/seqscan_executor.h"
 #include "executors/update_executor.h"
 #include "executors/values_executor.h"
+#include "operators/expressions/logic.h"
 
 namespace huadb {
 
@@ -30,6 +32,10 @@ class ExecutorFactory {
         auto seqscan_operator = std::dynamic_pointer_cast<const SeqScanOperator>(plan);
         return std::make_unique<SeqScanExecutor>(context, std::move(seqscan_operator));
       }
+      case OperatorType::INDEXSCAN: {
+        auto index_scan_operator = std::dynamic_pointer_cast<const IndexScanOperator>(plan);
+        return std::make_unique<IndexScanExecutor>(context, std::move(index_scan_operator));
+      }
       case OperatorType::INSERT: {
         auto insert_operator = std::dynamic_pointer_cast<const InsertOperator>(plan);
         auto child = CreateExecutor(context, plan->GetChildren()[0]);
@@ -77,6 +83,24 @@ class ExecutorFactory {
       }
       case OperatorType::FILTER: {
         auto filter_operator = std::dynamic_pointer_cast<const FilterOperator>(plan);
+        // 顺序扫描上的过滤条件下推到扫描中，在页面上求值，不满足条件的记录无需物化
+        // 谓词拆分后扫描上方可能有多个连续的 Filter 节点，合并为 AND 一起下推，区域映射表可利用所有条件
+        auto predicate = filter_operator->predicate_;
+        auto scan_child = plan->GetChildren()[0];
+        while (scan_child->GetType() == OperatorType::FILTER) {
+          auto child_filter = std::dynamic_pointer_cast<const FilterOperator>(scan_child);
+          predicate = std::make_shared<Logic>(LogicType::AND, std::move(predicate), child_filter->predicate_);
+          scan_child = scan_child->GetChildren()[0];
+        }
+        if (scan_child->GetType() == OperatorType::SEQSCAN) {
+          auto seqscan_operator = std::dynamic_pointer_cast<const SeqScanOperator>(scan_child);
+          return std::make_unique<SeqScanExecutor>(context, std::move(seqscan_operator), std::move(predicate));
+        }
+        // 索引扫描只按索引键的范围定位记录，所有过滤条件仍在取回的记录上检查
+        if (scan_child->GetType() == OperatorType::INDEXSCAN) {
+          auto index_scan_operator = std::dynamic_pointer_cast<const IndexScanOperator>(scan_child);
+          return std::make_unique<IndexScanExecutor>(context, std::move(index_scan_operator), std::move(predicate));
+        }
         auto child = CreateExecutor(context, plan->GetChildren()[0]);
         return std::make_unique<FilterExecutor>(context, std::move(filter_operator), std::move(child));
       }
@@ -0,0 +1,82 @@
+#include "executors/index_scan_executor.h"
+
+namespace huadb {
+
+IndexScanExecutor::IndexScanExecutor(ExecutorContext &context, std::shared_ptr<const IndexScanOperator> plan,
+                                     std::shared_ptr<OperatorExpression> predicate)
+    : Executor(context, {}), plan_(std::move(plan)), predicate_(std::move(predicate)) {}
+
+void IndexScanExecutor::Init() {
+  auto &catalog = context_.GetCatalog();
+  table_ = catalog.GetTable(plan_->GetTableOid());
+  auto index = catalog.GetIndex(plan_->GetIndexOid());
+  entries_ = index->Scan(plan_->GetRange());
+  key_columns_ = index->GetKeyColumns();
+  include_columns_ = index->GetIncludeColumns();
+  cursor_ = 0;
+  scan_ = std::make_unique<TableScan>(context_.GetBufferPool(), table_, Rid{table_->GetFirstPageId(), 0});
+  scan_->SetMemoryResource(context_.GetMemoryResource());
+  scan_->SetProjection(plan_->GetProjection());
+  if (stats_ == nullptr) {
+    stats_ = &context_.AddIndexScanStats(plan_->GetTableNameOrAlias());
+  }
+}
+
+std::shared_ptr<Record> IndexScanExecutor::Next() {
+  std::unordered_set<xid_t> active_xids;
+  auto xid = context_.GetXid();
+  auto cid = context_.GetCid();
+  auto isolation_level = context_.GetIsolationLevel();
+  auto &transaction_manager = context_.GetTransactionManager();
+  if (isolation_level == IsolationLevel::REPEATABLE_READ || isolation_level == IsolationLevel::SERIALIZABLE) {
+    active_xids = transaction_manager.GetSnapshot(xid);
+  } else if (isolation_level == IsolationLevel::READ_COMMITTED) {
+    active_xids = transaction_manager.GetActiveTransactions();
+  }
+  if (!context_.GetLockManager().LockTable(xid, LockType::IS, plan_->GetTableOid())) {
+    throw DbException("Failed to acquire IS lock on the table");
+  }
+
+  TupleFilter filter;
+  if (predicate_ != nullptr) {
+    filter = [this](const TupleView &tuple) {
+      auto value = predicate_->EvaluateTuple(tuple);
+      return !value.IsNull() && value.GetValue<bool>();
+    };
+  }
+  // 同一记录的多个版本各有一个索引项，至多一个版本可见，逐个取回直到找到可见且满足条件的记录
+  while (cursor_ < entries_.size()) {
+    const auto &entry = entries_[cursor_++];
+    // 全部可见的页面中的记录对所有事务可见，仅索引扫描无需到表中判断可见性
+    if (plan_->IsIndexOnly() && table_->GetVisibilityMap().IsAllVisible(entry.rid_.page_id_)) {
+      stats_->heap_fetches_avoided_++;
+      auto record = MakeIndexRecord(entry);
+      if (predicate_ != nullptr) {
+        auto value = predicate_->Evaluate(record);
+        if (value.IsNull() || !value.GetValue<bool>()) {
+          continue;
+        }
+      }
+      return record;
+    }
+    stats_->heap_fetches_++;
+    auto record = scan_->FetchRecord(entry.rid_, xid, isolation_level, cid, active_xids, filter);
+    if (record != nullptr) {
+      return record;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<Record> IndexScanExecutor::MakeIndexRecord(const IndexEntry &entry) {
+  std::pmr::vector<Value> values(table_->GetColumnList().Length(), context_.GetMemoryResource());
+  for (size_t i = 0; i < key_columns_.size(); i++) {
+    values[key_columns_[i].col_idx_] = entry.key_[i];
+  }
+  for (size_t i = 0; i < include_columns_.size(); i++) {
+    values[include_columns_[i].col_idx_] = entry.include_[i];
+  }
+  return context_.MakeRecord(std::move(values), entry.rid_);
+}
+
+}  // namespace huadb
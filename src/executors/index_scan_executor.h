@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include "executors/executor.h"
+#include "operators/expressions/expression.h"
+#include "operators/index_scan_operator.h"
+#include "table/table_scan.h"
+
+namespace huadb {
+
+class IndexScanExecutor : public Executor {
+ public:
+  // predicate: 上方 Filter 中的过滤条件，在取回的记录上重新检查，索引范围之外的条件也由其判断
+  IndexScanExecutor(ExecutorContext &context, std::shared_ptr<const IndexScanOperator> plan,
+                    std::shared_ptr<OperatorExpression> predicate = nullptr);
+
+  void Init() override;
+  std::shared_ptr<Record> Next() override;
+
+ private:
+  // 仅索引扫描时由索引项构造记录，只有键列和附加列有值，其余列为空值
+  std::shared_ptr<Record> MakeIndexRecord(const IndexEntry &entry);
+
+  std::shared_ptr<const IndexScanOperator> plan_;
+  std::shared_ptr<OperatorExpression> predicate_;
+  std::shared_ptr<Table> table_;
+  std::unique_ptr<TableScan> scan_;
+  std::vector<IndexEntry> entries_;  // 索引返回的记录版本，逐个到表中判断可见性
+  size_t cursor_ = 0;
+  std::vector<IndexColumn> key_columns_;
+  std::vector<IndexColumn> include_columns_;
+  IndexScanStats *stats_ = nullptr;  // 多次 Init 时累加到同一项统计
+};
+
+}  // namespace huadb
@@ -9,6 +9,7 @@ InsertExecutor::InsertExecutor(ExecutorContext &context, std::shared_ptr<const I
 void InsertExecutor::Init() {
   children_[0]->Init();
   table_ = context_.GetCatalog().GetTable(plan_->GetTableOid());
+  indexes_ = context_.GetCatalog().GetTableIndexes(plan_->GetTableOid());
   column_list_ = context_.GetCatalog().GetTableColumnList(plan_->GetTableOid());
 }
 
@@ -35,12 +36,17 @@ std::shared_ptr<Record> InsertExecutor::Next() {
     if (!lock_mgr.LockTable(transaction_id, LockType::IX, object_id)) {
         throw DbException("Failed to acquire IX lock on the table for insertion");
     }
-    auto record_id = table_->InsertRecord(std::move(table_record), context_.GetXid(), context_.GetCid(), true);
+    auto record_id = table_->InsertRecord(table_record, context_.GetXid(), context_.GetCid(), true);
     if (!lock_mgr.LockRow(transaction_id, LockType::X, object_id, record_id)) {
         throw DbException("Failed to acquire X lock on the row for insertion");
     }
+    for (const auto &index : indexes_) {
+      index->InsertEntry(index->GetKey(*table_record), index->GetIncludeValues(*table_record), record_id,
+                         context_.GetXid(), true);
+    }
     count++;
   }
+  context_.GetCatalog().CountTableModifications(table_->GetOid(), count, 0, 0);
   finished_ = true;
   return std::make_shared<Record>(std::vector{Value(count)});
 }
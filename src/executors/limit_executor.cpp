@@ -22,8 +22,7 @@ std::shared_ptr<Record> LimitExecutor::Next() {
     }
     offset_ = 0;
 
-    // Initialize a new record
-    std::shared_ptr<Record> result_record = std::make_shared<Record>();
+    std::shared_ptr<Record> result_record;
     
     // Handle different count cases
     if (count_ == 0) {
@@ -26,8 +26,7 @@ std::shared_ptr<Record> MergeJoinExecutor::Next() {
 
     while (!last_match_.empty()) {
         if (index_ < last_match_.size()) {
-            std::shared_ptr<Record> join_result = std::make_shared<Record>(*r_record_);
-            join_result->Append(*last_match_[index_]);
+            std::shared_ptr<Record> join_result = context_.MakeRecord(*r_record_, *last_match_[index_]);
             index_++;
             return join_result;
         }
@@ -62,8 +61,7 @@ std::shared_ptr<Record> MergeJoinExecutor::Next() {
         // For non-duplicate tuples in R and S, simply add (r,s) to result
         // For duplicated tuples in R and S, find all matching tuple pairs
         if (left_value.Equal(right_value)) {
-            std::shared_ptr<Record> join_result = std::make_shared<Record>(*r_record_);
-            join_result->Append(*s_record_);
+            std::shared_ptr<Record> join_result = context_.MakeRecord(*r_record_, *s_record_);
 
             last_match_.emplace_back(s_record_);
             s_record_ = children_[1]->Next();
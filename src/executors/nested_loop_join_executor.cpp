@@ -65,8 +65,7 @@ std::shared_ptr<Record> NestedLoopJoinExecutor::Next() {
                   // Check if the join condition is satisfied
                   if (condition->EvaluateJoin(r_record_, s_record_).GetValue<bool>()) {
                       // Create result record by combining left and right records
-                      std::shared_ptr<Record> joinResult = std::make_shared<Record>(*r_record_);
-                      joinResult->Append(*s_record_);
+                      std::shared_ptr<Record> joinResult = context_.MakeRecord(*r_record_, *s_record_);
 
                       // Get next right record for next iteration
                       s_record_ = children_[1]->Next();
@@ -101,8 +100,7 @@ std::shared_ptr<Record> NestedLoopJoinExecutor::Next() {
               while (s_record_) {
                   if (condition->EvaluateJoin(r_record_, s_record_).GetValue<bool>()) {
                       // Create joined record
-                      std::shared_ptr<Record> joinResult = std::make_shared<Record>(*r_record_);
-                      joinResult->Append(*s_record_);
+                      std::shared_ptr<Record> joinResult = context_.MakeRecord(*r_record_, *s_record_);
 
                       // Mark this left record as already joined
                       r_table_[r_index_].second = true;
@@ -123,10 +121,9 @@ std::shared_ptr<Record> NestedLoopJoinExecutor::Next() {
 
               // If no match was found and right table has columns, output left with nulls
               if (!r_table_[r_index_].second && s_value_size_ > 0) {
-                  std::shared_ptr<Record> nullExtendedResult = std::make_shared<Record>(*r_record_);
                   // Create null values for right side
                   std::vector<Value> nullValues(s_value_size_, Value());
-                  nullExtendedResult->Append(Record(nullValues));
+                  std::shared_ptr<Record> nullExtendedResult = context_.MakeRecord(*r_record_, Record(nullValues));
 
                   r_record_ = children_[0]->Next();
                   ++r_index_;
@@ -151,8 +148,7 @@ std::shared_ptr<Record> NestedLoopJoinExecutor::Next() {
                       if (!s_table_[s_index_].second) {
                           // Create NULL values for left side
                           std::vector<Value> nullValues(r_value_size_, Value());
-                          std::shared_ptr<Record> outerJoinResult = std::make_shared<Record>(Record(nullValues));
-                          outerJoinResult->Append(*s_record_);
+                          std::shared_ptr<Record> outerJoinResult = context_.MakeRecord(Record(nullValues), *s_record_);
 
                           // Copy the first value from right side (might need to adjust based on your schema)
                           outerJoinResult->SetValue(0, s_record_->GetValue(0));
@@ -174,8 +170,7 @@ std::shared_ptr<Record> NestedLoopJoinExecutor::Next() {
               while (s_record_) {
                   if (condition->EvaluateJoin(r_record_, s_record_).GetValue<bool>()) {
                       // Create result by joining left and right records
-                      std::shared_ptr<Record> joinedResult = std::make_shared<Record>(*r_record_);
-                      joinedResult->Append(*s_record_);
+                      std::shared_ptr<Record> joinedResult = context_.MakeRecord(*r_record_, *s_record_);
 
                       // Mark this right record as matched
                       s_table_[s_index_].second = true;
@@ -209,8 +204,8 @@ std::shared_ptr<Record> NestedLoopJoinExecutor::Next() {
                       if (!s_table_[s_index_].second) {
                           // Create result with NULL values for left side
                           std::vector<Value> nullLeftValues(r_value_size_, Value());
-                          std::shared_ptr<Record> outerJoinResult = std::make_shared<Record>(Record(nullLeftValues));
-                          outerJoinResult->Append(*s_record_);
+                          std::shared_ptr<Record> outerJoinResult =
+                              context_.MakeRecord(Record(nullLeftValues), *s_record_);
 
                           // Copy necessary values from right record
                           outerJoinResult->SetValue(0, s_record_->GetValue(0));
@@ -236,8 +231,7 @@ std::shared_ptr<Record> NestedLoopJoinExecutor::Next() {
               while (s_record_) {
                   if (condition->EvaluateJoin(r_record_, s_record_).GetValue<bool>()) {
                       // Create result by combining both records
-                      std::shared_ptr<Record> combinedRecord = std::make_shared<Record>(*r_record_);
-                      combinedRecord->Append(*s_record_);
+                      std::shared_ptr<Record> combinedRecord = context_.MakeRecord(*r_record_, *s_record_);
 
                       // Mark both records as matched
                       r_table_[r_index_].second = true;
@@ -261,9 +255,8 @@ std::shared_ptr<Record> NestedLoopJoinExecutor::Next() {
 
               // If no match was found, output left record with NULL right values
               if (!r_table_[r_index_].second && s_value_size_ > 0) {
-                  std::shared_ptr<Record> leftOuterResult = std::make_shared<Record>(*r_record_);
                   std::vector<Value> nullRightValues(s_value_size_, Value());
-                  leftOuterResult->Append(Record(nullRightValues));
+                  std::shared_ptr<Record> leftOuterResult = context_.MakeRecord(*r_record_, Record(nullRightValues));
 
                   // Advance to next left record
                   r_record_ = children_[0]->Next();
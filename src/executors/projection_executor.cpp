@@ -13,11 +13,12 @@ std::shared_ptr<Record> ProjectionExecutor::Next() {
   if (!record) {
     return nullptr;
   }
-  std::vector<Value> values;
+  std::pmr::vector<Value> values(context_.GetMemoryResource());
+  values.reserve(plan_->exprs_.size());
   for (const auto &expr : plan_->exprs_) {
     values.push_back(expr->Evaluate(record));
   }
-  return std::make_unique<Record>(std::move(values), record->GetRid());
+  return context_.MakeRecord(std::move(values), record->GetRid());
 }
 
 }  // namespace huadb
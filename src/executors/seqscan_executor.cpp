@@ -1,13 +1,31 @@
 #include "executors/seqscan_executor.h"
 
+#include "operators/expressions/column_value.h"
+#include "operators/expressions/comparison.h"
+#include "operators/expressions/const.h"
+#include "operators/expressions/logic.h"
+
 namespace huadb {
 
-SeqScanExecutor::SeqScanExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan)
-    : Executor(context, {}), plan_(std::move(plan)) {}
+SeqScanExecutor::SeqScanExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan,
+                                 std::shared_ptr<OperatorExpression> predicate)
+    : Executor(context, {}), plan_(std::move(plan)), predicate_(std::move(predicate)) {}
 
 void SeqScanExecutor::Init() {
   auto table = context_.GetCatalog().GetTable(plan_->GetTableOid());
   scan_ = std::make_unique<TableScan>(context_.GetBufferPool(), table, Rid{table->GetFirstPageId(), 0});
+  scan_->EnableReadAhead();
+  scan_->SetMemoryResource(context_.GetMemoryResource());
+  scan_->SetProjection(plan_->GetProjection());
+  if (predicate_ != nullptr) {
+    std::vector<ZoneCondition> conditions;
+    CollectZoneConditions(predicate_, conditions);
+    scan_->SetZoneConditions(std::move(conditions));
+  }
+  if (stats_ == nullptr) {
+    stats_ = &context_.AddScanStats(plan_->GetTableNameOrAlias());
+  }
+  scan_->SetStats(stats_);
 }
 
 std::shared_ptr<Record> SeqScanExecutor::Next() {
@@ -31,7 +49,14 @@ std::shared_ptr<Record> SeqScanExecutor::Next() {
   }
 
   auto table = context_.GetCatalog().GetTable(plan_->GetTableOid());
-  auto record = scan_->GetNextRecord(transaction_id, isolation_level, client_id, active_xids);
+  TupleFilter filter;
+  if (predicate_ != nullptr) {
+    filter = [this](const TupleView &tuple) {
+      auto value = predicate_->EvaluateTuple(tuple);
+      return !value.IsNull() && value.GetValue<bool>();
+    };
+  }
+  auto record = scan_->GetNextRecord(transaction_id, isolation_level, client_id, active_xids, filter);
   auto object_id = table->GetOid();
   auto &lock_mgr = context_.GetLockManager();
 
@@ -42,4 +67,64 @@ std::shared_ptr<Record> SeqScanExecutor::Next() {
   return record;
 }
 
+void SeqScanExecutor::CollectZoneConditions(const std::shared_ptr<OperatorExpression> &expr,
+                                            std::vector<ZoneCondition> &conditions) const {
+  if (expr->GetExprType() == OperatorExpressionType::LOGIC) {
+    auto logic = std::dynamic_pointer_cast<Logic>(expr);
+    if (logic->GetLogicType() == LogicType::AND) {
+      CollectZoneConditions(logic->children_[0], conditions);
+      CollectZoneConditions(logic->children_[1], conditions);
+    }
+    return;
+  }
+  if (expr->GetExprType() != OperatorExpressionType::COMPARISON) {
+    return;
+  }
+  auto comparison = std::dynamic_pointer_cast<Comparison>(expr);
+  auto lhs = comparison->children_[0];
+  auto rhs = comparison->children_[1];
+  // 常量在左侧时交换两侧，比较方向随之翻转
+  bool swapped = false;
+  if (lhs->GetExprType() == OperatorExpressionType::CONST &&
+      rhs->GetExprType() == OperatorExpressionType::COLUMN_VALUE) {
+    std::swap(lhs, rhs);
+    swapped = true;
+  }
+  if (lhs->GetExprType() != OperatorExpressionType::COLUMN_VALUE ||
+      rhs->GetExprType() != OperatorExpressionType::CONST) {
+    return;
+  }
+  auto col_idx = std::dynamic_pointer_cast<ColumnValue>(lhs)->GetColumnIndex();
+  const auto &value = std::dynamic_pointer_cast<Const>(rhs)->value_;
+  const auto &column_list = context_.GetCatalog().GetTable(plan_->GetTableOid())->GetColumnList();
+  if (col_idx >= column_list.Length() || !ZoneMap::IsTracked(column_list.GetColumn(col_idx).type_) ||
+      value.IsNull() || !ZoneMap::IsTracked(value.GetType())) {
+    return;
+  }
+  ZoneCompareType type;
+  switch (comparison->GetComparisonType()) {
+    case ComparisonType::EQUAL:
+      type = ZoneCompareType::EQUAL;
+      break;
+    case ComparisonType::NOT_EQUAL:
+      type = ZoneCompareType::NOT_EQUAL;
+      break;
+    case ComparisonType::LESS:
+      type = swapped ? ZoneCompareType::GREATER : ZoneCompareType::LESS;
+      break;
+    case ComparisonType::LESS_EQUAL:
+      type = swapped ? ZoneCompareType::GREATER_EQUAL : ZoneCompareType::LESS_EQUAL;
+      break;
+    case ComparisonType::GREATER:
+      type = swapped ? ZoneCompareType::LESS : ZoneCompareType::GREATER;
+      break;
+    case ComparisonType::GREATER_EQUAL:
+      type = swapped ? ZoneCompareType::LESS_EQUAL : ZoneCompareType::GREATER_EQUAL;
+      break;
+    default:
+      return;
+  }
+  conditions.push_back({col_idx, type, ZoneMap::ToDouble(value)});
+}
+
 }  // namespace huadb
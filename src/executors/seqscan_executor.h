@@ -1,20 +1,29 @@
 #pragma once
 
 #include "executors/executor.h"
+#include "operators/expressions/expression.h"
 #include "operators/seqscan_operator.h"
 
 namespace huadb {
 
 class SeqScanExecutor : public Executor {
  public:
-  SeqScanExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan);
+  // predicate: 下推的过滤条件，直接在页面中的记录上求值，只物化满足条件的记录
+  SeqScanExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan,
+                  std::shared_ptr<OperatorExpression> predicate = nullptr);
 
   void Init() override;
   std::shared_ptr<Record> Next() override;
 
  private:
   std::shared_ptr<const SeqScanOperator> plan_;
+  std::shared_ptr<OperatorExpression> predicate_;
   std::unique_ptr<TableScan> scan_;
+  TableScanStats *stats_ = nullptr;  // 多次 Init 时累加到同一项统计
+
+  // 从过滤条件中提取区域映射表可判断的条件，只提取 AND 连接的列与常量的比较
+  void CollectZoneConditions(const std::shared_ptr<OperatorExpression> &expr,
+                             std::vector<ZoneCondition> &conditions) const;
 };
 
 }  // namespace huadb
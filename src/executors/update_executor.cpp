@@ -9,6 +9,7 @@ UpdateExecutor::UpdateExecutor(ExecutorContext &context, std::shared_ptr<const U
 void UpdateExecutor::Init() {
   children_[0]->Init();
   table_ = context_.GetCatalog().GetTable(plan_->GetTableOid());
+  indexes_ = context_.GetCatalog().GetTableIndexes(plan_->GetTableOid());
 }
 
 std::shared_ptr<Record> UpdateExecutor::Next() {
@@ -42,9 +43,15 @@ std::shared_ptr<Record> UpdateExecutor::Next() {
     if (!lock_mgr.LockRow(transaction_id, LockType::X, object_id, record->GetRid())) {
         throw DbException("Failed to acquire X lock on the row for update");
     }
+    // 新版本位于新的 rid，旧版本的索引项保留到清理时删除
+    for (const auto &index : indexes_) {
+      index->InsertEntry(index->GetKey(*new_record), index->GetIncludeValues(*new_record), record_id, context_.GetXid(),
+                         true);
+    }
 
     count++;
   }
+  context_.GetCatalog().CountTableModifications(table_->GetOid(), 0, count, 0);
   finished_ = true;
   return std::make_shared<Record>(std::vector{Value(count)});
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "executors/executor.h"
+#include "index/index.h"
 #include "operators/update_operator.h"
 
 namespace huadb {
@@ -15,6 +16,7 @@ class UpdateExecutor : public Executor {
  private:
   std::shared_ptr<const UpdateOperator> plan_;
   std::shared_ptr<Table> table_;
+  std::vector<std::shared_ptr<Index>> indexes_;  // 表上的索引，新版本需插入索引项
   bool finished_ = false;
 };
 
@@ -0,0 +1,457 @@
+#include "index/b_plus_tree.h"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <thread>
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+// 元信息页面：page_lsn(8) + root_page_id(4) + page_count(4)，page_lsn 与 IndexPage 位于相同位置
+static constexpr pageid_t META_PAGE_ID = 0;
+static constexpr size_t META_ROOT_OFFSET = sizeof(lsn_t);
+static constexpr size_t META_PAGE_COUNT_OFFSET = META_ROOT_OFFSET + sizeof(pageid_t);
+// 索引项中 rid 占用的字节数
+static constexpr db_size_t RID_SIZE = sizeof(pageid_t) + sizeof(slotid_t);
+// 节点至少容纳的索引项数，保证分裂后两侧节点均不为空
+static constexpr db_size_t MIN_NODE_CAPACITY = 3;
+// 节点乐观锁按块分配，索引最多包含 LATCH_CHUNK_SIZE * LATCH_CHUNK_COUNT 个页面
+static constexpr size_t LATCH_CHUNK_SIZE = 4096;
+static constexpr size_t LATCH_CHUNK_COUNT = 16384;
+
+static int CompareRids(Rid left, Rid right) {
+  if (left.page_id_ != right.page_id_) {
+    return left.page_id_ < right.page_id_ ? -1 : 1;
+  }
+  if (left.slot_id_ != right.slot_id_) {
+    return left.slot_id_ < right.slot_id_ ? -1 : 1;
+  }
+  return 0;
+}
+
+// 读取的节点被修改或正被写锁定，重试前让出处理器
+static void Backoff() { std::this_thread::yield(); }
+
+// 本次修改持有的写锁，离开作用域时释放
+class WriteLatches {
+ public:
+  ~WriteLatches() {
+    for (auto *latch : latches_) {
+      latch->WriteUnlock();
+    }
+  }
+  // 版本号未变化时加写锁，失败时已加的写锁在析构时释放
+  bool Upgrade(OptimisticLatch &latch, uint64_t version) {
+    if (!latch.Upgrade(version)) {
+      return false;
+    }
+    latches_.push_back(&latch);
+    return true;
+  }
+
+ private:
+  std::vector<OptimisticLatch *> latches_;
+};
+
+BPlusTree::BPlusTree(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, oid_t table_oid,
+                     std::vector<IndexColumn> key_columns, std::vector<IndexColumn> include_columns,
+                     bool new_index)
+    : Index(buffer_pool, log_manager, oid, db_oid, table_oid, std::move(key_columns), std::move(include_columns)),
+      latch_chunks_(std::make_unique<std::atomic<OptimisticLatch *>[]>(LATCH_CHUNK_COUNT)) {
+  CheckKeySize(key_columns_, include_columns_, buffer_pool_.GetPageSize());
+  leaf_entry_size_ = key_size_ + RID_SIZE + include_size_;
+  internal_entry_size_ = key_size_ + RID_SIZE + sizeof(pageid_t);
+  leaf_capacity_ = IndexPage::GetCapacity(buffer_pool_.GetPageSize(), leaf_entry_size_);
+  internal_capacity_ = IndexPage::GetCapacity(buffer_pool_.GetPageSize(), internal_entry_size_);
+  if (new_index) {
+    std::call_once(meta_loaded_, [this]() {
+      auto meta_page = buffer_pool_.NewPage(db_oid_, oid_, META_PAGE_ID);
+      memset(meta_page->GetData(), 0, meta_page->GetPageSize());
+      page_count_ = META_PAGE_ID + 1;
+      pageid_t root_page_id;
+      AllocatePage(0, root_page_id, NULL_XID, false);
+      SetRootPageId(root_page_id, NULL_XID, false);
+    });
+  }
+}
+
+BPlusTree::~BPlusTree() {
+  for (size_t i = 0; i < LATCH_CHUNK_COUNT; i++) {
+    delete[] latch_chunks_[i].load();
+  }
+}
+
+void BPlusTree::InsertEntry(const IndexKey &key, const std::vector<Value> &include, Rid rid, xid_t xid,
+                            bool write_log) {
+  if (key.front().IsNull()) {
+    return;
+  }
+  std::call_once(meta_loaded_, &BPlusTree::LoadMetaPage, this);
+  std::vector<char> entry(leaf_entry_size_);
+  WriteEntry(entry.data(), key, rid);
+  SerializeValues(include, include_columns_, entry.data() + key_size_ + RID_SIZE);
+  while (!TryInsertEntry(key, rid, entry, xid, write_log)) {
+    Backoff();
+  }
+}
+
+void BPlusTree::DeleteEntry(const IndexKey &key, Rid rid, xid_t xid) {
+  if (key.front().IsNull()) {
+    return;
+  }
+  std::call_once(meta_loaded_, &BPlusTree::LoadMetaPage, this);
+  while (!TryDeleteEntry(key, rid, xid)) {
+    Backoff();
+  }
+}
+
+std::vector<IndexEntry> BPlusTree::Scan(const IndexRange &range) {
+  std::call_once(meta_loaded_, &BPlusTree::LoadMetaPage, this);
+  std::vector<IndexEntry> result;
+  uint64_t root_version;
+  std::vector<NodeVersion> path;
+  // rid {0, 0} 不大于任何 rid，从具有下界前缀的第一项所在的叶节点开始
+  while (!FindLeaf(range.lower_ ? &*range.lower_ : nullptr, {0, 0}, root_version, path)) {
+    Backoff();
+  }
+  auto [page_id, version] = path.back();
+  // 已返回的最后一个索引项，叶节点读取期间被修改时重新读取，跳过已返回的索引项
+  // 分裂只会将索引项移到右侧的新节点，重新读取的节点之后仍可沿链表到达这些索引项
+  std::optional<IndexKey> last_key;
+  Rid last_rid;
+  while (page_id != NULL_PAGE_ID) {
+    IndexPage leaf(GetPage(page_id));
+    std::vector<IndexEntry> entries;
+    bool finished = false;
+    auto count = GetEntryCount(leaf, leaf_entry_size_);
+    for (db_size_t pos = 0; pos < count; pos++) {
+      auto entry = leaf.GetEntry(pos, leaf_entry_size_);
+      auto key = DeserializeKey(entry);
+      if (!range.AboveLower(key) || (last_key && CompareEntry(entry, *last_key, last_rid) <= 0)) {
+        continue;
+      }
+      if (!range.BelowUpper(key)) {
+        finished = true;
+        break;
+      }
+      entries.push_back(
+          {std::move(key), DeserializeValues(entry + key_size_ + RID_SIZE, include_columns_), GetEntryRid(entry)});
+    }
+    auto next_page_id = leaf.GetNextPageId();
+    if (!GetLatch(page_id).Validate(version)) {
+      do {
+        Backoff();
+      } while (!GetLatch(page_id).ReadLock(version));
+      continue;
+    }
+    if (!entries.empty()) {
+      last_key = entries.back().key_;
+      last_rid = entries.back().rid_;
+    }
+    result.insert(result.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+    if (finished) {
+      break;
+    }
+    page_id = next_page_id;
+    while (page_id != NULL_PAGE_ID && !GetLatch(page_id).ReadLock(version)) {
+      Backoff();
+    }
+  }
+  return result;
+}
+
+bool BPlusTree::TryInsertEntry(const IndexKey &key, Rid rid, const std::vector<char> &leaf_entry, xid_t xid,
+                               bool write_log) {
+  uint64_t root_version;
+  std::vector<NodeVersion> path;
+  if (!FindLeaf(&key, rid, root_version, path)) {
+    return false;
+  }
+  auto page_id = path.back().page_id_;
+  auto page = GetPage(page_id);
+  auto pos = SearchEntry(IndexPage(page), key, rid, leaf_entry_size_, false);
+  // 从叶节点向上，已满的节点都需要分裂，分隔项插入第一个未满的祖先节点，所有节点都满时根节点分裂
+  // top 为需要修改的最上层节点在 path 中的下标，节点内容未经校验，加写锁成功时才说明读取的内容有效
+  size_t top = path.size() - 1;
+  bool split_root = false;
+  if (GetEntryCount(IndexPage(page), leaf_entry_size_) >= leaf_capacity_) {
+    while (true) {
+      if (top == 0) {
+        split_root = true;
+        break;
+      }
+      top--;
+      if (GetEntryCount(IndexPage(GetPage(path[top].page_id_)), internal_entry_size_) < internal_capacity_) {
+        break;
+      }
+    }
+  }
+  WriteLatches latches;
+  if (split_root && !latches.Upgrade(root_latch_, root_version)) {
+    return false;
+  }
+  for (size_t i = top; i < path.size(); i++) {
+    if (!latches.Upgrade(GetLatch(path[i].page_id_), path[i].version_)) {
+      return false;
+    }
+  }
+
+  {
+    IndexPage leaf(page);
+    if (pos < leaf.GetEntryCount() && CompareEntry(leaf.GetEntry(pos, leaf_entry_size_), key, rid) == 0) {
+      return true;
+    }
+    if (leaf.GetEntryCount() < leaf_capacity_) {
+      leaf.InsertEntry(pos, leaf_entry.data(), leaf_entry_size_);
+      if (write_log) {
+        leaf.SetPageLSN(log_manager_.AppendIndexInsertLog(xid, oid_, page_id, pos, leaf_entry));
+      }
+      return true;
+    }
+  }
+
+  // 节点已满，分裂为两个节点，并将新节点的第一项插入父节点，父节点已满时继续向上分裂
+  // 每个页面修改完成后立即记录日志，不再持有，避免分裂时同时固定过多页面
+  auto entry = leaf_entry;
+  db_size_t entry_size = leaf_entry_size_;
+  db_size_t capacity = leaf_capacity_;
+  auto depth = path.size() - 1;
+  while (true) {
+    IndexPage node(page);
+    if (node.GetEntryCount() < capacity) {
+      node.InsertEntry(pos, entry.data(), entry_size);
+      LogPage(page_id, page, xid, write_log);
+      break;
+    }
+    db_size_t count = node.GetEntryCount() + 1;
+    std::vector<char> entries(count * entry_size);
+    memcpy(entries.data(), node.GetEntry(0, entry_size), pos * entry_size);
+    memcpy(entries.data() + pos * entry_size, entry.data(), entry_size);
+    memcpy(entries.data() + (pos + 1) * entry_size, node.GetEntry(pos, entry_size), (count - pos - 1) * entry_size);
+    db_size_t left_count = count / 2;
+    const char *middle = entries.data() + left_count * entry_size;
+    // 父节点中的新索引项以 middle 的键和 rid 为前缀，不包含附加列
+    std::vector<char> separator(middle, middle + key_size_ + RID_SIZE);
+
+    // 新节点在链入树之前写好内容，读者只能在其父节点或左侧节点的写锁释放后到达
+    pageid_t new_page_id;
+    {
+      auto new_page = AllocatePage(node.GetLevel(), new_page_id, xid, write_log);
+      IndexPage new_node(new_page);
+      node.SetEntries(entries.data(), left_count, entry_size);
+      if (node.IsLeaf()) {
+        new_node.SetEntries(middle, count - left_count, entry_size);
+        new_node.SetNextPageId(node.GetNextPageId());
+        node.SetNextPageId(new_page_id);
+      } else {
+        // 内部节点的中间项移到父节点，其子节点成为新节点的最左侧子节点
+        new_node.SetNextPageId(GetEntryChild(middle));
+        new_node.SetEntries(middle + entry_size, count - left_count - 1, entry_size);
+      }
+      LogPage(new_page_id, new_page, xid, write_log);
+    }
+    LogPage(page_id, page, xid, write_log);
+
+    entry_size = internal_entry_size_;
+    capacity = internal_capacity_;
+    entry = separator;
+    entry.resize(entry_size);
+    memcpy(entry.data() + key_size_ + RID_SIZE, &new_page_id, sizeof(new_page_id));
+    if (depth == 0) {
+      // 根节点分裂，创建新的根节点
+      auto level = node.GetLevel() + 1;
+      pageid_t root_page_id;
+      auto root_page = AllocatePage(level, root_page_id, xid, write_log);
+      IndexPage root(root_page);
+      root.SetNextPageId(page_id);
+      root.InsertEntry(0, entry.data(), entry_size);
+      LogPage(root_page_id, root_page, xid, write_log);
+      SetRootPageId(root_page_id, xid, write_log);
+      break;
+    }
+    page_id = path[--depth].page_id_;
+    page = GetPage(page_id);
+    pos = SearchEntry(IndexPage(page), DeserializeKey(separator.data()), GetEntryRid(separator.data()), entry_size,
+                      false);
+  }
+  return true;
+}
+
+bool BPlusTree::TryDeleteEntry(const IndexKey &key, Rid rid, xid_t xid) {
+  uint64_t root_version;
+  std::vector<NodeVersion> path;
+  if (!FindLeaf(&key, rid, root_version, path)) {
+    return false;
+  }
+  auto [page_id, version] = path.back();
+  IndexPage leaf(GetPage(page_id));
+  auto pos = SearchEntry(leaf, key, rid, leaf_entry_size_, false);
+  WriteLatches latches;
+  if (!latches.Upgrade(GetLatch(page_id), version)) {
+    return false;
+  }
+  if (pos == leaf.GetEntryCount() || CompareEntry(leaf.GetEntry(pos, leaf_entry_size_), key, rid) != 0) {
+    return true;
+  }
+  leaf.DeleteEntry(pos, leaf_entry_size_);
+  leaf.SetPageLSN(log_manager_.AppendIndexDeleteLog(xid, oid_, page_id, pos, leaf_entry_size_));
+  return true;
+}
+
+IndexType BPlusTree::GetIndexType() const { return IndexType::BTREE; }
+
+void BPlusTree::CheckKeySize(const std::vector<IndexColumn> &key_columns,
+                             const std::vector<IndexColumn> &include_columns, size_t page_size) {
+  auto key_size = GetColumnsSize(key_columns) + RID_SIZE;
+  auto leaf_entry_size = key_size + GetColumnsSize(include_columns);
+  auto internal_entry_size = key_size + sizeof(pageid_t);
+  if (IndexPage::GetCapacity(page_size, leaf_entry_size) < MIN_NODE_CAPACITY ||
+      IndexPage::GetCapacity(page_size, internal_entry_size) < MIN_NODE_CAPACITY) {
+    throw DbException("Index key too large for page size " + std::to_string(page_size));
+  }
+}
+
+bool BPlusTree::FindLeaf(const IndexKey *key, Rid rid, uint64_t &root_version, std::vector<NodeVersion> &path) {
+  path.clear();
+  if (!root_latch_.ReadLock(root_version)) {
+    return false;
+  }
+  pageid_t page_id = root_page_id_;
+  uint64_t version;
+  if (!IsNodePage(page_id) || !GetLatch(page_id).ReadLock(version) || !root_latch_.Validate(root_version)) {
+    return false;
+  }
+  while (true) {
+    path.push_back({page_id, version});
+    IndexPage node(GetPage(page_id));
+    if (node.IsLeaf()) {
+      return true;
+    }
+    db_size_t pos = key == nullptr ? 0 : SearchEntry(node, *key, rid, internal_entry_size_, true);
+    auto child = pos == 0 ? node.GetNextPageId() : GetEntryChild(node.GetEntry(pos - 1, internal_entry_size_));
+    // 先读取子节点的版本号再校验父节点，父节点校验通过时子节点尚未分裂，仍包含 (key, rid)
+    uint64_t child_version;
+    if (!IsNodePage(child) || !GetLatch(child).ReadLock(child_version) || !GetLatch(page_id).Validate(version)) {
+      return false;
+    }
+    page_id = child;
+    version = child_version;
+  }
+}
+
+db_size_t BPlusTree::SearchEntry(const IndexPage &page, const IndexKey &key, Rid rid, db_size_t entry_size,
+                                 bool upper) const {
+  db_size_t low = 0;
+  db_size_t high = GetEntryCount(page, entry_size);
+  while (low < high) {
+    db_size_t mid = (low + high) / 2;
+    auto result = CompareEntry(page.GetEntry(mid, entry_size), key, rid);
+    if (result < 0 || (upper && result == 0)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+int BPlusTree::CompareEntry(const char *entry, const IndexKey &key, Rid rid) const {
+  auto result = CompareKeys(DeserializeKey(entry), key);
+  if (result != 0) {
+    return result;
+  }
+  return CompareRids(GetEntryRid(entry), rid);
+}
+
+void BPlusTree::WriteEntry(char *entry, const IndexKey &key, Rid rid) const {
+  SerializeKey(key, entry);
+  memcpy(entry + key_size_, &rid.page_id_, sizeof(rid.page_id_));
+  memcpy(entry + key_size_ + sizeof(rid.page_id_), &rid.slot_id_, sizeof(rid.slot_id_));
+}
+
+Rid BPlusTree::GetEntryRid(const char *entry) const {
+  Rid rid;
+  memcpy(&rid.page_id_, entry + key_size_, sizeof(rid.page_id_));
+  memcpy(&rid.slot_id_, entry + key_size_ + sizeof(rid.page_id_), sizeof(rid.slot_id_));
+  return rid;
+}
+
+pageid_t BPlusTree::GetEntryChild(const char *entry) const {
+  pageid_t child;
+  memcpy(&child, entry + key_size_ + RID_SIZE, sizeof(child));
+  return child;
+}
+
+db_size_t BPlusTree::GetEntryCount(const IndexPage &page, db_size_t entry_size) const {
+  return std::min(page.GetEntryCount(), entry_size == leaf_entry_size_ ? leaf_capacity_ : internal_capacity_);
+}
+
+std::shared_ptr<Page> BPlusTree::GetPage(pageid_t page_id) { return buffer_pool_.GetPage(db_oid_, oid_, page_id); }
+
+void BPlusTree::LogPage(pageid_t page_id, const std::shared_ptr<Page> &page, xid_t xid, bool write_log) {
+  if (!write_log) {
+    return;
+  }
+  std::vector<char> page_data(page->GetData(), page->GetData() + page->GetPageSize());
+  IndexPage(page).SetPageLSN(log_manager_.AppendIndexPageLog(xid, oid_, page_id, std::move(page_data)));
+}
+
+std::shared_ptr<Page> BPlusTree::AllocatePage(db_size_t level, pageid_t &page_id, xid_t xid, bool write_log) {
+  {
+    std::scoped_lock lock(meta_mutex_);
+    page_id = page_count_;
+    if (page_id >= LATCH_CHUNK_SIZE * LATCH_CHUNK_COUNT) {
+      throw DbException("Index exceeds the maximum number of pages");
+    }
+    pageid_t page_count = page_id + 1;
+    page_count_ = page_count;
+    auto meta_page = GetPage(META_PAGE_ID);
+    memcpy(meta_page->GetData() + META_PAGE_COUNT_OFFSET, &page_count, sizeof(page_count));
+    meta_page->SetDirty();
+    // 在新页面的日志之前记录页面数，重做时不会出现超出页面数的节点；持有锁以使并发分裂按顺序记录
+    LogPage(META_PAGE_ID, meta_page, xid, write_log);
+  }
+  auto page = buffer_pool_.NewPage(db_oid_, oid_, page_id);
+  memset(page->GetData(), 0, page->GetPageSize());
+  IndexPage(page).Init(level);
+  return page;
+}
+
+bool BPlusTree::IsNodePage(pageid_t page_id) const { return page_id != META_PAGE_ID && page_id < page_count_; }
+
+void BPlusTree::SetRootPageId(pageid_t root_page_id, xid_t xid, bool write_log) {
+  std::scoped_lock lock(meta_mutex_);
+  root_page_id_ = root_page_id;
+  auto meta_page = GetPage(META_PAGE_ID);
+  memcpy(meta_page->GetData() + META_ROOT_OFFSET, &root_page_id, sizeof(root_page_id));
+  meta_page->SetDirty();
+  LogPage(META_PAGE_ID, meta_page, xid, write_log);
+}
+
+void BPlusTree::LoadMetaPage() {
+  auto meta_page = GetPage(META_PAGE_ID);
+  pageid_t root_page_id;
+  pageid_t page_count;
+  memcpy(&root_page_id, meta_page->GetData() + META_ROOT_OFFSET, sizeof(root_page_id));
+  memcpy(&page_count, meta_page->GetData() + META_PAGE_COUNT_OFFSET, sizeof(page_count));
+  root_page_id_ = root_page_id;
+  page_count_ = page_count;
+}
+
+OptimisticLatch &BPlusTree::GetLatch(pageid_t page_id) {
+  auto &chunk_entry = latch_chunks_[page_id / LATCH_CHUNK_SIZE];
+  auto *chunk = chunk_entry.load(std::memory_order_acquire);
+  if (chunk == nullptr) {
+    std::scoped_lock lock(latch_chunks_mutex_);
+    chunk = chunk_entry.load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+      chunk = new OptimisticLatch[LATCH_CHUNK_SIZE];
+      chunk_entry.store(chunk, std::memory_order_release);
+    }
+  }
+  return chunk[page_id % LATCH_CHUNK_SIZE];
+}
+
+}  // namespace huadb
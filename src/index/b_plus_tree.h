@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "index/index.h"
+#include "index/index_page.h"
+#include "index/optimistic_latch.h"
+
+namespace huadb {
+
+// B+ 树索引，0 号页面为元信息页面，保存根节点的页面号和已分配的页面数，其余页面为 IndexPage 格式的树节点
+// 叶节点的索引项为 键 + rid + 附加列，内部节点的索引项为 键 + rid + 子节点页面号，索引项按 (键, rid) 排序，键可以重复
+// 内部节点第 i 项的子树中的索引项不小于第 i 项且小于第 i + 1 项，小于第 0 项的索引项位于最左侧子节点中
+// 删除索引项后不合并节点，空的叶节点保留在树中
+// 只修改一个叶节点时记录插入或删除的索引项，节点分裂时记录所有修改页面的完整内容
+// 并发控制采用乐观锁耦合：每个节点有一个乐观锁，下降时不加锁，只记录并校验版本号，
+// 插入和删除只对叶节点加写锁，节点分裂时对分裂路径上的所有节点加写锁，加锁失败时从根节点重新开始
+class BPlusTree : public Index {
+ public:
+  // new_index 为 true 时初始化元信息页面和空的根节点
+  BPlusTree(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, oid_t table_oid,
+            std::vector<IndexColumn> key_columns, std::vector<IndexColumn> include_columns, bool new_index);
+  ~BPlusTree() override;
+
+  void InsertEntry(const IndexKey &key, const std::vector<Value> &include, Rid rid, xid_t xid,
+                   bool write_log) override;
+  void DeleteEntry(const IndexKey &key, Rid rid, xid_t xid) override;
+  std::vector<IndexEntry> Scan(const IndexRange &range) override;
+
+  IndexType GetIndexType() const override;
+
+  // 检查页面能否容纳足够的索引项，键或附加列过长时抛出异常
+  static void CheckKeySize(const std::vector<IndexColumn> &key_columns, const std::vector<IndexColumn> &include_columns,
+                           size_t page_size);
+
+ private:
+  // 下降时经过的节点及读取时的版本号
+  struct NodeVersion {
+    pageid_t page_id_;
+    uint64_t version_;
+  };
+
+  // 一次插入或删除尝试，节点在读取之后被修改时返回 false，调用者重试
+  bool TryInsertEntry(const IndexKey &key, Rid rid, const std::vector<char> &leaf_entry, xid_t xid, bool write_log);
+  bool TryDeleteEntry(const IndexKey &key, Rid rid, xid_t xid);
+
+  // 从根节点乐观地下降到 (key, rid) 所在的叶节点，key 为空时下降到最左侧的叶节点
+  // key 为键的前缀时下降到第一个具有该前缀的索引项所在的叶节点
+  // path 记录从根节点到叶节点经过的所有节点，root_version 为根节点指针的版本号，读取期间树被修改时返回 false
+  // 叶节点的版本号已读取但尚未校验，调用者读取叶节点后需自行校验
+  bool FindLeaf(const IndexKey *key, Rid rid, uint64_t &root_version, std::vector<NodeVersion> &path);
+  // 节点中第一个不小于 (key, rid) 的索引项的位置，upper 为 true 时为第一个大于 (key, rid) 的位置
+  db_size_t SearchEntry(const IndexPage &page, const IndexKey &key, Rid rid, db_size_t entry_size, bool upper) const;
+  // 比较索引项与 (key, rid)，返回负数、0 或正数
+  int CompareEntry(const char *entry, const IndexKey &key, Rid rid) const;
+  // 节点中的索引项数，乐观读取时可能读到写入中的值，不超过节点容量
+  db_size_t GetEntryCount(const IndexPage &page, db_size_t entry_size) const;
+
+  // 写入和读取索引项中的各个部分，叶节点和内部节点的索引项均以 键 + rid 为前缀
+  void WriteEntry(char *entry, const IndexKey &key, Rid rid) const;
+  Rid GetEntryRid(const char *entry) const;
+  pageid_t GetEntryChild(const char *entry) const;
+
+  std::shared_ptr<Page> GetPage(pageid_t page_id);
+  // write_log 为 true 时记录页面的完整内容
+  void LogPage(pageid_t page_id, const std::shared_ptr<Page> &page, xid_t xid, bool write_log);
+  // 分配新页面并初始化为 level 层的节点，元信息页面在新页面之前记录日志
+  std::shared_ptr<Page> AllocatePage(db_size_t level, pageid_t &page_id, xid_t xid, bool write_log);
+  // 页面号是否为已分配的树节点，用于排除乐观读取时读到的无效子节点
+  bool IsNodePage(pageid_t page_id) const;
+  // 修改根节点页面号并写入元信息页面，新的根节点页面须已记录日志
+  void SetRootPageId(pageid_t root_page_id, xid_t xid, bool write_log);
+  // 从元信息页面读取根节点页面号和页面数
+  void LoadMetaPage();
+
+  // 节点的乐观锁，按页面号分块，块在首次访问时创建
+  OptimisticLatch &GetLatch(pageid_t page_id);
+
+  db_size_t leaf_entry_size_;
+  db_size_t internal_entry_size_;
+  db_size_t leaf_capacity_;
+  db_size_t internal_capacity_;
+
+  // 元信息页面的内容在首次访问索引时读取，恢复时重做日志可能修改元信息页面，此时索引已经创建但尚未使用
+  std::once_flag meta_loaded_;
+  std::atomic<pageid_t> root_page_id_;
+  std::atomic<pageid_t> page_count_;
+  // 根节点指针的乐观锁，根节点分裂时加写锁
+  OptimisticLatch root_latch_;
+  // 保护元信息页面，分配页面、修改根节点和记录元信息页面日志时持有
+  std::mutex meta_mutex_;
+  std::unique_ptr<std::atomic<OptimisticLatch *>[]> latch_chunks_;
+  std::mutex latch_chunks_mutex_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,328 @@
+#include "index/hash_index.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+// 元信息页面：page_lsn(8) + bucket_count(4) + page_count(4) + group_start(4 * 32)，page_lsn 与 IndexPage 位于相同位置
+static constexpr pageid_t META_PAGE_ID = 0;
+static constexpr size_t META_BUCKET_COUNT_OFFSET = sizeof(lsn_t);
+static constexpr size_t META_PAGE_COUNT_OFFSET = META_BUCKET_COUNT_OFFSET + sizeof(uint32_t);
+static constexpr size_t META_GROUP_START_OFFSET = META_PAGE_COUNT_OFFSET + sizeof(pageid_t);
+// 索引项中 rid 占用的字节数
+static constexpr db_size_t RID_SIZE = sizeof(pageid_t) + sizeof(slotid_t);
+// 页面至少容纳的索引项数
+static constexpr db_size_t MIN_PAGE_CAPACITY = 2;
+
+// 桶所在的组，0 号桶为第 0 组，[2^(g-1), 2^g) 号桶为第 g 组
+static size_t GetBucketGroup(uint32_t bucket) {
+  size_t group = 0;
+  while (bucket != 0) {
+    bucket >>= 1;
+    group++;
+  }
+  return group;
+}
+
+// 组内第一个桶的桶号
+static uint32_t GetGroupFirstBucket(size_t group) { return group == 0 ? 0 : 1u << (group - 1); }
+
+HashIndex::HashIndex(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, oid_t table_oid,
+                     std::vector<IndexColumn> key_columns, bool new_index)
+    : Index(buffer_pool, log_manager, oid, db_oid, table_oid, std::move(key_columns), {}) {
+  CheckKeySize(key_columns_, buffer_pool_.GetPageSize());
+  entry_size_ = key_size_ + RID_SIZE;
+  capacity_ = IndexPage::GetCapacity(buffer_pool_.GetPageSize(), entry_size_);
+  if (new_index) {
+    std::call_once(meta_loaded_, [this]() {
+      auto meta_page = buffer_pool_.NewPage(db_oid_, oid_, META_PAGE_ID);
+      memset(meta_page->GetData(), 0, meta_page->GetPageSize());
+      bucket_count_ = 1;
+      group_start_[0] = META_PAGE_ID + 1;
+      page_count_ = group_start_[0] + 1;
+      auto bucket_page = buffer_pool_.NewPage(db_oid_, oid_, group_start_[0]);
+      memset(bucket_page->GetData(), 0, bucket_page->GetPageSize());
+      IndexPage(bucket_page).Init(0);
+      WriteMetaPage();
+    });
+  }
+}
+
+void HashIndex::InsertEntry(const IndexKey &key, const std::vector<Value> &include, Rid rid, xid_t xid,
+                            bool write_log) {
+  if (key.front().IsNull()) {
+    return;
+  }
+  std::call_once(meta_loaded_, &HashIndex::LoadMetaPage, this);
+  std::vector<char> entry(entry_size_);
+  WriteEntry(entry.data(), key, rid);
+  auto hash = HashKey(key);
+  bool split = false;
+  while (true) {
+    std::shared_lock lock(mutex_);
+    auto bucket = GetBucket(hash);
+    std::unique_lock bucket_lock(GetBucketLatch(bucket));
+    // 查找桶中第一个未满的页面，索引项已存在时直接返回，只记录页面号，避免同时固定多个页面
+    pageid_t free_page_id = NULL_PAGE_ID;
+    pageid_t last_page_id = NULL_PAGE_ID;
+    for (auto page_id = GetBucketPageId(bucket); page_id != NULL_PAGE_ID;) {
+      IndexPage bucket_page(GetPage(page_id));
+      for (db_size_t pos = 0; pos < bucket_page.GetEntryCount(); pos++) {
+        if (memcmp(bucket_page.GetEntry(pos, entry_size_), entry.data(), entry_size_) == 0) {
+          return;
+        }
+      }
+      if (free_page_id == NULL_PAGE_ID && bucket_page.GetEntryCount() < capacity_) {
+        free_page_id = page_id;
+      }
+      last_page_id = page_id;
+      page_id = bucket_page.GetNextPageId();
+    }
+    if (free_page_id != NULL_PAGE_ID) {
+      IndexPage bucket_page(GetPage(free_page_id));
+      auto pos = bucket_page.GetEntryCount();
+      bucket_page.InsertEntry(pos, entry.data(), entry_size_);
+      if (write_log) {
+        bucket_page.SetPageLSN(log_manager_.AppendIndexInsertLog(xid, oid_, free_page_id, pos, entry));
+      }
+      return;
+    }
+    // 桶已满，先分裂下一个桶，分裂后重新计算目标桶；桶数达到上限或分裂后仍满时追加溢出页面
+    if (!split && GetBucketGroup(bucket_count_) < MAX_BUCKET_GROUPS) {
+      split = true;
+      // 分裂需要排他锁，释放后重新加锁，期间其他线程可能已经分裂或插入，分裂后重新查找
+      bucket_lock.unlock();
+      lock.unlock();
+      std::unique_lock split_lock(mutex_);
+      if (GetBucketGroup(bucket_count_) < MAX_BUCKET_GROUPS) {
+        SplitBucket(xid, write_log);
+      }
+      continue;
+    }
+    pageid_t new_page_id;
+    {
+      std::scoped_lock allocate_lock(allocate_mutex_);
+      auto new_page = AllocatePage(new_page_id);
+      IndexPage(new_page).InsertEntry(0, entry.data(), entry_size_);
+      LogPage(new_page_id, new_page, xid, write_log);
+      LogPage(META_PAGE_ID, GetPage(META_PAGE_ID), xid, write_log);
+    }
+    auto last_page = GetPage(last_page_id);
+    IndexPage(last_page).SetNextPageId(new_page_id);
+    LogPage(last_page_id, last_page, xid, write_log);
+    return;
+  }
+}
+
+void HashIndex::DeleteEntry(const IndexKey &key, Rid rid, xid_t xid) {
+  if (key.front().IsNull()) {
+    return;
+  }
+  std::call_once(meta_loaded_, &HashIndex::LoadMetaPage, this);
+  std::vector<char> entry(entry_size_);
+  WriteEntry(entry.data(), key, rid);
+  auto hash = HashKey(key);
+  std::shared_lock lock(mutex_);
+  auto bucket = GetBucket(hash);
+  std::unique_lock bucket_lock(GetBucketLatch(bucket));
+  for (auto page_id = GetBucketPageId(bucket); page_id != NULL_PAGE_ID;) {
+    IndexPage bucket_page(GetPage(page_id));
+    for (db_size_t pos = 0; pos < bucket_page.GetEntryCount(); pos++) {
+      if (memcmp(bucket_page.GetEntry(pos, entry_size_), entry.data(), entry_size_) == 0) {
+        bucket_page.DeleteEntry(pos, entry_size_);
+        bucket_page.SetPageLSN(log_manager_.AppendIndexDeleteLog(xid, oid_, page_id, pos, entry_size_));
+        return;
+      }
+    }
+    page_id = bucket_page.GetNextPageId();
+  }
+}
+
+std::vector<IndexEntry> HashIndex::Scan(const IndexRange &range) {
+  if (!range.lower_ || !range.upper_ || !range.lower_inclusive_ || !range.upper_inclusive_ ||
+      range.lower_->size() != key_columns_.size() || range.upper_->size() != key_columns_.size() ||
+      CompareKeys(*range.lower_, *range.upper_) != 0) {
+    throw DbException("Hash index only supports equality lookups");
+  }
+  std::call_once(meta_loaded_, &HashIndex::LoadMetaPage, this);
+  const auto &key = *range.lower_;
+  std::vector<IndexEntry> entries;
+  if (key.front().IsNull()) {
+    return entries;
+  }
+  auto hash = HashKey(key);
+  std::shared_lock lock(mutex_);
+  auto bucket = GetBucket(hash);
+  std::shared_lock bucket_lock(GetBucketLatch(bucket));
+  for (auto page_id = GetBucketPageId(bucket); page_id != NULL_PAGE_ID;) {
+    IndexPage bucket_page(GetPage(page_id));
+    for (db_size_t pos = 0; pos < bucket_page.GetEntryCount(); pos++) {
+      auto entry = bucket_page.GetEntry(pos, entry_size_);
+      auto entry_key = DeserializeKey(entry);
+      if (CompareKeys(entry_key, key) == 0) {
+        entries.push_back({std::move(entry_key), {}, GetEntryRid(entry)});
+      }
+    }
+    page_id = bucket_page.GetNextPageId();
+  }
+  return entries;
+}
+
+IndexType HashIndex::GetIndexType() const { return IndexType::HASH; }
+
+void HashIndex::CheckKeySize(const std::vector<IndexColumn> &key_columns, size_t page_size) {
+  if (IndexPage::GetCapacity(page_size, GetColumnsSize(key_columns) + RID_SIZE) < MIN_PAGE_CAPACITY) {
+    throw DbException("Index key too large for page size " + std::to_string(page_size));
+  }
+}
+
+uint64_t HashIndex::HashKey(const IndexKey &key) const {
+  // 对键的定长序列化结果计算 FNV-1a 哈希，再混合高低位，线性哈希只使用低位
+  std::vector<char> data(key_size_);
+  auto normalized = key;
+  for (auto &value : normalized) {
+    if (!value.IsNull() && value.GetType() == Type::DOUBLE && value.GetValue<double>() == 0) {
+      // 0.0 与 -0.0 相等但序列化结果不同
+      value = Value(0.0);
+    }
+  }
+  SerializeKey(normalized, data.data());
+  uint64_t hash = 14695981039346656037ULL;
+  for (auto byte : data) {
+    hash ^= static_cast<uint8_t>(byte);
+    hash *= 1099511628211ULL;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+uint32_t HashIndex::GetBucket(uint64_t hash) const {
+  // 最后一个桶所在组决定哈希值使用的位数，超出桶数时少使用一位，对应的桶尚未分裂
+  uint64_t mask = (uint64_t(1) << GetBucketGroup(bucket_count_ - 1)) - 1;
+  uint32_t bucket = hash & mask;
+  if (bucket >= bucket_count_) {
+    bucket = hash & (mask >> 1);
+  }
+  return bucket;
+}
+
+pageid_t HashIndex::GetBucketPageId(uint32_t bucket) const {
+  auto group = GetBucketGroup(bucket);
+  return group_start_[group] + (bucket - GetGroupFirstBucket(group));
+}
+
+std::shared_mutex &HashIndex::GetBucketLatch(uint32_t bucket) { return bucket_latches_[bucket % BUCKET_LATCHES]; }
+
+void HashIndex::SplitBucket(xid_t xid, bool write_log) {
+  uint32_t new_bucket = bucket_count_;
+  auto group = GetBucketGroup(new_bucket);
+  if (new_bucket == GetGroupFirstBucket(group)) {
+    // 预留新组中所有桶的页面，桶页面在桶创建时写入
+    group_start_[group] = page_count_;
+    page_count_ += new_bucket;
+  }
+  // 新桶由低 group - 1 位相同的旧桶分裂得到，第 group - 1 位为 1 的索引项移入新桶
+  uint32_t old_bucket = new_bucket - GetGroupFirstBucket(group);
+  uint64_t mask = (uint64_t(1) << group) - 1;
+  std::vector<pageid_t> old_page_ids;
+  std::vector<char> old_entries;
+  std::vector<char> new_entries;
+  for (auto page_id = GetBucketPageId(old_bucket); page_id != NULL_PAGE_ID;) {
+    IndexPage bucket_page(GetPage(page_id));
+    for (db_size_t pos = 0; pos < bucket_page.GetEntryCount(); pos++) {
+      auto entry = bucket_page.GetEntry(pos, entry_size_);
+      auto &entries = (HashKey(DeserializeKey(entry)) & mask) == new_bucket ? new_entries : old_entries;
+      entries.insert(entries.end(), entry, entry + entry_size_);
+    }
+    old_page_ids.push_back(page_id);
+    page_id = bucket_page.GetNextPageId();
+  }
+  bucket_count_++;
+
+  auto new_page_id = GetBucketPageId(new_bucket);
+  {
+    auto new_page = buffer_pool_.NewPage(db_oid_, oid_, new_page_id);
+    memset(new_page->GetData(), 0, new_page->GetPageSize());
+    IndexPage(new_page).Init(0);
+  }
+  // 按 新桶、元信息页面、旧桶 的顺序记录日志，任意位置崩溃后重做，每个索引项都位于当前桶数下其所属的桶中：
+  // 元信息页面之前新桶尚不可见，之后旧桶中残留的索引项不会再被查找到；旧桶只会变小，不分配溢出页面
+  WriteChain({new_page_id}, new_entries, xid, write_log);
+  WriteMetaPage();
+  LogPage(META_PAGE_ID, GetPage(META_PAGE_ID), xid, write_log);
+  WriteChain(std::move(old_page_ids), old_entries, xid, write_log);
+}
+
+void HashIndex::WriteChain(std::vector<pageid_t> page_ids, const std::vector<char> &entries, xid_t xid,
+                           bool write_log) {
+  size_t count = entries.size() / entry_size_;
+  size_t written = 0;
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    auto page = GetPage(page_ids[i]);
+    IndexPage bucket_page(page);
+    auto page_count = static_cast<db_size_t>(std::min<size_t>(count - written, capacity_));
+    bucket_page.SetEntries(entries.data() + written * entry_size_, page_count, entry_size_);
+    written += page_count;
+    if (i + 1 == page_ids.size() && written < count) {
+      pageid_t next_page_id;
+      AllocatePage(next_page_id);
+      bucket_page.SetNextPageId(next_page_id);
+      page_ids.push_back(next_page_id);
+    }
+    LogPage(page_ids[i], page, xid, write_log);
+  }
+}
+
+void HashIndex::LogPage(pageid_t page_id, const std::shared_ptr<Page> &page, xid_t xid, bool write_log) {
+  if (!write_log) {
+    return;
+  }
+  std::vector<char> page_data(page->GetData(), page->GetData() + page->GetPageSize());
+  IndexPage(page).SetPageLSN(log_manager_.AppendIndexPageLog(xid, oid_, page_id, std::move(page_data)));
+}
+
+void HashIndex::WriteEntry(char *entry, const IndexKey &key, Rid rid) const {
+  SerializeKey(key, entry);
+  memcpy(entry + key_size_, &rid.page_id_, sizeof(rid.page_id_));
+  memcpy(entry + key_size_ + sizeof(rid.page_id_), &rid.slot_id_, sizeof(rid.slot_id_));
+}
+
+Rid HashIndex::GetEntryRid(const char *entry) const {
+  Rid rid;
+  memcpy(&rid.page_id_, entry + key_size_, sizeof(rid.page_id_));
+  memcpy(&rid.slot_id_, entry + key_size_ + sizeof(rid.page_id_), sizeof(rid.slot_id_));
+  return rid;
+}
+
+std::shared_ptr<Page> HashIndex::GetPage(pageid_t page_id) { return buffer_pool_.GetPage(db_oid_, oid_, page_id); }
+
+std::shared_ptr<Page> HashIndex::AllocatePage(pageid_t &page_id) {
+  page_id = page_count_++;
+  WriteMetaPage();
+  auto page = buffer_pool_.NewPage(db_oid_, oid_, page_id);
+  memset(page->GetData(), 0, page->GetPageSize());
+  IndexPage(page).Init(0);
+  return page;
+}
+
+void HashIndex::WriteMetaPage() {
+  auto meta_page = GetPage(META_PAGE_ID);
+  memcpy(meta_page->GetData() + META_BUCKET_COUNT_OFFSET, &bucket_count_, sizeof(bucket_count_));
+  memcpy(meta_page->GetData() + META_PAGE_COUNT_OFFSET, &page_count_, sizeof(page_count_));
+  memcpy(meta_page->GetData() + META_GROUP_START_OFFSET, group_start_.data(), sizeof(group_start_));
+  meta_page->SetDirty();
+}
+
+void HashIndex::LoadMetaPage() {
+  auto meta_page = GetPage(META_PAGE_ID);
+  memcpy(&bucket_count_, meta_page->GetData() + META_BUCKET_COUNT_OFFSET, sizeof(bucket_count_));
+  memcpy(&page_count_, meta_page->GetData() + META_PAGE_COUNT_OFFSET, sizeof(page_count_));
+  memcpy(group_start_.data(), meta_page->GetData() + META_GROUP_START_OFFSET, sizeof(group_start_));
+}
+
+}  // namespace huadb
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "index/index.h"
+#include "index/index_page.h"
+
+namespace huadb {
+
+// 线性哈希索引，0 号页面为元信息页面，保存桶数、已分配的页面数和每组桶的起始页面号
+// 桶按 2 的幂分组，第 0 组为 0 号桶，第 g 组为 [2^(g-1), 2^g) 号桶，一组桶的页面在创建组内第一个桶时连续预留
+// 桶页面和溢出页面均为 IndexPage 格式的叶节点，索引项为 键 + rid，页面内无序，next_page_id 指向下一个溢出页面
+// 插入时桶中所有页面均已满则分裂下一个桶，分裂后目标桶仍满时追加溢出页面，清空的溢出页面保留在链表中
+// 只修改一个页面时记录插入或删除的索引项，分裂和追加溢出页面时记录所有修改页面的完整内容
+// mutex_ 保护桶数和分组信息，查找、插入和删除持有共享锁，只有分裂持有排他锁
+// 桶内页面由桶锁保护，桶按桶号映射到固定数目的锁上，查找持有共享锁，插入和删除持有排他锁，不同桶的操作可以并发
+// 追加溢出页面时在 allocate_mutex_ 下分配页面号并修改元信息页面
+class HashIndex : public Index {
+ public:
+  // new_index 为 true 时初始化元信息页面和 0 号桶
+  HashIndex(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, oid_t table_oid,
+            std::vector<IndexColumn> key_columns, bool new_index);
+
+  // 哈希索引不保存附加列，include 被忽略
+  void InsertEntry(const IndexKey &key, const std::vector<Value> &include, Rid rid, xid_t xid,
+                   bool write_log) override;
+  void DeleteEntry(const IndexKey &key, Rid rid, xid_t xid) override;
+  // 只支持上下界相同、均包含且包含所有键列的等值查找，返回的索引项无序
+  std::vector<IndexEntry> Scan(const IndexRange &range) override;
+
+  IndexType GetIndexType() const override;
+
+  // 检查页面能否容纳足够的索引项，键过长时抛出异常
+  static void CheckKeySize(const std::vector<IndexColumn> &key_columns, size_t page_size);
+
+ private:
+  // 分组数，桶数不超过 2^(MAX_BUCKET_GROUPS - 1)
+  static constexpr size_t MAX_BUCKET_GROUPS = 32;
+  // 桶锁数目
+  static constexpr size_t BUCKET_LATCHES = 64;
+
+  // 键的哈希值，与进程和平台无关，保证重启后桶的位置不变
+  uint64_t HashKey(const IndexKey &key) const;
+  // 哈希值所在的桶号
+  uint32_t GetBucket(uint64_t hash) const;
+  pageid_t GetBucketPageId(uint32_t bucket) const;
+  std::shared_mutex &GetBucketLatch(uint32_t bucket);
+  // 分裂下一个桶，将其中一部分索引项移入新桶
+  void SplitBucket(xid_t xid, bool write_log);
+  // 将 entries 依次写入 page_ids 中的页面，页面不足时分配溢出页面并链接到最后一个页面之后
+  void WriteChain(std::vector<pageid_t> page_ids, const std::vector<char> &entries, xid_t xid, bool write_log);
+  // write_log 为 true 时记录页面的完整内容，分裂和追加溢出页面时每写完一个页面记录一次，避免同时固定多个页面
+  void LogPage(pageid_t page_id, const std::shared_ptr<Page> &page, xid_t xid, bool write_log);
+
+  void WriteEntry(char *entry, const IndexKey &key, Rid rid) const;
+  Rid GetEntryRid(const char *entry) const;
+
+  std::shared_ptr<Page> GetPage(pageid_t page_id);
+  // 分配溢出页面，调用者需持有 allocate_mutex_ 或 mutex_ 的排他锁
+  std::shared_ptr<Page> AllocatePage(pageid_t &page_id);
+  // 修改后的桶数、页面数和分组信息写入元信息页面
+  void WriteMetaPage();
+  // 从元信息页面读取桶数、页面数和分组信息
+  void LoadMetaPage();
+
+  db_size_t entry_size_;
+  db_size_t capacity_;
+
+  // 元信息页面的内容在首次访问索引时读取，原因同 BPlusTree
+  std::once_flag meta_loaded_;
+  uint32_t bucket_count_ = 0;
+  pageid_t page_count_ = 0;
+  std::array<pageid_t, MAX_BUCKET_GROUPS> group_start_{};
+  std::shared_mutex mutex_;
+  std::array<std::shared_mutex, BUCKET_LATCHES> bucket_latches_;
+  std::mutex allocate_mutex_;
+};
+
+}  // namespace huadb
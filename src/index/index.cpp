@@ -0,0 +1,125 @@
+#include "index/index.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace huadb {
+
+// 一列在索引项中占用的字节数：1 字节空值标记 + 值
+static db_size_t GetColumnSize(const ColumnDefinition &column) {
+  if (TypeUtil::IsString(column.type_)) {
+    // 2 字节长度 + 字符串内容
+    return 1 + sizeof(db_size_t) + column.max_size_;
+  }
+  return 1 + TypeUtil::TypeSize(column.type_);
+}
+
+bool IndexRange::AboveLower(const IndexKey &key) const {
+  if (!lower_) {
+    return true;
+  }
+  auto result = Index::CompareKeys(key, *lower_);
+  return result > 0 || (result == 0 && lower_inclusive_);
+}
+
+bool IndexRange::BelowUpper(const IndexKey &key) const {
+  if (!upper_) {
+    return true;
+  }
+  auto result = Index::CompareKeys(key, *upper_);
+  return result < 0 || (result == 0 && upper_inclusive_);
+}
+
+Index::Index(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, oid_t table_oid,
+             std::vector<IndexColumn> key_columns, std::vector<IndexColumn> include_columns)
+    : buffer_pool_(buffer_pool),
+      log_manager_(log_manager),
+      oid_(oid),
+      db_oid_(db_oid),
+      table_oid_(table_oid),
+      key_columns_(std::move(key_columns)),
+      include_columns_(std::move(include_columns)),
+      key_size_(GetColumnsSize(key_columns_)),
+      include_size_(GetColumnsSize(include_columns_)) {}
+
+oid_t Index::GetOid() const { return oid_; }
+
+oid_t Index::GetDbOid() const { return db_oid_; }
+
+oid_t Index::GetTableOid() const { return table_oid_; }
+
+const std::vector<IndexColumn> &Index::GetKeyColumns() const { return key_columns_; }
+
+const std::vector<IndexColumn> &Index::GetIncludeColumns() const { return include_columns_; }
+
+int Index::CompareKeys(const IndexKey &left, const IndexKey &right) {
+  auto size = std::min(left.size(), right.size());
+  for (size_t i = 0; i < size; i++) {
+    if (left[i].IsNull() || right[i].IsNull()) {
+      if (left[i].IsNull() != right[i].IsNull()) {
+        return left[i].IsNull() ? 1 : -1;
+      }
+      continue;
+    }
+    if (left[i].Less(right[i])) {
+      return -1;
+    }
+    if (right[i].Less(left[i])) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+db_size_t Index::GetColumnsSize(const std::vector<IndexColumn> &columns) {
+  db_size_t size = 0;
+  for (const auto &column : columns) {
+    size += GetColumnSize(column.column_);
+  }
+  return size;
+}
+
+void Index::SerializeValues(const std::vector<Value> &values, const std::vector<IndexColumn> &columns, char *data) {
+  memset(data, 0, GetColumnsSize(columns));
+  for (size_t i = 0; i < columns.size(); i++) {
+    data[0] = values[i].IsNull() ? 1 : 0;
+    if (!values[i].IsNull()) {
+      // 索引项定长，超长的字符串会越界写入相邻的索引项
+      if (TypeUtil::IsString(columns[i].column_.type_) && values[i].GetSize() > columns[i].column_.max_size_) {
+        throw DbException("Index key too long");
+      }
+      values[i].SerializeTo(data + 1);
+    }
+    data += GetColumnSize(columns[i].column_);
+  }
+}
+
+std::vector<Value> Index::DeserializeValues(const char *data, const std::vector<IndexColumn> &columns) {
+  std::vector<Value> values;
+  values.reserve(columns.size());
+  for (const auto &[col_idx, column] : columns) {
+    auto &value = values.emplace_back(column.type_, column.max_size_);
+    if (data[0] == 0) {
+      db_size_t length = 0;
+      if (TypeUtil::IsString(column.type_)) {
+        memcpy(&length, data + 1, sizeof(length));
+      }
+      if (length > column.max_size_) {
+        // 乐观读取时可能读到正在移动的索引项，长度越界时截断，读取结果由调用者通过版本号校验后丢弃
+        std::vector<char> buffer(data + 1, data + GetColumnSize(column));
+        memcpy(buffer.data(), &column.max_size_, sizeof(length));
+        value.DeserializeFrom(buffer.data());
+      } else {
+        value.DeserializeFrom(data + 1);
+      }
+    }
+    data += GetColumnSize(column);
+  }
+  return values;
+}
+
+void Index::SerializeKey(const IndexKey &key, char *data) const { SerializeValues(key, key_columns_, data); }
+
+IndexKey Index::DeserializeKey(const char *data) const { return DeserializeValues(data, key_columns_); }
+
+}  // namespace huadb
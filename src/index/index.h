@@ -0,0 +1,113 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "catalog/column_definition.h"
+#include "common/types.h"
+#include "common/value.h"
+#include "log/log_manager.h"
+#include "storage/buffer_pool.h"
+
+namespace huadb {
+
+// 索引键，由各键列的值组成，多列索引的键按列的顺序逐列比较
+using IndexKey = std::vector<Value>;
+
+// 索引中的列
+struct IndexColumn {
+  size_t col_idx_;  // 列在表中的下标
+  ColumnDefinition column_;
+};
+
+// 索引扫描的键范围，上下界为空时不限制，上下界可以只包含键的前几列，此时只比较这些列
+struct IndexRange {
+  std::optional<IndexKey> lower_;
+  bool lower_inclusive_ = true;
+  std::optional<IndexKey> upper_;
+  bool upper_inclusive_ = true;
+
+  // 键是否不小于下界
+  bool AboveLower(const IndexKey &key) const;
+  // 键是否不大于上界
+  bool BelowUpper(const IndexKey &key) const;
+};
+
+// 索引项，索引扫描返回键、附加列的值和 rid，只需要这些列时可以不访问表
+struct IndexEntry {
+  IndexKey key_;
+  std::vector<Value> include_;
+  Rid rid_;
+};
+
+// 表上的二级索引，索引项由键列的值、附加列（INCLUDE）的值和记录的 rid 组成，只有键列参与排序和查找
+// 第一个键列为空值的记录不建立索引，其余键列和附加列可以为空值，空值大于所有非空值
+// 索引项与记录版本一一对应，与可见性无关：更新产生的新版本插入新的索引项，删除记录时保留索引项，
+// 扫描时在表中判断可见性，清理回收记录版本时删除对应的索引项
+class Index {
+ public:
+  Index(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, oid_t table_oid,
+        std::vector<IndexColumn> key_columns, std::vector<IndexColumn> include_columns);
+  virtual ~Index() = default;
+
+  // 获取记录或 TupleView 中的索引键
+  template <typename Row>
+  IndexKey GetKey(const Row &row) const {
+    return GetValues(row, key_columns_);
+  }
+  // 获取记录或 TupleView 中附加列的值
+  template <typename Row>
+  std::vector<Value> GetIncludeValues(const Row &row) const {
+    return GetValues(row, include_columns_);
+  }
+
+  // 插入索引项，第一个键列为空值时忽略；write_log 为 false 时不写日志，用于建立索引
+  virtual void InsertEntry(const IndexKey &key, const std::vector<Value> &include, Rid rid, xid_t xid,
+                           bool write_log) = 0;
+  // 删除索引项，索引项不存在时忽略，由清理调用
+  virtual void DeleteEntry(const IndexKey &key, Rid rid, xid_t xid) = 0;
+  // 获取键在 range 中的所有索引项，B+ 树按键的顺序返回，哈希索引只支持等值查找
+  virtual std::vector<IndexEntry> Scan(const IndexRange &range) = 0;
+
+  virtual IndexType GetIndexType() const = 0;
+
+  oid_t GetOid() const;
+  oid_t GetDbOid() const;
+  oid_t GetTableOid() const;
+  const std::vector<IndexColumn> &GetKeyColumns() const;
+  const std::vector<IndexColumn> &GetIncludeColumns() const;
+
+  // 逐列比较两个键，返回负数、0 或正数，只比较两者共有的前几列，一方是另一方的前缀时返回 0
+  static int CompareKeys(const IndexKey &left, const IndexKey &right);
+  // 一组列在索引项中占用的字节数，每列为 1 字节空值标记 + 值，字符串按最大长度定长存放
+  static db_size_t GetColumnsSize(const std::vector<IndexColumn> &columns);
+
+ protected:
+  template <typename Row>
+  static std::vector<Value> GetValues(const Row &row, const std::vector<IndexColumn> &columns) {
+    std::vector<Value> values;
+    values.reserve(columns.size());
+    for (const auto &column : columns) {
+      values.push_back(row.GetValue(column.col_idx_));
+    }
+    return values;
+  }
+
+  // 将一组列的值写入索引项，不足定长的部分填充 0
+  static void SerializeValues(const std::vector<Value> &values, const std::vector<IndexColumn> &columns, char *data);
+  static std::vector<Value> DeserializeValues(const char *data, const std::vector<IndexColumn> &columns);
+  void SerializeKey(const IndexKey &key, char *data) const;
+  IndexKey DeserializeKey(const char *data) const;
+
+  BufferPool &buffer_pool_;
+  LogManager &log_manager_;
+  oid_t oid_;
+  oid_t db_oid_;
+  oid_t table_oid_;
+  std::vector<IndexColumn> key_columns_;
+  std::vector<IndexColumn> include_columns_;
+  db_size_t key_size_;      // 键在索引项中占用的字节数
+  db_size_t include_size_;  // 附加列在索引项中占用的字节数
+};
+
+}  // namespace huadb
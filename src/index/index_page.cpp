@@ -0,0 +1,80 @@
+#include "index/index_page.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "common/constants.h"
+
+namespace huadb {
+
+IndexPage::IndexPage(std::shared_ptr<Page> page) : page_(std::move(page)) {
+  page_data_ = page_->GetData();
+  db_size_t offset = 0;
+  page_lsn_ = reinterpret_cast<lsn_t *>(page_data_);
+  offset += sizeof(lsn_t);
+  next_page_id_ = reinterpret_cast<pageid_t *>(page_data_ + offset);
+  offset += sizeof(pageid_t);
+  entry_count_ = reinterpret_cast<db_size_t *>(page_data_ + offset);
+  offset += sizeof(db_size_t);
+  level_ = reinterpret_cast<db_size_t *>(page_data_ + offset);
+  offset += sizeof(db_size_t);
+  assert(offset == INDEX_PAGE_HEADER_SIZE);
+  entries_ = page_data_ + INDEX_PAGE_HEADER_SIZE;
+}
+
+void IndexPage::Init(db_size_t level) {
+  *page_lsn_ = 0;
+  *next_page_id_ = NULL_PAGE_ID;
+  *entry_count_ = 0;
+  *level_ = level;
+  page_->SetDirty();
+}
+
+db_size_t IndexPage::GetCapacity(size_t page_size, db_size_t entry_size) {
+  return (page_size - INDEX_PAGE_HEADER_SIZE) / entry_size;
+}
+
+const char *IndexPage::GetEntry(db_size_t pos, db_size_t entry_size) const { return entries_ + pos * entry_size; }
+
+void IndexPage::InsertEntry(db_size_t pos, const char *entry, db_size_t entry_size) {
+  assert(pos <= *entry_count_);
+  memmove(entries_ + (pos + 1) * entry_size, entries_ + pos * entry_size, (*entry_count_ - pos) * entry_size);
+  memcpy(entries_ + pos * entry_size, entry, entry_size);
+  (*entry_count_)++;
+  page_->SetDirty();
+}
+
+void IndexPage::DeleteEntry(db_size_t pos, db_size_t entry_size) {
+  assert(pos < *entry_count_);
+  memmove(entries_ + pos * entry_size, entries_ + (pos + 1) * entry_size, (*entry_count_ - pos - 1) * entry_size);
+  (*entry_count_)--;
+  page_->SetDirty();
+}
+
+void IndexPage::SetEntries(const char *entries, db_size_t count, db_size_t entry_size) {
+  memcpy(entries_, entries, count * entry_size);
+  *entry_count_ = count;
+  page_->SetDirty();
+}
+
+db_size_t IndexPage::GetEntryCount() const { return *entry_count_; }
+
+db_size_t IndexPage::GetLevel() const { return *level_; }
+
+bool IndexPage::IsLeaf() const { return *level_ == 0; }
+
+lsn_t IndexPage::GetPageLSN() const { return *page_lsn_; }
+
+pageid_t IndexPage::GetNextPageId() const { return *next_page_id_; }
+
+void IndexPage::SetPageLSN(lsn_t page_lsn) {
+  *page_lsn_ = page_lsn;
+  page_->SetDirty();
+}
+
+void IndexPage::SetNextPageId(pageid_t page_id) {
+  *next_page_id_ = page_id;
+  page_->SetDirty();
+}
+
+}  // namespace huadb
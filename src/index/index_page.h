@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+
+#include "common/types.h"
+#include "storage/page.h"
+
+namespace huadb {
+
+// page_lsn(8) + next_page(4) + entry_count(2) + level(2) = 16
+static constexpr db_size_t INDEX_PAGE_HEADER_SIZE =
+    sizeof(lsn_t) + sizeof(pageid_t) + sizeof(db_size_t) + sizeof(db_size_t);
+
+// 索引页面，页头之后为定长索引项组成的数组，索引项的长度由索引决定，页面中不保存
+// page_lsn 与 TablePage 位于相同位置，buffer pool 写回页面前按 TablePage 的格式读取 page_lsn
+class IndexPage {
+ public:
+  explicit IndexPage(std::shared_ptr<Page> page);
+
+  // 页面初始化，level 为页面所在的层，0 表示叶节点
+  void Init(db_size_t level);
+
+  // 页面最多容纳的索引项数
+  static db_size_t GetCapacity(size_t page_size, db_size_t entry_size);
+
+  // 获取第 pos 个索引项的起始地址
+  const char *GetEntry(db_size_t pos, db_size_t entry_size) const;
+  // 在第 pos 个位置插入索引项，之后的索引项依次后移，调用前需确认页面未满
+  void InsertEntry(db_size_t pos, const char *entry, db_size_t entry_size);
+  // 删除第 pos 个索引项，之后的索引项依次前移
+  void DeleteEntry(db_size_t pos, db_size_t entry_size);
+  // 用 entries 中的 count 个连续索引项替换页面中的所有索引项
+  void SetEntries(const char *entries, db_size_t count, db_size_t entry_size);
+
+  db_size_t GetEntryCount() const;
+  db_size_t GetLevel() const;
+  bool IsLeaf() const;
+  lsn_t GetPageLSN() const;
+  pageid_t GetNextPageId() const;
+
+  void SetPageLSN(lsn_t page_lsn);
+  void SetNextPageId(pageid_t page_id);
+
+ private:
+  std::shared_ptr<Page> page_;
+  char *page_data_;
+  lsn_t *page_lsn_;
+  pageid_t *next_page_id_;  // 叶节点为右侧相邻叶节点的页面号，内部节点为最左侧子节点的页面号
+  db_size_t *entry_count_;
+  db_size_t *level_;
+  char *entries_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,24 @@
+#include "index/optimistic_latch.h"
+
+namespace huadb {
+
+static constexpr uint64_t LOCKED_BIT = 1;
+
+bool OptimisticLatch::ReadLock(uint64_t &version) const {
+  version = version_.load(std::memory_order_acquire);
+  return (version & LOCKED_BIT) == 0;
+}
+
+bool OptimisticLatch::Validate(uint64_t version) const {
+  // 保证读取节点内容发生在再次读取版本号之前
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return version_.load(std::memory_order_relaxed) == version;
+}
+
+bool OptimisticLatch::Upgrade(uint64_t version) {
+  return version_.compare_exchange_strong(version, version + LOCKED_BIT, std::memory_order_acquire);
+}
+
+void OptimisticLatch::WriteUnlock() { version_.fetch_add(LOCKED_BIT, std::memory_order_release); }
+
+}  // namespace huadb
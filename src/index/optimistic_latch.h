@@ -0,0 +1,26 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace huadb {
+
+// 乐观锁，版本号最低位为 1 时表示被写锁定，每次释放写锁后版本号增加
+// 读者不加锁，读取前记录版本号，读取后校验版本号未变化，变化时重新读取
+// 写者在版本号未变化时将读到的版本升级为写锁，升级失败说明读取之后节点被修改过
+class OptimisticLatch {
+ public:
+  // 获取当前版本号，节点被写锁定时返回 false
+  bool ReadLock(uint64_t &version) const;
+  // 校验读取期间版本号未变化
+  bool Validate(uint64_t version) const;
+  // 版本号仍为 version 时加写锁，否则返回 false
+  bool Upgrade(uint64_t version);
+  // 释放写锁，版本号增加
+  void WriteUnlock();
+
+ private:
+  std::atomic<uint64_t> version_ = 0;
+};
+
+}  // namespace huadb
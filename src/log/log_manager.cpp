@@ -23,6 +23,7 @@ void LogManager::Clear() {
 void LogManager::Flush() { Flush(NULL_LSN); }
 
 void LogManager::SetDirty(oid_t oid, pageid_t page_id, lsn_t lsn) {
+  std::scoped_lock lock(dpt_mutex_);
   if (dpt_.find({oid, page_id}) == dpt_.end()) {
     dpt_[{oid, page_id}] = lsn;
   }
@@ -41,6 +42,7 @@ lsn_t LogManager::AppendInsertLog(xid_t xid, oid_t oid, pageid_t page_id, slotid
     std::unique_lock lock(log_buffer_mutex_);
     log_buffer_.push_back(std::move(log));
   }
+  std::scoped_lock lock(dpt_mutex_);
   if (dpt_.find({oid, page_id}) == dpt_.end()) {
     dpt_[{oid, page_id}] = lsn;
   }
@@ -59,6 +61,109 @@ lsn_t LogManager::AppendDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, slotid
     std::unique_lock lock(log_buffer_mutex_);
     log_buffer_.push_back(std::move(log));
   }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendUpdateLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t old_slot_id, cid_t old_cid,
+                                  slotid_t new_slot_id, db_size_t offset, db_size_t size, char *new_record) {
+  if (att_.find(xid) == att_.end()) {
+    throw DbException(std::to_string(xid) + " does not exist in att (in AppendUpdateLog)");
+  }
+  auto log = std::make_shared<UpdateLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, old_slot_id, old_cid, new_slot_id,
+                                         offset, size, new_record);
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  att_[xid] = lsn;
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendVacuumLog(xid_t xid, oid_t oid, pageid_t page_id, std::vector<slotid_t> slot_ids) {
+  if (att_.find(xid) == att_.end()) {
+    throw DbException(std::to_string(xid) + " does not exist in att (in AppendVacuumLog)");
+  }
+  auto log = std::make_shared<VacuumLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, std::move(slot_ids));
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  att_[xid] = lsn;
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendBulkInsertLog(xid_t xid, oid_t oid, pageid_t prev_page_id, pageid_t page_id,
+                                      slotid_t record_count, std::vector<char> page_data) {
+  if (att_.find(xid) == att_.end()) {
+    throw DbException(std::to_string(xid) + " does not exist in att (in AppendBulkInsertLog)");
+  }
+  auto log = std::make_shared<BulkInsertLog>(NULL_LSN, xid, att_.at(xid), oid, prev_page_id, page_id, record_count,
+                                             std::move(page_data));
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  att_[xid] = lsn;
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendIndexInsertLog(xid_t xid, oid_t oid, pageid_t page_id, db_size_t position,
+                                       std::vector<char> entry) {
+  if (att_.find(xid) == att_.end()) {
+    throw DbException(std::to_string(xid) + " does not exist in att (in AppendIndexInsertLog)");
+  }
+  auto log = std::make_shared<IndexInsertLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, position, std::move(entry));
+  return AppendIndexLog(xid, oid, page_id, std::move(log));
+}
+
+lsn_t LogManager::AppendIndexDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, db_size_t position,
+                                       db_size_t entry_size) {
+  if (att_.find(xid) == att_.end()) {
+    throw DbException(std::to_string(xid) + " does not exist in att (in AppendIndexDeleteLog)");
+  }
+  auto log = std::make_shared<IndexDeleteLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, position, entry_size);
+  return AppendIndexLog(xid, oid, page_id, std::move(log));
+}
+
+lsn_t LogManager::AppendIndexPageLog(xid_t xid, oid_t oid, pageid_t page_id, std::vector<char> page_data) {
+  if (att_.find(xid) == att_.end()) {
+    throw DbException(std::to_string(xid) + " does not exist in att (in AppendIndexPageLog)");
+  }
+  auto log = std::make_shared<IndexPageLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, std::move(page_data));
+  return AppendIndexLog(xid, oid, page_id, std::move(log));
+}
+
+lsn_t LogManager::AppendIndexLog(xid_t xid, oid_t oid, pageid_t page_id, std::shared_ptr<LogRecord> log) {
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  att_[xid] = lsn;
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
   if (dpt_.find({oid, page_id}) == dpt_.end()) {
     dpt_[{oid, page_id}] = lsn;
   }
@@ -86,6 +191,7 @@ lsn_t LogManager::AppendNewPageLog(xid_t xid, oid_t oid, pageid_t prev_page_id,
     std::unique_lock lock(log_buffer_mutex_);
     log_buffer_.push_back(std::move(log));
   }
+  std::scoped_lock lock(dpt_mutex_);
   if (dpt_.find({oid, page_id}) == dpt_.end()) {
     dpt_[{oid, page_id}] = lsn;
   }
@@ -143,6 +249,8 @@ lsn_t LogManager::AppendRollbackLog(xid_t xid) {
 }
 
 lsn_t LogManager::Checkpoint(bool async) {
+  // 已写回的页面不在脏页表中，需先持久化页面文件再写 checkpoint 日志
+  disk_.SyncPages();
   auto begin_checkpoint_log = std::make_shared<BeginCheckpointLog>(NULL_LSN, NULL_XID, NULL_LSN);
   lsn_t begin_lsn = next_lsn_.fetch_add(begin_checkpoint_log->GetSize(), std::memory_order_relaxed);
   begin_checkpoint_log->SetLSN(begin_lsn);
@@ -151,7 +259,12 @@ lsn_t LogManager::Checkpoint(bool async) {
     log_buffer_.push_back(std::move(begin_checkpoint_log));
   }
 
-  auto end_checkpoint_log = std::make_shared<EndCheckpointLog>(NULL_LSN, NULL_XID, NULL_LSN, att_, dpt_);
+  std::unordered_map<TablePageid, lsn_t> dpt;
+  {
+    std::scoped_lock lock(dpt_mutex_);
+    dpt = dpt_;
+  }
+  auto end_checkpoint_log = std::make_shared<EndCheckpointLog>(NULL_LSN, NULL_XID, NULL_LSN, att_, dpt);
   lsn_t end_lsn = next_lsn_.fetch_add(end_checkpoint_log->GetSize(), std::memory_order_relaxed);
   end_checkpoint_log->SetLSN(end_lsn);
   {
@@ -166,6 +279,7 @@ lsn_t LogManager::Checkpoint(bool async) {
 
 void LogManager::FlushPage(oid_t table_oid, pageid_t page_id, lsn_t page_lsn) {
   Flush(page_lsn);
+  std::scoped_lock lock(dpt_mutex_);
   dpt_.erase({table_oid, page_id});
 }
 
@@ -174,7 +288,7 @@ void LogManager::Rollback(xid_t xid) {
   // 依次获取 lsn 的 prev_lsn_，直到 NULL_LSN
   // 根据 lsn 和 flushed_lsn_ 的大小关系，判断日志在 buffer 中还是在磁盘中
   // 若日志在 buffer 中，通过 log_buffer_ 获取日志
-  // 若日志在磁盘中，通过 disk_ 读取日志，count 参数可设置为 MAX_LOG_SIZE
+  // 若日志在磁盘中，通过 disk_ 读取日志，count 参数可设置为 MaxLogSize(disk_.GetPageSize())
   // 通过 LogRecord::DeserializeFrom 函数解析日志
   // 调用日志的 Undo 函数
   // LAB 2 BEGIN
@@ -185,38 +299,39 @@ void LogManager::Rollback(xid_t xid) {
   // Process all log entries for this transaction until reaching the beginning
   for (; current_sequence != NULL_LSN; ) {
     // Determine if the log record is in memory or on disk
-    if (current_sequence > flushed_lsn_) {
-      // Search in memory buffer for the log entry
-      bool found = false;
-      for (auto buffer_iter = log_buffer_.begin(); buffer_iter != log_buffer_.end(); ++buffer_iter) {
-        std::shared_ptr<LogRecord> current_record = *buffer_iter;
-
-        // Found the matching record in the buffer
-        if (current_record->GetLSN() == current_sequence) {
-          // Get the previous log entry in the chain before undoing
-          lsn_t previous_sequence = current_record->GetPrevLSN();
-
-          // Execute undo operation for this record
-          current_record->Undo(*buffer_pool_, *catalog_, *this, previous_sequence);
-
-          // Move to the previous record in the chain
-          current_sequence = previous_sequence;
-          found = true;
-          break;
+    // The background writer may flush the log concurrently, so look the record up under the buffer lock
+    std::shared_ptr<LogRecord> current_record;
+    {
+      std::shared_lock lock(log_buffer_mutex_);
+      if (current_sequence > flushed_lsn_) {
+        for (const auto &buffered_record : log_buffer_) {
+          if (buffered_record->GetLSN() == current_sequence) {
+            current_record = buffered_record;
+            break;
+          }
+        }
+        // Sanity check - should always find the record
+        if (current_record == nullptr) {
+          throw std::runtime_error("Log record not found in buffer");
         }
       }
+    }
+    if (current_record != nullptr) {
+      // Get the previous log entry in the chain before undoing
+      lsn_t previous_sequence = current_record->GetPrevLSN();
 
-      // Sanity check - should always find the record
-      if (!found) {
-        throw std::runtime_error("Log record not found in buffer");
-      }
+      // Execute undo operation for this record
+      current_record->Undo(*buffer_pool_, *catalog_, *this, previous_sequence);
+
+      // Move to the previous record in the chain
+      current_sequence = previous_sequence;
     }
     else {
       // Retrieve record from persistent storage
-      std::vector<char> log_data(MAX_LOG_SIZE);
+      std::vector<char> log_data(MaxLogSize(disk_.GetPageSize()));
 
       // Read the log entry from disk
-      disk_.ReadLog(current_sequence, MAX_LOG_SIZE, log_data.data());
+      disk_.ReadLog(current_sequence, MaxLogSize(disk_.GetPageSize()), log_data.data());
 
       // Deserialize the log record
       auto log_entry = LogRecord::DeserializeFrom(current_sequence, log_data.data());
@@ -246,25 +361,24 @@ uint32_t LogManager::GetRedoCount() const { return redo_count_; }
 void LogManager::Flush(lsn_t lsn) {
   size_t max_log_size = 0;
   lsn_t max_lsn = NULL_LSN;
-  {
-    std::unique_lock lock(log_buffer_mutex_);
-    for (auto iterator = log_buffer_.cbegin(); iterator != log_buffer_.cend();) {
-      const auto &log_record = *iterator;
-      // 如果 lsn 为 NULL_LSN，表示 log_buffer_ 中所有日志都需要刷盘
-      if (lsn != NULL_LSN && log_record->GetLSN() > lsn) {
-        iterator++;
-        continue;
-      }
-      auto log_size = log_record->GetSize();
-      auto log = std::make_unique<char[]>(log_size);
-      log_record->SerializeTo(log.get());
-      disk_.WriteLog(log_record->GetLSN(), log_size, log.get());
-      if (max_lsn == NULL_LSN || log_record->GetLSN() > max_lsn) {
-        max_lsn = log_record->GetLSN();
-        max_log_size = log_size;
-      }
-      iterator = log_buffer_.erase(iterator);
+  // 后台写进程与查询线程可能同时刷日志，flushed_lsn_ 和 next_lsn 文件同样由 log_buffer_mutex_ 保护
+  std::unique_lock lock(log_buffer_mutex_);
+  for (auto iterator = log_buffer_.cbegin(); iterator != log_buffer_.cend();) {
+    const auto &log_record = *iterator;
+    // 如果 lsn 为 NULL_LSN，表示 log_buffer_ 中所有日志都需要刷盘
+    if (lsn != NULL_LSN && log_record->GetLSN() > lsn) {
+      iterator++;
+      continue;
+    }
+    auto log_size = log_record->GetSize();
+    auto log = std::make_unique<char[]>(log_size);
+    log_record->SerializeTo(log.get());
+    disk_.WriteLog(log_record->GetLSN(), log_size, log.get());
+    if (max_lsn == NULL_LSN || log_record->GetLSN() > max_lsn) {
+      max_lsn = log_record->GetLSN();
+      max_log_size = log_size;
     }
+    iterator = log_buffer_.erase(iterator);
   }
   // 如果 max_lsn 为 NULL_LSN，表示没有日志刷盘
   // 如果 flushed_lsn_ 为 NULL_LSN，表示还没有日志刷过盘
@@ -310,13 +424,13 @@ void LogManager::Analyze() {
   smallest_sequence_num_ = checkpoint_lsn;
 
   // Allocate buffer for reading log records
-  std::vector<char> buffer_memory(MAX_LOG_SIZE);
+  std::vector<char> buffer_memory(MaxLogSize(disk_.GetPageSize()));
   char* log_buffer = buffer_memory.data();
 
   // PHASE 1: Scan for END_CHECKPOINT record to retrieve transaction and dirty page state
   while (current_position < next_lsn_) {
     // Read log record from persistent storage
-    disk_.ReadLog(current_position, MAX_LOG_SIZE, log_buffer);
+    disk_.ReadLog(current_position, MaxLogSize(disk_.GetPageSize()), log_buffer);
 
     // Deserialize the log record
     std::shared_ptr<LogRecord> log_entry = LogRecord::DeserializeFrom(current_position, log_buffer);
@@ -343,7 +457,7 @@ void LogManager::Analyze() {
   // Scan forward through all logs after checkpoint
   while (current_position < next_lsn_) {
     // Read and deserialize log record
-    disk_.ReadLog(current_position, MAX_LOG_SIZE, log_buffer);
+    disk_.ReadLog(current_position, MaxLogSize(disk_.GetPageSize()), log_buffer);
     std::shared_ptr<LogRecord> log_entry = LogRecord::DeserializeFrom(current_position, log_buffer);
 
     // Get transaction ID from log record
@@ -355,7 +469,13 @@ void LogManager::Analyze() {
     // Handle transaction records (INSERT, DELETE, NEW_PAGE)
     bool is_modification_record = (record_type == LogType::INSERT ||
                                   record_type == LogType::DELETE ||
-                                  record_type == LogType::NEW_PAGE);
+                                  record_type == LogType::NEW_PAGE ||
+                                  record_type == LogType::VACUUM ||
+                                  record_type == LogType::UPDATE ||
+                                  record_type == LogType::BULK_INSERT ||
+                                  record_type == LogType::INDEX_INSERT ||
+                                  record_type == LogType::INDEX_DELETE ||
+                                  record_type == LogType::INDEX_PAGE);
 
     // Update active transaction table for modification records
     if (is_modification_record) {
@@ -409,13 +529,13 @@ void LogManager::Redo() {
   }
 
   // Use vector for safer memory management
-  std::vector<char> log_storage(MAX_LOG_SIZE);
+  std::vector<char> log_storage(MaxLogSize(disk_.GetPageSize()));
   char* log_buffer = log_storage.data();
 
   // Process all logs from earliest needed LSN to the latest
   while (current_lsn < next_lsn_) {
     // Read and deserialize the log record
-    disk_.ReadLog(current_lsn, MAX_LOG_SIZE, log_buffer);
+    disk_.ReadLog(current_lsn, MaxLogSize(disk_.GetPageSize()), log_buffer);
     auto log_entry = LogRecord::DeserializeFrom(current_lsn, log_buffer);
 
     // Extract page information
@@ -426,7 +546,13 @@ void LogManager::Redo() {
     // Check if this is a modification record
     bool is_data_modification = (log_entry->GetType() == LogType::INSERT ||
                                 log_entry->GetType() == LogType::DELETE ||
-                                log_entry->GetType() == LogType::NEW_PAGE);
+                                log_entry->GetType() == LogType::NEW_PAGE ||
+                                log_entry->GetType() == LogType::VACUUM ||
+                                log_entry->GetType() == LogType::UPDATE ||
+                                log_entry->GetType() == LogType::BULK_INSERT ||
+                                log_entry->GetType() == LogType::INDEX_INSERT ||
+                                log_entry->GetType() == LogType::INDEX_DELETE ||
+                                log_entry->GetType() == LogType::INDEX_PAGE);
 
     if (is_data_modification) {
       // Check if page is in dirty page table
@@ -436,8 +562,11 @@ void LogManager::Redo() {
 
         // Only redo if this log entry should be applied
         if (current_lsn >= recovery_lsn) {
-          if (log_entry->GetType() == LogType::NEW_PAGE) {
+          if (log_entry->GetType() == LogType::NEW_PAGE || log_entry->GetType() == LogType::BULK_INSERT ||
+              log_entry->GetType() == LogType::INDEX_INSERT || log_entry->GetType() == LogType::INDEX_DELETE ||
+              log_entry->GetType() == LogType::INDEX_PAGE) {
             // For new pages, always apply the redo operation
+            // 索引日志的 redo 自行检查索引是否存在及页面的 page_lsn
             log_entry->Redo(*buffer_pool_, *catalog_, *this);
           } else {
             // For existing pages, check the page LSN first
@@ -511,6 +640,50 @@ std::pair<oid_t, pageid_t> LogManager::ExtractRecordCoordinates(const std::share
       entity_identifier = page_creation_entry->GetOid();
     }
   }
+  // Handle VACUUM records
+  else if (entry_type == LogType::VACUUM) {
+    auto vacuum_entry = std::dynamic_pointer_cast<VacuumLog>(log_entry);
+    if (vacuum_entry) {
+      page_location = vacuum_entry->GetPageId();
+      entity_identifier = vacuum_entry->GetOid();
+    }
+  }
+  // Handle UPDATE records
+  else if (entry_type == LogType::UPDATE) {
+    auto update_entry = std::dynamic_pointer_cast<UpdateLog>(log_entry);
+    if (update_entry) {
+      page_location = update_entry->GetPageId();
+      entity_identifier = update_entry->GetOid();
+    }
+  }
+  // Handle BULK_INSERT records
+  else if (entry_type == LogType::BULK_INSERT) {
+    auto bulk_insert_entry = std::dynamic_pointer_cast<BulkInsertLog>(log_entry);
+    if (bulk_insert_entry) {
+      page_location = bulk_insert_entry->GetPageId();
+      entity_identifier = bulk_insert_entry->GetOid();
+    }
+  }
+  // Handle index records
+  else if (entry_type == LogType::INDEX_INSERT) {
+    auto index_insert_entry = std::dynamic_pointer_cast<IndexInsertLog>(log_entry);
+    if (index_insert_entry) {
+      page_location = index_insert_entry->GetPageId();
+      entity_identifier = index_insert_entry->GetOid();
+    }
+  } else if (entry_type == LogType::INDEX_DELETE) {
+    auto index_delete_entry = std::dynamic_pointer_cast<IndexDeleteLog>(log_entry);
+    if (index_delete_entry) {
+      page_location = index_delete_entry->GetPageId();
+      entity_identifier = index_delete_entry->GetOid();
+    }
+  } else if (entry_type == LogType::INDEX_PAGE) {
+    auto index_page_entry = std::dynamic_pointer_cast<IndexPageLog>(log_entry);
+    if (index_page_entry) {
+      page_location = index_page_entry->GetPageId();
+      entity_identifier = index_page_entry->GetOid();
+    }
+  }
   // Other log types remain with default values (implicit)
 
   // Return the coordinate pair
@@ -5,6 +5,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "catalog/catalog.h"
 #include "common/constants.h"
@@ -37,7 +38,16 @@ class LogManager {
   lsn_t AppendInsertLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id, db_size_t offset, db_size_t size,
                         char *new_record);
   lsn_t AppendDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id);
+  lsn_t AppendUpdateLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t old_slot_id, cid_t old_cid,
+                        slotid_t new_slot_id, db_size_t offset, db_size_t size, char *new_record);
   lsn_t AppendNewPageLog(xid_t xid, oid_t oid, pageid_t prev_page_id, pageid_t page_id);
+  lsn_t AppendVacuumLog(xid_t xid, oid_t oid, pageid_t page_id, std::vector<slotid_t> slot_ids);
+  lsn_t AppendBulkInsertLog(xid_t xid, oid_t oid, pageid_t prev_page_id, pageid_t page_id, slotid_t record_count,
+                            std::vector<char> page_data);
+  // 索引日志，entry 为插入的索引项，entry_size 为删除的索引项的长度
+  lsn_t AppendIndexInsertLog(xid_t xid, oid_t oid, pageid_t page_id, db_size_t position, std::vector<char> entry);
+  lsn_t AppendIndexDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, db_size_t position, db_size_t entry_size);
+  lsn_t AppendIndexPageLog(xid_t xid, oid_t oid, pageid_t page_id, std::vector<char> page_data);
   lsn_t AppendBeginLog(xid_t xid);
   lsn_t AppendCommitLog(xid_t xid);
   lsn_t AppendRollbackLog(xid_t xid);
@@ -67,6 +77,8 @@ class LogManager {
  private:
   // 将 lsn 之前的日志刷到磁盘
   void Flush(lsn_t lsn);
+  // 分配 lsn 并追加索引日志，更新活跃事务表和脏页表
+  lsn_t AppendIndexLog(xid_t xid, oid_t oid, pageid_t page_id, std::shared_ptr<LogRecord> log);
 
   // ARIES 相关函数
   // 分析阶段，恢复脏页表和活跃事务表
@@ -83,6 +95,8 @@ class LogManager {
 
   std::unordered_map<xid_t, lsn_t> att_;        // 活跃事务表
   std::unordered_map<TablePageid, lsn_t> dpt_;  // 脏页表
+  // 后台写进程写回页面时会修改脏页表
+  std::mutex dpt_mutex_;
 
   // 下一条日志的 lsn
   std::atomic<lsn_t> next_lsn_;
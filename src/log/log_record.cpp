@@ -41,6 +41,18 @@ std::shared_ptr<LogRecord> LogRecord::DeserializeFrom(lsn_t lsn, const char *dat
       return BeginCheckpointLog::DeserializeFrom(lsn, data + sizeof(type));
     case LogType::END_CHECKPOINT:
       return EndCheckpointLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::VACUUM:
+      return VacuumLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::UPDATE:
+      return UpdateLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::BULK_INSERT:
+      return BulkInsertLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::INDEX_INSERT:
+      return IndexInsertLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::INDEX_DELETE:
+      return IndexDeleteLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::INDEX_PAGE:
+      return IndexPageLog::DeserializeFrom(lsn, data + sizeof(type));
     default:
       throw DbException("Unknown log type in DeserializeFrom");
   }
@@ -22,6 +22,12 @@ enum class LogType : enum_t {
   NEW_PAGE,
   BEGIN_CHECKPOINT,
   END_CHECKPOINT,
+  VACUUM,
+  UPDATE,
+  BULK_INSERT,
+  INDEX_INSERT,
+  INDEX_DELETE,
+  INDEX_PAGE,
 };
 
 class LogRecord {
@@ -0,0 +1,113 @@
+#include "log/log_records/bulk_insert_log.h"
+
+#include "table/pax_page.h"
+#include "table/table.h"
+#include "table/table_page.h"
+
+namespace huadb {
+
+BulkInsertLog::BulkInsertLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t prev_page_id, pageid_t page_id,
+                             slotid_t record_count, std::vector<char> page_data)
+    : LogRecord(LogType::BULK_INSERT, lsn, xid, prev_lsn),
+      oid_(oid),
+      prev_page_id_(prev_page_id),
+      page_id_(page_id),
+      record_count_(record_count),
+      page_data_(std::move(page_data)) {
+  size_ += sizeof(oid_) + sizeof(prev_page_id_) + sizeof(page_id_) + sizeof(record_count_) + sizeof(db_size_t) +
+           page_data_.size();
+}
+
+size_t BulkInsertLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &prev_page_id_, sizeof(prev_page_id_));
+  offset += sizeof(prev_page_id_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  memcpy(data + offset, &record_count_, sizeof(record_count_));
+  offset += sizeof(record_count_);
+  db_size_t page_size = page_data_.size();
+  memcpy(data + offset, &page_size, sizeof(page_size));
+  offset += sizeof(page_size);
+  memcpy(data + offset, page_data_.data(), page_size);
+  offset += page_size;
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<BulkInsertLog> BulkInsertLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t prev_page_id, page_id;
+  slotid_t record_count;
+  db_size_t page_size;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&prev_page_id, data + offset, sizeof(prev_page_id));
+  offset += sizeof(prev_page_id);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  memcpy(&record_count, data + offset, sizeof(record_count));
+  offset += sizeof(record_count);
+  memcpy(&page_size, data + offset, sizeof(page_size));
+  offset += sizeof(page_size);
+  std::vector<char> page_data(data + offset, data + offset + page_size);
+  offset += page_size;
+  return std::make_shared<BulkInsertLog>(lsn, xid, prev_lsn, oid, prev_page_id, page_id, record_count,
+                                         std::move(page_data));
+}
+
+void BulkInsertLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) {
+  // 与 InsertLog 相同，删除导入的记录，页面保留在链表中，由清理回收
+  // 之后其他事务插入的记录位于 record_count_ 之后的槽位，不能删除
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  auto page = buffer_pool.GetPage(db_oid, oid_, page_id_);
+  auto table = catalog.GetTable(oid_);
+  if (table->GetLayout() == TableLayout::PAX) {
+    PaxPage pax_page(page, table->GetColumnList());
+    for (slotid_t slot_id = 0; slot_id < record_count_; slot_id++) {
+      pax_page.DeleteRecord(slot_id, xid_);
+    }
+    return;
+  }
+  TablePage table_page(page);
+  for (slotid_t slot_id = 0; slot_id < record_count_; slot_id++) {
+    table_page.DeleteRecord(slot_id, xid_);
+  }
+}
+
+void BulkInsertLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该表已经被删除，无需 redo
+  if (!catalog.TableExists(oid_)) {
+    return;
+  }
+  // 与 NewPageLog 相同，重新链接前一个页面并用日志中的内容覆盖新页面
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  if (prev_page_id_ != NULL_PAGE_ID) {
+    TablePage prev_page(buffer_pool.GetPage(db_oid, oid_, prev_page_id_));
+    prev_page.SetNextPageId(page_id_);
+  }
+  auto page = buffer_pool.NewPage(db_oid, oid_, page_id_);
+  memcpy(page->GetData(), page_data_.data(), page_data_.size());
+  // PAX 页面的 page_lsn 与 TablePage 位于相同位置
+  TablePage(page).SetPageLSN(lsn_);
+}
+
+oid_t BulkInsertLog::GetOid() const { return oid_; }
+
+pageid_t BulkInsertLog::GetPageId() const { return page_id_; }
+
+std::string BulkInsertLog::ToString() const {
+  return fmt::format("BulkInsertLog\t\t[{}\toid: {}\tprev_page_id: {}\tpage_id: {}\trecord_count: {}\tpage_size: {}]",
+                     LogRecord::ToString(), oid_, prev_page_id_, page_id_, record_count_, page_data_.size());
+}
+
+}  // namespace huadb
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 批量导入的整页插入日志，保存追加到表末尾的新页面的完整内容，页面中 [0, record_count) 号槽位的记录由该事务插入
+// 页面追加后即可被其他事务插入记录，撤销时只删除该范围内的记录
+class BulkInsertLog : public LogRecord {
+ public:
+  BulkInsertLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t prev_page_id, pageid_t page_id,
+                slotid_t record_count, std::vector<char> page_data);
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<BulkInsertLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) override;
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t prev_page_id_;
+  pageid_t page_id_;
+  slotid_t record_count_;        // 导入的记录数
+  std::vector<char> page_data_;  // 页面内容
+};
+
+}  // namespace huadb
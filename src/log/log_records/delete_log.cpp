@@ -1,4 +1,6 @@
 #include "log/log_records/delete_log.h"
+#include "table/pax_page.h"
+#include "table/table.h"
 #include "table/table_page.h"
 
 
@@ -48,6 +50,11 @@ void DeleteLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_
 
   auto database_oid = catalog.GetDatabaseOid(oid_);
   auto page = buffer_pool.GetPage(database_oid, oid_, page_id_);
+  auto table = catalog.GetTable(oid_);
+  if (table->GetLayout() == TableLayout::PAX) {
+    PaxPage(page, table->GetColumnList()).UndoDeleteRecord(slot_id_);
+    return;
+  }
   TablePage table_page(page);
 
   table_page.UndoDeleteRecord(slot_id_);
@@ -63,6 +70,11 @@ void DeleteLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_
 
   auto database_oid = catalog.GetDatabaseOid(oid_);
   auto page = buffer_pool.GetPage(database_oid, oid_, page_id_);
+  auto table = catalog.GetTable(oid_);
+  if (table->GetLayout() == TableLayout::PAX) {
+    PaxPage(page, table->GetColumnList()).DeleteRecord(slot_id_, xid_);
+    return;
+  }
   TablePage table_page(page);
 
   table_page.DeleteRecord(slot_id_, xid_);
@@ -0,0 +1,80 @@
+#include "log/log_records/index_delete_log.h"
+
+#include "index/index_page.h"
+
+namespace huadb {
+
+IndexDeleteLog::IndexDeleteLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, db_size_t position,
+                               db_size_t entry_size)
+    : LogRecord(LogType::INDEX_DELETE, lsn, xid, prev_lsn),
+      oid_(oid),
+      page_id_(page_id),
+      position_(position),
+      entry_size_(entry_size) {
+  size_ += sizeof(oid_) + sizeof(page_id_) + sizeof(position_) + sizeof(entry_size_);
+}
+
+size_t IndexDeleteLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  memcpy(data + offset, &position_, sizeof(position_));
+  offset += sizeof(position_);
+  memcpy(data + offset, &entry_size_, sizeof(entry_size_));
+  offset += sizeof(entry_size_);
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<IndexDeleteLog> IndexDeleteLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_id;
+  db_size_t position, entry_size;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  memcpy(&position, data + offset, sizeof(position));
+  offset += sizeof(position);
+  memcpy(&entry_size, data + offset, sizeof(entry_size));
+  offset += sizeof(entry_size);
+  return std::make_shared<IndexDeleteLog>(lsn, xid, prev_lsn, oid, page_id, position, entry_size);
+}
+
+void IndexDeleteLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) {
+  // 与 VacuumLog 相同，清理回收的内容无需恢复
+}
+
+void IndexDeleteLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该索引已经被删除，无需 redo
+  if (!catalog.IndexExists(oid_)) {
+    return;
+  }
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  IndexPage index_page(buffer_pool.GetPage(db_oid, oid_, page_id_));
+  if (index_page.GetPageLSN() >= lsn_) {
+    return;
+  }
+  index_page.DeleteEntry(position_, entry_size_);
+  index_page.SetPageLSN(lsn_);
+}
+
+oid_t IndexDeleteLog::GetOid() const { return oid_; }
+
+pageid_t IndexDeleteLog::GetPageId() const { return page_id_; }
+
+std::string IndexDeleteLog::ToString() const {
+  return fmt::format("IndexDeleteLog\t\t[{}\toid: {}\tpage_id: {}\tposition: {}\tentry_size: {}]",
+                     LogRecord::ToString(), oid_, page_id_, position_, entry_size_);
+}
+
+}  // namespace huadb
@@ -0,0 +1,85 @@
+#include "log/log_records/index_insert_log.h"
+
+#include "index/index_page.h"
+
+namespace huadb {
+
+IndexInsertLog::IndexInsertLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, db_size_t position,
+                               std::vector<char> entry)
+    : LogRecord(LogType::INDEX_INSERT, lsn, xid, prev_lsn),
+      oid_(oid),
+      page_id_(page_id),
+      position_(position),
+      entry_(std::move(entry)) {
+  size_ += sizeof(oid_) + sizeof(page_id_) + sizeof(position_) + sizeof(db_size_t) + entry_.size();
+}
+
+size_t IndexInsertLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  memcpy(data + offset, &position_, sizeof(position_));
+  offset += sizeof(position_);
+  db_size_t entry_size = entry_.size();
+  memcpy(data + offset, &entry_size, sizeof(entry_size));
+  offset += sizeof(entry_size);
+  memcpy(data + offset, entry_.data(), entry_size);
+  offset += entry_size;
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<IndexInsertLog> IndexInsertLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_id;
+  db_size_t position, entry_size;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  memcpy(&position, data + offset, sizeof(position));
+  offset += sizeof(position);
+  memcpy(&entry_size, data + offset, sizeof(entry_size));
+  offset += sizeof(entry_size);
+  std::vector<char> entry(data + offset, data + offset + entry_size);
+  offset += entry_size;
+  return std::make_shared<IndexInsertLog>(lsn, xid, prev_lsn, oid, page_id, position, std::move(entry));
+}
+
+void IndexInsertLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) {
+  // 索引项不随事务回滚删除，回滚的插入成为失效版本，由清理删除对应的索引项
+}
+
+void IndexInsertLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该索引已经被删除，无需 redo
+  if (!catalog.IndexExists(oid_)) {
+    return;
+  }
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  IndexPage index_page(buffer_pool.GetPage(db_oid, oid_, page_id_));
+  if (index_page.GetPageLSN() >= lsn_) {
+    return;
+  }
+  index_page.InsertEntry(position_, entry_.data(), entry_.size());
+  index_page.SetPageLSN(lsn_);
+}
+
+oid_t IndexInsertLog::GetOid() const { return oid_; }
+
+pageid_t IndexInsertLog::GetPageId() const { return page_id_; }
+
+std::string IndexInsertLog::ToString() const {
+  return fmt::format("IndexInsertLog\t\t[{}\toid: {}\tpage_id: {}\tposition: {}\tentry_size: {}]",
+                     LogRecord::ToString(), oid_, page_id_, position_, entry_.size());
+}
+
+}  // namespace huadb
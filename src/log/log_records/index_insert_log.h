@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 索引叶节点中插入一个索引项的日志，不引起节点分裂
+class IndexInsertLog : public LogRecord {
+ public:
+  IndexInsertLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, db_size_t position,
+                 std::vector<char> entry);
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<IndexInsertLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) override;
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_id_;
+  db_size_t position_;       // 索引项在节点中的位置
+  std::vector<char> entry_;  // 索引项内容
+};
+
+}  // namespace huadb
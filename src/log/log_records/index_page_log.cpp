@@ -0,0 +1,79 @@
+#include "log/log_records/index_page_log.h"
+
+#include "index/index_page.h"
+
+namespace huadb {
+
+IndexPageLog::IndexPageLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id,
+                           std::vector<char> page_data)
+    : LogRecord(LogType::INDEX_PAGE, lsn, xid, prev_lsn),
+      oid_(oid),
+      page_id_(page_id),
+      page_data_(std::move(page_data)) {
+  size_ += sizeof(oid_) + sizeof(page_id_) + sizeof(db_size_t) + page_data_.size();
+}
+
+size_t IndexPageLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  db_size_t page_size = page_data_.size();
+  memcpy(data + offset, &page_size, sizeof(page_size));
+  offset += sizeof(page_size);
+  memcpy(data + offset, page_data_.data(), page_size);
+  offset += page_size;
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<IndexPageLog> IndexPageLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_id;
+  db_size_t page_size;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  memcpy(&page_size, data + offset, sizeof(page_size));
+  offset += sizeof(page_size);
+  std::vector<char> page_data(data + offset, data + offset + page_size);
+  offset += page_size;
+  return std::make_shared<IndexPageLog>(lsn, xid, prev_lsn, oid, page_id, std::move(page_data));
+}
+
+void IndexPageLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) {
+  // 节点分裂不随事务回滚撤销，分裂后的树中仍包含所有索引项
+}
+
+void IndexPageLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该索引已经被删除，无需 redo
+  if (!catalog.IndexExists(oid_)) {
+    return;
+  }
+  // 与 BulkInsertLog 相同，用日志中的内容覆盖页面，分裂产生的新页面可能尚未写入磁盘
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  auto page = buffer_pool.NewPage(db_oid, oid_, page_id_);
+  memcpy(page->GetData(), page_data_.data(), page_data_.size());
+  // 元信息页面的 page_lsn 与 IndexPage 位于相同位置
+  IndexPage(page).SetPageLSN(lsn_);
+}
+
+oid_t IndexPageLog::GetOid() const { return oid_; }
+
+pageid_t IndexPageLog::GetPageId() const { return page_id_; }
+
+std::string IndexPageLog::ToString() const {
+  return fmt::format("IndexPageLog\t\t[{}\toid: {}\tpage_id: {}\tpage_size: {}]", LogRecord::ToString(), oid_,
+                     page_id_, page_data_.size());
+}
+
+}  // namespace huadb
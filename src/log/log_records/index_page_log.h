@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 索引页面的整页日志，节点分裂时记录每个修改页面的完整内容
+class IndexPageLog : public LogRecord {
+ public:
+  IndexPageLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, std::vector<char> page_data);
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<IndexPageLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) override;
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_id_;
+  std::vector<char> page_data_;  // 页面内容
+};
+
+}  // namespace huadb
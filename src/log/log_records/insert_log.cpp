@@ -1,4 +1,6 @@
 #include "log/log_records/insert_log.h"
+#include "table/pax_page.h"
+#include "table/table.h"
 #include "table/table_page.h"
 
 namespace huadb {
@@ -76,6 +78,11 @@ void InsertLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_
 
   auto database_oid = catalog.GetDatabaseOid(oid_);
   auto page = buffer_pool.GetPage(database_oid, oid_, page_id_);
+  auto table = catalog.GetTable(oid_);
+  if (table->GetLayout() == TableLayout::PAX) {
+    PaxPage(page, table->GetColumnList()).DeleteRecord(slot_id_, xid_);
+    return;
+  }
   TablePage table_page(page);
 
   table_page.DeleteRecord(slot_id_, xid_);
@@ -91,6 +98,12 @@ void InsertLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_
 
   auto database_oid = catalog.GetDatabaseOid(oid_);
   auto page = buffer_pool.GetPage(database_oid, oid_, page_id_);
+  auto table = catalog.GetTable(oid_);
+  if (table->GetLayout() == TableLayout::PAX) {
+    // PAX 表的插入日志保存行存格式的记录，page_offset_ 无效
+    PaxPage(page, table->GetColumnList()).RedoInsertRecord(slot_id_, record_);
+    return;
+  }
   TablePage table_page(page);
 
   table_page.RedoInsertRecord(slot_id_, record_, page_offset_, record_size_);
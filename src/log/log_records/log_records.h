@@ -2,9 +2,15 @@
 
 #include "log/log_records/begin_checkpoint_log.h"
 #include "log/log_records/begin_log.h"
+#include "log/log_records/bulk_insert_log.h"
 #include "log/log_records/commit_log.h"
 #include "log/log_records/delete_log.h"
 #include "log/log_records/end_checkpoint_log.h"
+#include "log/log_records/index_delete_log.h"
+#include "log/log_records/index_insert_log.h"
+#include "log/log_records/index_page_log.h"
 #include "log/log_records/insert_log.h"
 #include "log/log_records/new_page_log.h"
 #include "log/log_records/rollback_log.h"
+#include "log/log_records/update_log.h"
+#include "log/log_records/vacuum_log.h"
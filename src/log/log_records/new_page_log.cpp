@@ -1,4 +1,6 @@
 #include "log/log_records/new_page_log.h"
+#include "table/pax_page.h"
+#include "table/table.h"
 #include "table/table_page.h"
 
 namespace huadb {
@@ -75,8 +77,14 @@ void NewPageLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log
   }
 
   auto current_page = buffer_pool.NewPage(database_oid, oid_, page_id_);
+  auto table = catalog.GetTable(oid_);
+  if (table->GetLayout() == TableLayout::PAX) {
+    PaxPage(current_page, table->GetColumnList()).Init();
+  } else {
+    TablePage(current_page).Init();
+  }
+  // PAX 页面的 next_page 与 TablePage 位于相同位置
   TablePage current_table_page(current_page);
-  current_table_page.Init();
 
   current_table_page.SetNextPageId(next_page_id);
 }
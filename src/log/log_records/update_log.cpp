@@ -0,0 +1,108 @@
+#include "log/log_records/update_log.h"
+
+#include "table/table_page.h"
+
+namespace huadb {
+
+UpdateLog::UpdateLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, slotid_t old_slot_id,
+                     cid_t old_cid, slotid_t new_slot_id, db_size_t page_offset, db_size_t record_size, char *record)
+    : LogRecord(LogType::UPDATE, lsn, xid, prev_lsn),
+      oid_(oid),
+      page_id_(page_id),
+      old_slot_id_(old_slot_id),
+      old_cid_(old_cid),
+      new_slot_id_(new_slot_id),
+      page_offset_(page_offset),
+      record_size_(record_size) {
+  record_ = new char[record_size_];
+  memcpy(record_, record, record_size_);
+  size_ += sizeof(oid_) + sizeof(page_id_) + sizeof(old_slot_id_) + sizeof(old_cid_) + sizeof(new_slot_id_) +
+           sizeof(page_offset_) + sizeof(record_size_) + record_size_;
+}
+
+UpdateLog::~UpdateLog() { delete[] record_; }
+
+size_t UpdateLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  memcpy(data + offset, &old_slot_id_, sizeof(old_slot_id_));
+  offset += sizeof(old_slot_id_);
+  memcpy(data + offset, &old_cid_, sizeof(old_cid_));
+  offset += sizeof(old_cid_);
+  memcpy(data + offset, &new_slot_id_, sizeof(new_slot_id_));
+  offset += sizeof(new_slot_id_);
+  memcpy(data + offset, &page_offset_, sizeof(page_offset_));
+  offset += sizeof(page_offset_);
+  memcpy(data + offset, &record_size_, sizeof(record_size_));
+  offset += sizeof(record_size_);
+  memcpy(data + offset, record_, record_size_);
+  offset += record_size_;
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<UpdateLog> UpdateLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_id;
+  slotid_t old_slot_id, new_slot_id;
+  cid_t old_cid;
+  db_size_t page_offset, record_size;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  memcpy(&old_slot_id, data + offset, sizeof(old_slot_id));
+  offset += sizeof(old_slot_id);
+  memcpy(&old_cid, data + offset, sizeof(old_cid));
+  offset += sizeof(old_cid);
+  memcpy(&new_slot_id, data + offset, sizeof(new_slot_id));
+  offset += sizeof(new_slot_id);
+  memcpy(&page_offset, data + offset, sizeof(page_offset));
+  offset += sizeof(page_offset);
+  memcpy(&record_size, data + offset, sizeof(record_size));
+  offset += sizeof(record_size);
+  // 构造函数会复制记录内容，直接引用日志缓冲区即可
+  return std::make_shared<UpdateLog>(lsn, xid, prev_lsn, oid, page_id, old_slot_id, old_cid, new_slot_id, page_offset,
+                                     record_size, const_cast<char *>(data + offset));
+}
+
+void UpdateLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) {
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  auto page = buffer_pool.GetPage(db_oid, oid_, page_id_);
+  TablePage table_page(page);
+  table_page.UndoUpdateRecord(old_slot_id_, old_cid_, new_slot_id_, xid_);
+}
+
+void UpdateLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该表已经被删除，无需 redo
+  if (!catalog.TableExists(oid_)) {
+    return;
+  }
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  auto page = buffer_pool.GetPage(db_oid, oid_, page_id_);
+  TablePage table_page(page);
+  table_page.RedoUpdateRecord(old_slot_id_, xid_, new_slot_id_, record_, page_offset_, record_size_);
+}
+
+oid_t UpdateLog::GetOid() const { return oid_; }
+
+pageid_t UpdateLog::GetPageId() const { return page_id_; }
+
+std::string UpdateLog::ToString() const {
+  return fmt::format(
+      "UpdateLog\t\t[{}\toid: {}\tpage_id: {}\told_slot_id: {}\told_cid: {}\tnew_slot_id: {}\tpage_offset: {}\t"
+      "record_size: {}]",
+      LogRecord::ToString(), oid_, page_id_, old_slot_id_, old_cid_, new_slot_id_, page_offset_, record_size_);
+}
+
+}  // namespace huadb
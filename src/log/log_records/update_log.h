@@ -0,0 +1,36 @@
+#pragma once
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 页内更新的日志，旧版本和新版本位于同一页面，代替一条删除日志和一条插入日志
+class UpdateLog : public LogRecord {
+ public:
+  UpdateLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, slotid_t old_slot_id, cid_t old_cid,
+            slotid_t new_slot_id, db_size_t page_offset, db_size_t record_size, char *record);
+  ~UpdateLog();
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<UpdateLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) override;
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_id_;
+  slotid_t old_slot_id_;
+  cid_t old_cid_;  // 旧版本的 cid 字段更新后指向新版本，回滚时需要恢复
+  slotid_t new_slot_id_;
+  db_size_t page_offset_;
+  db_size_t record_size_;
+  char *record_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,84 @@
+#include "log/log_records/vacuum_log.h"
+
+#include "fmt/ranges.h"
+#include "table/pax_page.h"
+#include "table/table.h"
+#include "table/table_page.h"
+
+namespace huadb {
+
+VacuumLog::VacuumLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id,
+                     std::vector<slotid_t> slot_ids)
+    : LogRecord(LogType::VACUUM, lsn, xid, prev_lsn), oid_(oid), page_id_(page_id), slot_ids_(std::move(slot_ids)) {
+  size_ += sizeof(oid_) + sizeof(page_id_) + sizeof(db_size_t) + sizeof(slotid_t) * slot_ids_.size();
+}
+
+size_t VacuumLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  db_size_t slot_count = slot_ids_.size();
+  memcpy(data + offset, &slot_count, sizeof(slot_count));
+  offset += sizeof(slot_count);
+  memcpy(data + offset, slot_ids_.data(), sizeof(slotid_t) * slot_count);
+  offset += sizeof(slotid_t) * slot_count;
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<VacuumLog> VacuumLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_id;
+  db_size_t slot_count;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  memcpy(&slot_count, data + offset, sizeof(slot_count));
+  offset += sizeof(slot_count);
+  std::vector<slotid_t> slot_ids(slot_count);
+  memcpy(slot_ids.data(), data + offset, sizeof(slotid_t) * slot_count);
+  offset += sizeof(slotid_t) * slot_count;
+  return std::make_shared<VacuumLog>(lsn, xid, prev_lsn, oid, page_id, std::move(slot_ids));
+}
+
+void VacuumLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) {
+  // 被回收的记录对所有事务均不可见，清理事务回滚时无需恢复
+}
+
+void VacuumLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该表已经被删除，无需 redo
+  if (!catalog.TableExists(oid_)) {
+    return;
+  }
+  // 页面整理过程是确定的，重做得到与原操作相同的页面布局，之后的插入日志中的页内偏移仍然有效
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  auto page = buffer_pool.GetPage(db_oid, oid_, page_id_);
+  auto table = catalog.GetTable(oid_);
+  if (table->GetLayout() == TableLayout::PAX) {
+    PaxPage(page, table->GetColumnList()).Compact(slot_ids_);
+    return;
+  }
+  TablePage table_page(page);
+  table_page.Compact(slot_ids_);
+}
+
+oid_t VacuumLog::GetOid() const { return oid_; }
+
+pageid_t VacuumLog::GetPageId() const { return page_id_; }
+
+std::string VacuumLog::ToString() const {
+  return fmt::format("VacuumLog\t\t[{}\toid: {}\tpage_id: {}\tslot_ids: {}]", LogRecord::ToString(), oid_, page_id_,
+                     fmt::join(slot_ids_, ","));
+}
+
+}  // namespace huadb
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 清理页面的日志，只需重做，无需回滚
+class VacuumLog : public LogRecord {
+ public:
+  VacuumLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, std::vector<slotid_t> slot_ids);
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<VacuumLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) override;
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_id_;
+  std::vector<slotid_t> slot_ids_;  // 被回收的记录的槽号
+};
+
+}  // namespace huadb
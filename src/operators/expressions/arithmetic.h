@@ -24,6 +24,11 @@ class Arithmetic : public OperatorExpression {
     Value rhs = children_[1]->EvaluateJoin(left, right);
     return Compute(lhs, rhs);
   }
+  Value EvaluateTuple(const TupleView &tuple) override {
+    Value lhs = children_[0]->EvaluateTuple(tuple);
+    Value rhs = children_[1]->EvaluateTuple(tuple);
+    return Compute(lhs, rhs);
+  }
 
   std::string ToString() const override { return fmt::format("{} {} {}", children_[0], type_, children_[1]); }
 
@@ -14,6 +14,7 @@ class ColumnValue : public OperatorExpression {
         OperatorExpression(OperatorExpressionType::COLUMN_VALUE, {}, col_type, name, size),
         is_left_(is_left) {}
   Value Evaluate(std::shared_ptr<const Record> record) override { return record->GetValue(col_idx_); }
+  Value EvaluateTuple(const TupleView &tuple) override { return tuple.GetValue(col_idx_); }
   Value EvaluateJoin(std::shared_ptr<const Record> left, std::shared_ptr<const Record> right) override {
     if (is_left_) {
       return left->GetValue(col_idx_);
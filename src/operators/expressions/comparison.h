@@ -40,6 +40,11 @@ class Comparison : public OperatorExpression {
     Value rhs = children_[1]->EvaluateJoin(left, right);
     return Compute(lhs, rhs);
   }
+  Value EvaluateTuple(const TupleView &tuple) override {
+    Value lhs = children_[0]->EvaluateTuple(tuple);
+    Value rhs = children_[1]->EvaluateTuple(tuple);
+    return Compute(lhs, rhs);
+  }
   std::string ToString() const override { return fmt::format("{} {} {}", children_[0], type_, children_[1]); }
   ComparisonType GetComparisonType() { return type_; }
 
@@ -82,7 +87,7 @@ class Comparison : public OperatorExpression {
             break;
           case Type::CHAR:
           case Type::VARCHAR:
-            in_list = lhs.GetValue<std::string>() == value.GetValue<std::string>();
+            in_list = lhs.GetValue<std::string_view>() == value.GetValue<std::string_view>();
             break;
           default:
             throw DbException("Type unsupported for comparison operation (in)");
@@ -140,7 +145,7 @@ class Comparison : public OperatorExpression {
           }
         case Type::CHAR:
         case Type::VARCHAR:
-          return Value(DoOperation(lhs.GetValue<std::string>(), rhs.GetValue<std::string>()));
+          return Value(DoOperation(lhs.GetValue<std::string_view>(), rhs.GetValue<std::string_view>()));
         default:
           throw DbException("Type unsupported for comparison operation");
       }
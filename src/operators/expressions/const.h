@@ -10,6 +10,7 @@ class Const : public OperatorExpression {
       : OperatorExpression(OperatorExpressionType::CONST, {}, value.GetType(), "<no_name>", value.GetSize()),
         value_(value) {}
   Value Evaluate(std::shared_ptr<const Record> record) override { return value_; }
+  Value EvaluateTuple(const TupleView &tuple) override { return value_; }
   Value EvaluateJoin(std::shared_ptr<const Record> left, std::shared_ptr<const Record> right) override {
     return value_;
   }
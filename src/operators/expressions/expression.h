@@ -8,6 +8,7 @@
 #include "common/value.h"
 #include "fmt/format.h"
 #include "table/record.h"
+#include "table/tuple_view.h"
 
 namespace huadb {
 
@@ -38,6 +39,8 @@ class OperatorExpression {
   virtual Value EvaluateJoin(std::shared_ptr<const Record> left, std::shared_ptr<const Record> right) {
     throw DbException("EvaluateJoin method not implemented");
   }
+  // 直接在页面中的记录上求值，未实现的表达式物化记录后求值
+  virtual Value EvaluateTuple(const TupleView &tuple) { return Evaluate(tuple.Materialize()); }
   virtual std::string ToString() const { return "OperatorExpression"; }
 
   OperatorExpressionType GetExprType() const { return expr_type_; }
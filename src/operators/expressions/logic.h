@@ -40,6 +40,15 @@ class Logic : public OperatorExpression {
       return Compute(lhs, rhs);
     }
   }
+  Value EvaluateTuple(const TupleView &tuple) override {
+    if (logic_type_ == LogicType::NOT) {
+      return children_[0]->EvaluateTuple(tuple).Not();
+    } else {
+      Value lhs = children_[0]->EvaluateTuple(tuple);
+      Value rhs = children_[1]->EvaluateTuple(tuple);
+      return Compute(lhs, rhs);
+    }
+  }
 
   std::string ToString() const override {
     if (logic_type_ == LogicType::NOT) {
@@ -26,6 +26,14 @@ class NullTest : public OperatorExpression {
       return Value(!value.IsNull());
     }
   }
+  Value EvaluateTuple(const TupleView &tuple) override {
+    auto value = arg_->EvaluateTuple(tuple);
+    if (is_null_) {
+      return Value(value.IsNull());
+    } else {
+      return Value(!value.IsNull());
+    }
+  }
   std::string ToString() const override { return arg_->ToString(); }
   bool is_null_;
   std::shared_ptr<OperatorExpression> arg_;
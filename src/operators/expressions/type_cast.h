@@ -26,6 +26,14 @@ class TypeCast : public OperatorExpression {
       throw DbException("Type unsupported for cast operation");
     }
   }
+  Value EvaluateTuple(const TupleView &tuple) override {
+    auto value = arg_->EvaluateTuple(tuple);
+    if (cast_type_ == Type::BOOL) {
+      return value.CastAsBool();
+    } else {
+      throw DbException("Type unsupported for cast operation");
+    }
+  }
   std::string ToString() const override { return arg_->ToString(); }
   Type cast_type_;
   std::shared_ptr<OperatorExpression> arg_;
@@ -1,12 +1,68 @@
 #pragma once
 
+#include <optional>
+#include <vector>
+
+#include "fmt/format.h"
+#include "index/index.h"
 #include "operators/operator.h"
 
 namespace huadb {
 
+// 通过索引获取键在 range 中的记录，再到表中判断可见性
+// 仅索引扫描时上层只需要索引的键列和附加列，索引项所在页面全部可见时直接由索引项构造记录，不访问表
 class IndexScanOperator : public Operator {
  public:
-  IndexScanOperator();
+  IndexScanOperator(std::shared_ptr<ColumnList> column_list, oid_t table_oid, std::string table_name,
+                    std::optional<std::string> alias, bool has_lock, oid_t index_oid, std::string index_name,
+                    IndexRange range)
+      : Operator(OperatorType::INDEXSCAN, std::move(column_list), {}),
+        table_oid_(table_oid),
+        table_name_(std::move(table_name)),
+        alias_(std::move(alias)),
+        has_lock_(has_lock),
+        index_oid_(index_oid),
+        index_name_(std::move(index_name)),
+        range_(std::move(range)) {}
+  std::string ToString(size_t indent_num = 0) const override {
+    auto name = index_only_ ? "IndexOnlyScan" : "IndexScan";
+    if (alias_) {
+      return fmt::format("{}{}: {} {} using {}", std::string(indent_num * 2, ' '), name, table_name_, *alias_,
+                         index_name_);
+    } else {
+      return fmt::format("{}{}: {} using {}", std::string(indent_num * 2, ' '), name, table_name_, index_name_);
+    }
+  }
+
+  oid_t GetTableOid() const { return table_oid_; }
+  const std::string &GetTableNameOrAlias() const {
+    if (alias_) {
+      return *alias_;
+    } else {
+      return table_name_;
+    }
+  }
+  const std::string &GetTableName() const { return table_name_; }
+  bool HasLock() const { return has_lock_; }
+  oid_t GetIndexOid() const { return index_oid_; }
+  const std::string &GetIndexName() const { return index_name_; }
+  const IndexRange &GetRange() const { return range_; }
+  // 上层算子需要的列，为空时需要所有列
+  const std::vector<bool> &GetProjection() const { return projection_; }
+  void SetProjection(std::vector<bool> projection) { projection_ = std::move(projection); }
+  bool IsIndexOnly() const { return index_only_; }
+  void SetIndexOnly(bool index_only) { index_only_ = index_only; }
+
+ private:
+  oid_t table_oid_;
+  std::string table_name_;
+  std::optional<std::string> alias_;
+  bool has_lock_;
+  oid_t index_oid_;
+  std::string index_name_;
+  IndexRange range_;
+  std::vector<bool> projection_;
+  bool index_only_ = false;
 };
 
 }  // namespace huadb
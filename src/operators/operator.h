@@ -12,6 +12,7 @@ enum class OperatorType {
   DELETE,
   FILTER,
   HASHJOIN,
+  INDEXSCAN,
   INSERT,
   LIMIT,
   LOCK_ROWS,
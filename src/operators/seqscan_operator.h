@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include "fmt/format.h"
 #include "operators/operator.h"
@@ -35,13 +36,18 @@ class SeqScanOperator : public Operator {
     }
   }
   const std::string &GetTableName() const { return table_name_; }
+  const std::optional<std::string> &GetAlias() const { return alias_; }
   bool HasLock() const { return has_lock_; }
+  // 上层算子需要的列，为空时需要所有列
+  const std::vector<bool> &GetProjection() const { return projection_; }
+  void SetProjection(std::vector<bool> projection) { projection_ = std::move(projection); }
 
  private:
   oid_t table_oid_;
   std::string table_name_;
   std::optional<std::string> alias_;
   bool has_lock_;
+  std::vector<bool> projection_;
 };
 
 }  // namespace huadb
@@ -1,9 +1,16 @@
+#include <algorithm>
 #include <iostream>
 #include "optimizer/optimizer.h"
+#include "operators/aggregate_operator.h"
+#include "operators/expressions/column_value.h"
+#include "operators/expressions/const.h"
 #include "operators/filter_operator.h"
+#include "operators/index_scan_operator.h"
 #include "operators/expressions/logic.h"
 #include "operators/expressions/comparison.h"
 #include "operators/nested_loop_join_operator.h"
+#include "operators/orderby_operator.h"
+#include "operators/projection_operator.h"
 #include "operators/seqscan_operator.h"
 
 namespace huadb {
@@ -17,6 +24,8 @@ std::shared_ptr<Operator> Optimizer::Optimize(std::shared_ptr<Operator> plan) {
   plan = SplitPredicates(plan);
   plan = PushDown(plan);
   plan = ReorderJoin(plan);
+  plan = ChooseIndexScan(plan);
+  PruneScanColumns(plan, std::nullopt);
   return plan;
 }
 
@@ -302,4 +311,307 @@ std::shared_ptr<Operator> Optimizer::ReorderJoin(std::shared_ptr<Operator> plan)
   return plan;
 }
 
+// 列与常量的比较，常量在左侧时已交换两侧并翻转比较方向
+struct IndexCondition {
+  size_t col_idx_;
+  ComparisonType type_;
+  Value value_;
+};
+
+// 从 AND 连接的谓词中提取列与常量的比较
+static void CollectIndexConditions(const std::shared_ptr<OperatorExpression> &expr,
+                                   std::vector<IndexCondition> &conditions) {
+  if (expr->GetExprType() == OperatorExpressionType::LOGIC) {
+    auto logic = std::dynamic_pointer_cast<Logic>(expr);
+    if (logic->GetLogicType() == LogicType::AND) {
+      CollectIndexConditions(logic->children_[0], conditions);
+      CollectIndexConditions(logic->children_[1], conditions);
+    }
+    return;
+  }
+  if (expr->GetExprType() != OperatorExpressionType::COMPARISON) {
+    return;
+  }
+  auto comparison = std::dynamic_pointer_cast<Comparison>(expr);
+  auto lhs = comparison->children_[0];
+  auto rhs = comparison->children_[1];
+  bool swapped = false;
+  if (lhs->GetExprType() == OperatorExpressionType::CONST &&
+      rhs->GetExprType() == OperatorExpressionType::COLUMN_VALUE) {
+    std::swap(lhs, rhs);
+    swapped = true;
+  }
+  if (lhs->GetExprType() != OperatorExpressionType::COLUMN_VALUE ||
+      rhs->GetExprType() != OperatorExpressionType::CONST) {
+    return;
+  }
+  auto type = comparison->GetComparisonType();
+  switch (type) {
+    case ComparisonType::EQUAL:
+      break;
+    case ComparisonType::LESS:
+      type = swapped ? ComparisonType::GREATER : type;
+      break;
+    case ComparisonType::LESS_EQUAL:
+      type = swapped ? ComparisonType::GREATER_EQUAL : type;
+      break;
+    case ComparisonType::GREATER:
+      type = swapped ? ComparisonType::LESS : type;
+      break;
+    case ComparisonType::GREATER_EQUAL:
+      type = swapped ? ComparisonType::LESS_EQUAL : type;
+      break;
+    default:
+      return;
+  }
+  conditions.push_back({std::dynamic_pointer_cast<ColumnValue>(lhs)->GetColumnIndex(), type,
+                        std::dynamic_pointer_cast<Const>(rhs)->value_});
+}
+
+// 将常量转换为索引键列的类型，无法无损转换时返回空
+// 超过列最大长度的字符串无法放入定长的索引项，也不可能与列值相等，不用于索引扫描
+static std::optional<Value> CastToKey(const Value &value, const ColumnDefinition &key_column) {
+  auto key_type = key_column.type_;
+  if (value.IsNull()) {
+    return std::nullopt;
+  }
+  if (TypeUtil::IsString(value.GetType()) && TypeUtil::IsString(key_type)) {
+    auto str = value.GetValue<std::string>();
+    if (str.size() > key_column.max_size_) {
+      return std::nullopt;
+    }
+    return value.GetType() == key_type ? value : Value(std::move(str), key_type);
+  }
+  if (value.GetType() == key_type) {
+    return value;
+  }
+  if (value.GetType() == Type::INT && key_type == Type::DOUBLE) {
+    return Value(static_cast<double>(value.GetValue<int32_t>()));
+  }
+  return std::nullopt;
+}
+
+// 根据比较条件计算索引的扫描范围，返回值越大越优先，没有可用条件时返回 0
+// B+ 树从第一个键列开始，每个有等值条件的键列计 2 分并加入范围的前缀，之后第一个没有等值条件的键列有范围条件时再计 1 分
+// 哈希索引只在所有键列都有等值条件时可用，单列时计 3 分，优先于单列 B+ 树的等值查找
+static int BuildIndexRange(const std::vector<IndexCondition> &conditions, const Index &index, IndexRange &range) {
+  IndexKey prefix;
+  std::optional<Value> lower;
+  bool lower_inclusive = true;
+  std::optional<Value> upper;
+  bool upper_inclusive = true;
+  for (const auto &[col_idx, key_column] : index.GetKeyColumns()) {
+    std::optional<Value> equal;
+    for (const auto &condition : conditions) {
+      if (condition.col_idx_ == col_idx && condition.type_ == ComparisonType::EQUAL) {
+        if ((equal = CastToKey(condition.value_, key_column))) {
+          break;
+        }
+      }
+    }
+    if (equal) {
+      prefix.push_back(std::move(*equal));
+      continue;
+    }
+    if (index.GetIndexType() == IndexType::HASH) {
+      return 0;
+    }
+    // 同一方向有多个条件时取最严格的一个
+    for (const auto &condition : conditions) {
+      if (condition.col_idx_ != col_idx) {
+        continue;
+      }
+      auto key = CastToKey(condition.value_, key_column);
+      if (!key) {
+        continue;
+      }
+      bool inclusive =
+          condition.type_ == ComparisonType::GREATER_EQUAL || condition.type_ == ComparisonType::LESS_EQUAL;
+      if (condition.type_ == ComparisonType::GREATER || condition.type_ == ComparisonType::GREATER_EQUAL) {
+        int result = lower ? Index::CompareKeys({*key}, {*lower}) : 1;
+        if (result > 0 || (result == 0 && !inclusive)) {
+          lower = key;
+          lower_inclusive = inclusive;
+        }
+      } else if (condition.type_ == ComparisonType::LESS || condition.type_ == ComparisonType::LESS_EQUAL) {
+        int result = upper ? Index::CompareKeys({*key}, {*upper}) : -1;
+        if (result < 0 || (result == 0 && !inclusive)) {
+          upper = key;
+          upper_inclusive = inclusive;
+        }
+      }
+    }
+    break;
+  }
+  if (index.GetIndexType() == IndexType::HASH) {
+    range.lower_ = range.upper_ = std::move(prefix);
+    return index.GetKeyColumns().size() == 1 ? 3 : 2 * static_cast<int>(index.GetKeyColumns().size());
+  }
+  if (prefix.empty() && !lower && !upper) {
+    return 0;
+  }
+  int score = 2 * static_cast<int>(prefix.size()) + (lower || upper ? 1 : 0);
+  if (!prefix.empty() || lower) {
+    range.lower_ = prefix;
+    if (lower) {
+      range.lower_->push_back(std::move(*lower));
+      range.lower_inclusive_ = lower_inclusive;
+    }
+  }
+  if (!prefix.empty() || upper) {
+    range.upper_ = std::move(prefix);
+    if (upper) {
+      range.upper_->push_back(std::move(*upper));
+      range.upper_inclusive_ = upper_inclusive;
+    }
+  }
+  return score;
+}
+
+std::shared_ptr<Operator> Optimizer::ChooseIndexScan(std::shared_ptr<Operator> plan) {
+  if (plan->GetType() != OperatorType::FILTER) {
+    for (auto &child : plan->children_) {
+      child = ChooseIndexScan(child);
+    }
+    return plan;
+  }
+  // 收集连续 Filter 节点中的比较条件，直到最下方的非 Filter 节点
+  std::vector<IndexCondition> conditions;
+  auto bottom_filter = plan;
+  while (true) {
+    CollectIndexConditions(std::dynamic_pointer_cast<FilterOperator>(bottom_filter)->predicate_, conditions);
+    if (bottom_filter->children_[0]->GetType() != OperatorType::FILTER) {
+      break;
+    }
+    bottom_filter = bottom_filter->children_[0];
+  }
+  auto &scan_child = bottom_filter->children_[0];
+  if (scan_child->GetType() != OperatorType::SEQSCAN) {
+    scan_child = ChooseIndexScan(scan_child);
+    return plan;
+  }
+  auto seqscan = std::dynamic_pointer_cast<SeqScanOperator>(scan_child);
+  std::shared_ptr<Index> best_index;
+  IndexRange best_range;
+  int best_score = 0;
+  for (const auto &index : catalog_.GetTableIndexes(seqscan->GetTableOid())) {
+    IndexRange range;
+    auto score = BuildIndexRange(conditions, *index, range);
+    if (score > best_score) {
+      best_index = index;
+      best_range = std::move(range);
+      best_score = score;
+    }
+  }
+  if (best_index != nullptr) {
+    scan_child = std::make_shared<IndexScanOperator>(
+        seqscan->column_list_, seqscan->GetTableOid(), seqscan->GetTableName(), seqscan->GetAlias(),
+        seqscan->HasLock(), best_index->GetOid(), catalog_.GetIndexName(best_index->GetOid()), std::move(best_range));
+  }
+  return plan;
+}
+
+// 将表达式引用的列加入 columns
+static void CollectColumns(const std::shared_ptr<OperatorExpression> &expr, std::vector<bool> &columns) {
+  if (expr->GetExprType() == OperatorExpressionType::COLUMN_VALUE) {
+    auto col_idx = std::dynamic_pointer_cast<ColumnValue>(expr)->GetColumnIndex();
+    if (col_idx >= columns.size()) {
+      columns.resize(col_idx + 1, false);
+    }
+    columns[col_idx] = true;
+  }
+  for (const auto &child : expr->children_) {
+    CollectColumns(child, columns);
+  }
+}
+
+// 为 PAX 表的扫描节点设置需要物化的列
+template <typename ScanOperator>
+static void SetScanProjection(Catalog &catalog, const std::shared_ptr<ScanOperator> &scan,
+                              std::optional<std::vector<bool>> required) {
+  auto table = catalog.GetTable(scan->GetTableOid());
+  if (!required || table->GetLayout() != TableLayout::PAX) {
+    return;
+  }
+  required->resize(table->GetColumnList().Length(), false);
+  if (std::find(required->begin(), required->end(), false) != required->end()) {
+    scan->SetProjection(std::move(*required));
+  }
+}
+
+void Optimizer::PruneScanColumns(const std::shared_ptr<Operator> &plan, std::optional<std::vector<bool>> required) {
+  // 只处理输出列与输入列一一对应或由表达式计算得到的单输入算子，其余算子的子节点需要所有列
+  switch (plan->GetType()) {
+    case OperatorType::PROJECTION: {
+      std::vector<bool> columns;
+      for (const auto &expr : std::dynamic_pointer_cast<ProjectionOperator>(plan)->exprs_) {
+        CollectColumns(expr, columns);
+      }
+      PruneScanColumns(plan->children_[0], std::move(columns));
+      return;
+    }
+    case OperatorType::AGGREGATE: {
+      auto aggregate = std::dynamic_pointer_cast<AggregateOperator>(plan);
+      std::vector<bool> columns;
+      for (const auto &expr : aggregate->group_bys_) {
+        CollectColumns(expr, columns);
+      }
+      for (const auto &expr : aggregate->aggregates_) {
+        CollectColumns(expr, columns);
+      }
+      PruneScanColumns(plan->children_[0], std::move(columns));
+      return;
+    }
+    case OperatorType::FILTER:
+      if (required) {
+        CollectColumns(std::dynamic_pointer_cast<FilterOperator>(plan)->predicate_, *required);
+      }
+      PruneScanColumns(plan->children_[0], std::move(required));
+      return;
+    case OperatorType::ORDERBY:
+      if (required) {
+        for (const auto &[type, expr] : std::dynamic_pointer_cast<OrderByOperator>(plan)->order_bys_) {
+          CollectColumns(expr, *required);
+        }
+      }
+      PruneScanColumns(plan->children_[0], std::move(required));
+      return;
+    case OperatorType::LIMIT:
+      PruneScanColumns(plan->children_[0], std::move(required));
+      return;
+    case OperatorType::SEQSCAN:
+      SetScanProjection(catalog_, std::dynamic_pointer_cast<SeqScanOperator>(plan), std::move(required));
+      return;
+    case OperatorType::INDEXSCAN: {
+      auto index_scan = std::dynamic_pointer_cast<IndexScanOperator>(plan);
+      // 需要的列都在索引的键列或附加列中时改为仅索引扫描，加锁的扫描需要访问表中的记录
+      if (required && !index_scan->HasLock()) {
+        auto index = catalog_.GetIndex(index_scan->GetIndexOid());
+        std::vector<bool> covered(required->size(), false);
+        auto cover = [&covered](const std::vector<IndexColumn> &columns) {
+          for (const auto &column : columns) {
+            if (column.col_idx_ < covered.size()) {
+              covered[column.col_idx_] = true;
+            }
+          }
+        };
+        cover(index->GetKeyColumns());
+        cover(index->GetIncludeColumns());
+        bool index_only = true;
+        for (size_t i = 0; i < required->size(); i++) {
+          index_only = index_only && (!(*required)[i] || covered[i]);
+        }
+        index_scan->SetIndexOnly(index_only);
+      }
+      SetScanProjection(catalog_, index_scan, std::move(required));
+      return;
+    }
+    default:
+      for (const auto &child : plan->children_) {
+        PruneScanColumns(child, std::nullopt);
+      }
+      return;
+  }
+}
+
 }  // namespace huadb
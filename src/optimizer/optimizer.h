@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <set>
 #include "catalog/catalog.h"
 #include "operators/operator.h"
@@ -25,6 +26,13 @@ class Optimizer {
 
   std::shared_ptr<Operator> ReorderJoin(std::shared_ptr<Operator> plan);
 
+  // 顺序扫描上方的过滤条件包含索引键与常量的比较时，将顺序扫描替换为索引扫描
+  // 等值比较优先，其次为范围比较，过滤节点保留在索引扫描上方，对取回的记录重新检查
+  std::shared_ptr<Operator> ChooseIndexScan(std::shared_ptr<Operator> plan);
+
+  // 计算 PAX 表的扫描节点需要物化的列，required 为上层对 plan 输出列的需求，为空时需要所有列
+  void PruneScanColumns(const std::shared_ptr<Operator> &plan, std::optional<std::vector<bool>> required);
+
   JoinOrderAlgorithm join_order_algorithm_;
   bool enable_projection_pushdown_;
   Catalog &catalog_;
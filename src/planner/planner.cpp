@@ -117,6 +117,12 @@ std::shared_ptr<Operator> Planner::PlanUpdate(const UpdateStatement &stmt) {
   for (const auto &update_expr : stmt.update_exprs_) {
     auto column = PlanColumnRef(*update_expr.first, {filter_node});
     auto expr = PlanExpression(*update_expr.second, {filter_node});
+    const auto &table_column = filter_node->OutputColumns().GetColumn(column->GetColumnIndex());
+    if (TypeUtil::IsString(expr->GetValueType()) && TypeUtil::IsString(table_column.type_)) {
+      if (expr->GetSize() > table_column.GetMaxSize()) {
+        throw DbException("Update value too long");
+      }
+    }
     update_exprs[column->GetColumnIndex()] = std::move(expr);
   }
   for (auto i = 0; i < update_exprs.size(); i++) {
@@ -0,0 +1,53 @@
+#include "storage/background_writer.h"
+
+#include <chrono>
+
+#include "common/exceptions.h"
+#include "storage/buffer_pool.h"
+
+namespace huadb {
+
+BackgroundWriter::BackgroundWriter(BufferPool &buffer_pool)
+    : buffer_pool_(buffer_pool), thread_(&BackgroundWriter::Work, this) {}
+
+BackgroundWriter::~BackgroundWriter() {
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void BackgroundWriter::SetDelay(size_t delay_ms) {
+  {
+    std::scoped_lock lock(mutex_);
+    delay_ms_ = delay_ms;
+  }
+  cv_.notify_all();
+}
+
+void BackgroundWriter::Work() {
+  std::unique_lock lock(mutex_);
+  while (!stop_) {
+    if (delay_ms_ == 0) {
+      cv_.wait(lock, [this] { return stop_ || delay_ms_ > 0; });
+      continue;
+    }
+    auto delay_ms = delay_ms_;
+    if (cv_.wait_for(lock, std::chrono::milliseconds(delay_ms), [this, delay_ms] {
+          return stop_ || delay_ms_ != delay_ms;
+        })) {
+      continue;
+    }
+    lock.unlock();
+    try {
+      buffer_pool_.CleanFrames();
+    } catch (DbException &e) {
+      // 写回失败的页面仍为脏页，淘汰时由前台写回
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace huadb
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace huadb {
+
+class BufferPool;
+
+// 后台写进程，每隔一段时间将即将被淘汰的脏页写回磁盘，使前台淘汰页面时无需等待写盘
+class BackgroundWriter {
+ public:
+  explicit BackgroundWriter(BufferPool &buffer_pool);
+  ~BackgroundWriter();
+
+  // 设置两轮写回之间的间隔（毫秒），0 表示暂停
+  void SetDelay(size_t delay_ms);
+
+ private:
+  void Work();
+
+  BufferPool &buffer_pool_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;  // 间隔被修改或需要停止
+  size_t delay_ms_ = 0;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+}  // namespace huadb
@@ -1,35 +1,121 @@
 #include "storage/buffer_pool.h"
 
-#include "common/constants.h"
+#include <algorithm>
+#include <cstring>
+
 #include "common/exceptions.h"
 #include "log/log_manager.h"
+#include "storage/background_writer.h"
+#include "storage/clock_buffer_strategy.h"
+#include "storage/lru_buffer_strategy.h"
+#include "storage/lru_k_buffer_strategy.h"
+#include "storage/prefetcher.h"
+#include "storage/two_queue_buffer_strategy.h"
 #include "table/table_page.h"
 
 namespace huadb {
 
-BufferPool::BufferPool(Disk &disk, LogManager &log_manager) : disk_(disk), log_manager_(log_manager) {
-  buffers_.reserve(BUFFER_SIZE);
-  hashmap_.reserve(BUFFER_SIZE);
-  buffer_strategy_ = std::make_unique<LRUBufferStrategy>();
+BufferPool::BufferPool(Disk &disk, LogManager &log_manager, size_t pool_size)
+    : disk_(disk), log_manager_(log_manager), pool_size_(pool_size) {
+  if (pool_size_ == 0) {
+    throw DbException("Buffer pool size must be positive");
+  }
+  ResetPartitions();
 }
 
+BufferPool::~BufferPool() = default;
+
 std::shared_ptr<Page> BufferPool::GetPage(oid_t db_oid, oid_t table_oid, pageid_t page_id) {
   if (page_id == NULL_PAGE_ID) {
     throw DbException("Invalid page id in BufferPool::GetPage");
   }
-  auto &buffers = (db_oid == SYSTEM_DATABASE_OID) ? systable_buffers_ : buffers_;
-  auto &hashmap = (db_oid == SYSTEM_DATABASE_OID) ? systable_hashmap_ : hashmap_;
-  auto entry = hashmap.find({table_oid, page_id});
-  if (entry == hashmap.end()) {
-    auto page = std::make_shared<Page>();
-    disk_.ReadPage(Disk::GetFilePath(db_oid, table_oid), page_id, page->GetData());
-    AddToBuffer(db_oid, table_oid, page_id, page);
+  if (db_oid == SYSTEM_DATABASE_OID) {
+    std::scoped_lock lock(systable_mutex_);
+    auto entry = systable_hashmap_.find({table_oid, page_id});
+    if (entry != systable_hashmap_.end()) {
+      return systable_buffers_[entry->second].page_;
+    }
+    auto page = std::make_shared<Page>(disk_.GetPageSize());
+    disk_.ReadPage(db_oid, table_oid, page_id, page->GetData());
+    systable_hashmap_[{table_oid, page_id}] = systable_buffers_.size();
+    systable_buffers_.push_back({db_oid, table_oid, page_id, page});
     return page;
-  } else {
-    if (db_oid != SYSTEM_DATABASE_OID) {
-      buffer_strategy_->Access(entry->second);
+  }
+  return FetchPage(db_oid, table_oid, page_id, false);
+}
+
+std::shared_ptr<Page> BufferPool::PrefetchPage(oid_t db_oid, oid_t table_oid, pageid_t page_id) {
+  if (page_id == NULL_PAGE_ID || db_oid == SYSTEM_DATABASE_OID) {
+    throw DbException("Invalid page in BufferPool::PrefetchPage");
+  }
+  return FetchPage(db_oid, table_oid, page_id, true);
+}
+
+size_t BufferPool::ReadAhead(oid_t db_oid, oid_t table_oid, pageid_t page_id) {
+  if (db_oid == SYSTEM_DATABASE_OID || page_id == NULL_PAGE_ID) {
+    return 0;
+  }
+  std::shared_lock pool_lock(pool_mutex_);
+  // 预读页面数不超过缓存的一半，避免预读的页面互相淘汰
+  auto page_count = std::min(read_ahead_pages_, pool_size_ / 2);
+  if (page_count == 0) {
+    return 0;
+  }
+  prefetcher_->Prefetch(db_oid, table_oid, page_id, page_count);
+  return page_count;
+}
+
+std::shared_ptr<Page> BufferPool::FetchPage(oid_t db_oid, oid_t table_oid, pageid_t page_id, bool prefetch) {
+  std::shared_lock pool_lock(pool_mutex_);
+  auto &partition = GetPartition(table_oid, page_id);
+  while (true) {
+    std::unique_lock lock(partition.mutex_);
+    auto &stats = partition.strategy_stats_[buffer_strategy_type_];
+    auto entry = partition.hashmap_.find({table_oid, page_id});
+    if (entry != partition.hashmap_.end()) {
+      auto frame_id = entry->second;
+      // 预读命中时不更新访问记录，页面的访问顺序由扫描决定
+      if (!prefetch) {
+        stats.hit_count_++;
+        partition.buffer_strategy_->Access(frame_id);
+      }
+      // 持有页面指针后页面不会被淘汰，可以释放分区锁后等待页面读入完成
+      auto page = partition.buffers_[frame_id].page_;
+      auto &latch = *partition.latches_[frame_id];
+      lock.unlock();
+      // 先释放帧锁再获取分区锁，与缺页时先分区锁后帧锁的加锁顺序保持一致
+      { std::shared_lock frame_lock(latch); }
+      lock.lock();
+      // 其他线程读入页面失败时，页面已从页表中移除，需要重新获取
+      entry = partition.hashmap_.find({table_oid, page_id});
+      if (entry != partition.hashmap_.end() && partition.buffers_[entry->second].page_ == page) {
+        return page;
+      }
+      continue;
+    }
+
+    if (prefetch) {
+      stats.prefetch_count_++;
+    } else {
+      stats.miss_count_++;
     }
-    return buffers[entry->second].page_;
+    auto frame_id = GetFreeFrame(partition);
+    auto page = std::make_shared<Page>(disk_.GetPageSize());
+    partition.buffer_strategy_->Access(frame_id);
+    partition.buffers_[frame_id] = {db_oid, table_oid, page_id, page};
+    partition.hashmap_[{table_oid, page_id}] = frame_id;
+    std::unique_lock frame_lock(*partition.latches_[frame_id]);
+    lock.unlock();
+    try {
+      disk_.ReadPage(db_oid, table_oid, page_id, page->GetData());
+    } catch (DbException &e) {
+      lock.lock();
+      partition.hashmap_.erase({table_oid, page_id});
+      partition.buffers_[frame_id] = {};
+      partition.free_frames_.push_back(frame_id);
+      throw;
+    }
+    return page;
   }
 }
 
@@ -37,17 +123,73 @@ std::shared_ptr<Page> BufferPool::NewPage(oid_t db_oid, oid_t table_oid, pageid_
   if (page_id == NULL_PAGE_ID) {
     throw DbException("Invalid page id in BufferPool::NewPage");
   }
-  auto page = std::make_shared<Page>();
-  AddToBuffer(db_oid, table_oid, page_id, page);
+  auto page = std::make_shared<Page>(disk_.GetPageSize());
+  if (db_oid == SYSTEM_DATABASE_OID) {
+    std::scoped_lock lock(systable_mutex_);
+    systable_hashmap_[{table_oid, page_id}] = systable_buffers_.size();
+    systable_buffers_.push_back({db_oid, table_oid, page_id, page});
+    return page;
+  }
+  std::shared_lock pool_lock(pool_mutex_);
+  auto &partition = GetPartition(table_oid, page_id);
+  std::scoped_lock lock(partition.mutex_);
+  auto entry = partition.hashmap_.find({table_oid, page_id});
+  if (entry != partition.hashmap_.end()) {
+    // 页面已在缓存中（如恢复时重做整页日志），复用原有的帧并清空内容，避免同一页面同时出现在两个帧中
+    auto &cached_page = partition.buffers_[entry->second].page_;
+    memset(cached_page->GetData(), 0, cached_page->GetPageSize());
+    cached_page->SetDirty();
+    partition.buffer_strategy_->Access(entry->second);
+    return cached_page;
+  }
+  auto frame_id = GetFreeFrame(partition);
+  partition.buffer_strategy_->Access(frame_id);
+  partition.buffers_[frame_id] = {db_oid, table_oid, page_id, page};
+  partition.hashmap_[{table_oid, page_id}] = frame_id;
+  return page;
+}
+
+std::shared_ptr<Page> BufferPool::PinPage(oid_t db_oid, oid_t table_oid, pageid_t page_id) {
+  auto page = GetPage(db_oid, table_oid, page_id);
+  page->Pin();
   return page;
 }
 
+void BufferPool::UnpinPage(oid_t db_oid, oid_t table_oid, pageid_t page_id) {
+  if (db_oid == SYSTEM_DATABASE_OID) {
+    std::scoped_lock lock(systable_mutex_);
+    auto entry = systable_hashmap_.find({table_oid, page_id});
+    if (entry == systable_hashmap_.end()) {
+      throw DbException("Unpin a page which is not in buffer pool");
+    }
+    systable_buffers_[entry->second].page_->Unpin();
+    return;
+  }
+  std::shared_lock pool_lock(pool_mutex_);
+  auto &partition = GetPartition(table_oid, page_id);
+  std::scoped_lock lock(partition.mutex_);
+  auto entry = partition.hashmap_.find({table_oid, page_id});
+  if (entry == partition.hashmap_.end()) {
+    throw DbException("Unpin a page which is not in buffer pool");
+  }
+  partition.buffers_[entry->second].page_->Unpin();
+}
+
 void BufferPool::Flush(bool regular_only) {
-  for (size_t i = 0; i < buffers_.size(); i++) {
-    FlushPage(i);
+  CancelPrefetch();
+  {
+    std::unique_lock pool_lock(pool_mutex_);
+    for (auto &partition : partitions_) {
+      for (size_t i = 0; i < partition->buffers_.size(); i++) {
+        if (partition->buffers_[i].page_ != nullptr) {
+          FlushPage(*partition, i);
+        }
+      }
+      ResetFrames(*partition);
+    }
   }
-  buffers_.clear();
   if (!regular_only) {
+    std::scoped_lock lock(systable_mutex_);
     for (size_t i = 0; i < systable_buffers_.size(); i++) {
       FlushSysTablePage(i);
     }
@@ -56,51 +198,343 @@ void BufferPool::Flush(bool regular_only) {
 }
 
 void BufferPool::Clear() {
-  buffers_.clear();
-  hashmap_.clear();
+  CancelPrefetch();
+  {
+    std::unique_lock pool_lock(pool_mutex_);
+    for (auto &partition : partitions_) {
+      ResetFrames(*partition);
+      partition->hashmap_.clear();
+    }
+  }
+  std::scoped_lock lock(systable_mutex_);
   systable_buffers_.clear();
   systable_hashmap_.clear();
 }
 
-void BufferPool::AddToBuffer(oid_t db_oid, oid_t table_oid, pageid_t page_id, std::shared_ptr<Page> page) {
-  if (db_oid == SYSTEM_DATABASE_OID) {
-    systable_hashmap_[{table_oid, page_id}] = systable_buffers_.size();
-    systable_buffers_.push_back({db_oid, table_oid, page_id, page});
-  } else {
-    if (buffers_.size() == BUFFER_SIZE) {
-      size_t victim = buffer_strategy_->Evict();
-      FlushPage(victim);
-      buffer_strategy_->Access(victim);
-      buffers_[victim] = {db_oid, table_oid, page_id, page};
-      hashmap_[{table_oid, page_id}] = victim;
-    } else {
-      buffer_strategy_->Access(buffers_.size());
-      hashmap_[{table_oid, page_id}] = buffers_.size();
-      buffers_.push_back({db_oid, table_oid, page_id, page});
+void BufferPool::Shutdown() {
+  bgwriter_.reset();
+  prefetcher_.reset();
+}
+
+size_t BufferPool::CleanFrames() {
+  std::shared_lock pool_lock(pool_mutex_);
+  size_t written = 0;
+  for (auto &partition : partitions_) {
+    std::vector<BufferPoolEntry> entries;
+    std::vector<std::unique_lock<std::shared_mutex>> frame_locks;
+    {
+      std::scoped_lock lock(partition->mutex_);
+      // 空闲帧无需写回即可使用
+      auto count = (partition->buffers_.size() * bgwriter_clean_percent_ + 99) / 100;
+      if (count <= partition->free_frames_.size()) {
+        continue;
+      }
+      count -= partition->free_frames_.size();
+      auto victims = partition->buffer_strategy_->GetVictims(count, [&partition](size_t frame_id) {
+        return partition->buffers_[frame_id].page_ != nullptr && !IsPinned(*partition, frame_id);
+      });
+      for (auto frame_id : victims) {
+        if (written + entries.size() >= bgwriter_max_pages_) {
+          break;
+        }
+        if (!partition->buffers_[frame_id].page_->IsDirty()) {
+          continue;
+        }
+        // 写回期间持有帧锁，其他线程访问该页面时在帧锁上等待写回完成，不会修改正在写回的页面
+        std::unique_lock frame_lock(*partition->latches_[frame_id], std::try_to_lock);
+        if (!frame_lock.owns_lock()) {
+          continue;
+        }
+        entries.push_back(partition->buffers_[frame_id]);
+        frame_locks.push_back(std::move(frame_lock));
+      }
+    }
+    for (size_t i = 0; i < entries.size(); i++) {
+      const auto &entry = entries[i];
+      // 先将日志刷到 page lsn，再写回页面
+      TablePage table_page(entry.page_);
+      log_manager_.FlushPage(entry.table_oid_, entry.page_id_, table_page.GetPageLSN());
+      disk_.WritePage(entry.db_oid_, entry.table_oid_, entry.page_id_, entry.page_->GetData());
+      entry.page_->ClearDirty();
+      frame_locks[i].unlock();
+      written++;
+      std::scoped_lock lock(partition->mutex_);
+      partition->strategy_stats_[buffer_strategy_type_].bgwriter_flush_count_++;
     }
+    if (written >= bgwriter_max_pages_) {
+      break;
+    }
+  }
+  return written;
+}
+
+size_t BufferPool::GetPoolSize() const {
+  std::shared_lock pool_lock(pool_mutex_);
+  return pool_size_;
+}
+
+void BufferPool::SetPoolSize(size_t pool_size) {
+  if (pool_size == 0) {
+    throw DbException("Buffer pool size must be positive");
+  }
+  CancelPrefetch();
+  std::unique_lock pool_lock(pool_mutex_);
+  for (const auto &partition : partitions_) {
+    for (size_t i = 0; i < partition->buffers_.size(); i++) {
+      if (partition->buffers_[i].page_ != nullptr && IsPinned(*partition, i)) {
+        throw DbException("Cannot resize buffer pool while pages are pinned");
+      }
+    }
+  }
+  for (auto &partition : partitions_) {
+    for (size_t i = 0; i < partition->buffers_.size(); i++) {
+      if (partition->buffers_[i].page_ != nullptr) {
+        FlushPage(*partition, i);
+      }
+    }
+  }
+  pool_size_ = pool_size;
+  ResetPartitions();
+}
+
+size_t BufferPool::GetPageSize() const { return disk_.GetPageSize(); }
+
+void BufferPool::SetCompression(oid_t db_oid, oid_t table_oid, CompressionType compression) {
+  disk_.SetCompression(db_oid, table_oid, compression);
+}
+
+size_t BufferPool::GetPartitionCount() const {
+  std::shared_lock pool_lock(pool_mutex_);
+  return partitions_.size();
+}
+
+size_t BufferPool::GetReadAheadPages() const {
+  std::shared_lock pool_lock(pool_mutex_);
+  return read_ahead_pages_;
+}
+
+void BufferPool::SetReadAheadPages(size_t page_count) {
+  std::unique_lock pool_lock(pool_mutex_);
+  // 预读线程在首次开启预读时创建
+  if (page_count > 0 && prefetcher_ == nullptr) {
+    prefetcher_ = std::make_unique<Prefetcher>(*this);
+  }
+  read_ahead_pages_ = page_count;
+}
+
+size_t BufferPool::GetBgWriterDelay() const {
+  std::shared_lock pool_lock(pool_mutex_);
+  return bgwriter_delay_ms_;
+}
+
+void BufferPool::SetBgWriterDelay(size_t delay_ms) {
+  std::unique_lock pool_lock(pool_mutex_);
+  // 后台写进程在首次开启时创建
+  if (delay_ms > 0 && bgwriter_ == nullptr) {
+    bgwriter_ = std::make_unique<BackgroundWriter>(*this);
+  }
+  if (bgwriter_ != nullptr) {
+    bgwriter_->SetDelay(delay_ms);
+  }
+  bgwriter_delay_ms_ = delay_ms;
+}
+
+size_t BufferPool::GetBgWriterMaxPages() const {
+  std::shared_lock pool_lock(pool_mutex_);
+  return bgwriter_max_pages_;
+}
+
+void BufferPool::SetBgWriterMaxPages(size_t max_pages) {
+  if (max_pages == 0) {
+    throw DbException("bgwriter_max_pages must be positive");
+  }
+  std::unique_lock pool_lock(pool_mutex_);
+  bgwriter_max_pages_ = max_pages;
+}
+
+size_t BufferPool::GetBgWriterCleanPercent() const {
+  std::shared_lock pool_lock(pool_mutex_);
+  return bgwriter_clean_percent_;
+}
+
+void BufferPool::SetBgWriterCleanPercent(size_t clean_percent) {
+  if (clean_percent == 0 || clean_percent > 100) {
+    throw DbException("bgwriter_clean_percent must be between 1 and 100");
+  }
+  std::unique_lock pool_lock(pool_mutex_);
+  bgwriter_clean_percent_ = clean_percent;
+}
+
+BufferStrategyType BufferPool::GetBufferStrategy() const {
+  std::shared_lock pool_lock(pool_mutex_);
+  return buffer_strategy_type_;
+}
+
+void BufferPool::SetBufferStrategy(BufferStrategyType type) {
+  std::unique_lock pool_lock(pool_mutex_);
+  if (type == buffer_strategy_type_) {
+    return;
+  }
+  buffer_strategy_type_ = type;
+  for (auto &partition : partitions_) {
+    partition->buffer_strategy_ = CreateBufferStrategy(type);
+    for (size_t i = 0; i < partition->buffers_.size(); i++) {
+      if (partition->buffers_[i].page_ != nullptr) {
+        partition->buffer_strategy_->Access(i);
+      }
+    }
+  }
+}
+
+BufferPoolStats BufferPool::GetStats() const {
+  BufferPoolStats total;
+  for (const auto &[type, stats] : GetStrategyStats()) {
+    total.hit_count_ += stats.hit_count_;
+    total.miss_count_ += stats.miss_count_;
+    total.eviction_count_ += stats.eviction_count_;
+    total.dirty_flush_count_ += stats.dirty_flush_count_;
+    total.prefetch_count_ += stats.prefetch_count_;
+    total.bgwriter_flush_count_ += stats.bgwriter_flush_count_;
+  }
+  return total;
+}
+
+std::map<BufferStrategyType, BufferPoolStats> BufferPool::GetStrategyStats() const {
+  std::map<BufferStrategyType, BufferPoolStats> result;
+  std::shared_lock pool_lock(pool_mutex_);
+  for (const auto &partition : partitions_) {
+    std::scoped_lock lock(partition->mutex_);
+    for (const auto &[type, stats] : partition->strategy_stats_) {
+      auto &total = result[type];
+      total.hit_count_ += stats.hit_count_;
+      total.miss_count_ += stats.miss_count_;
+      total.eviction_count_ += stats.eviction_count_;
+      total.dirty_flush_count_ += stats.dirty_flush_count_;
+      total.prefetch_count_ += stats.prefetch_count_;
+      total.bgwriter_flush_count_ += stats.bgwriter_flush_count_;
+    }
+  }
+  return result;
+}
+
+void BufferPool::ResetStats() {
+  std::shared_lock pool_lock(pool_mutex_);
+  for (auto &partition : partitions_) {
+    std::scoped_lock lock(partition->mutex_);
+    partition->strategy_stats_.clear();
+  }
+}
+
+void BufferPool::CancelPrefetch() {
+  {
+    std::shared_lock pool_lock(pool_mutex_);
+    if (prefetcher_ == nullptr) {
+      return;
+    }
+  }
+  // 预读线程访问页面时需获取 pool_mutex_，等待预读结束时不能持有 pool_mutex_
+  prefetcher_->Cancel();
+}
+
+BufferPool::Partition &BufferPool::GetPartition(oid_t table_oid, pageid_t page_id) const {
+  return *partitions_[std::hash<TablePageid>()({table_oid, page_id}) % partitions_.size()];
+}
+
+void BufferPool::ResetPartitions() {
+  // 统计信息汇总到新的第一个分区中
+  std::map<BufferStrategyType, BufferPoolStats> strategy_stats;
+  for (const auto &partition : partitions_) {
+    for (const auto &[type, stats] : partition->strategy_stats_) {
+      auto &total = strategy_stats[type];
+      total.hit_count_ += stats.hit_count_;
+      total.miss_count_ += stats.miss_count_;
+      total.eviction_count_ += stats.eviction_count_;
+      total.dirty_flush_count_ += stats.dirty_flush_count_;
+      total.prefetch_count_ += stats.prefetch_count_;
+      total.bgwriter_flush_count_ += stats.bgwriter_flush_count_;
+    }
+  }
+  auto partition_count = std::clamp<size_t>(pool_size_ / MIN_PARTITION_FRAMES, 1, MAX_BUFFER_POOL_PARTITIONS);
+  partitions_.clear();
+  for (size_t i = 0; i < partition_count; i++) {
+    auto partition = std::make_unique<Partition>();
+    // 页面数无法整除时，前面的分区多分配一个页面
+    auto frame_count = pool_size_ / partition_count + (i < pool_size_ % partition_count ? 1 : 0);
+    partition->buffers_.resize(frame_count);
+    for (size_t j = 0; j < frame_count; j++) {
+      partition->latches_.push_back(std::make_unique<std::shared_mutex>());
+    }
+    ResetFrames(*partition);
+    partitions_.push_back(std::move(partition));
+  }
+  partitions_[0]->strategy_stats_ = std::move(strategy_stats);
+}
+
+void BufferPool::ResetFrames(Partition &partition) {
+  partition.buffers_.assign(partition.buffers_.size(), {});
+  partition.free_frames_.clear();
+  for (size_t i = 0; i < partition.buffers_.size(); i++) {
+    partition.free_frames_.push_back(i);
+  }
+  partition.buffer_strategy_ = CreateBufferStrategy(buffer_strategy_type_);
+}
+
+size_t BufferPool::GetFreeFrame(Partition &partition) {
+  if (!partition.free_frames_.empty()) {
+    auto frame_id = partition.free_frames_.front();
+    partition.free_frames_.pop_front();
+    return frame_id;
+  }
+  // 读入失败的帧已放回空闲链表，不参与淘汰
+  auto victim = partition.buffer_strategy_->Evict([&partition](size_t frame_id) {
+    return partition.buffers_[frame_id].page_ != nullptr && !IsPinned(partition, frame_id);
+  });
+  partition.strategy_stats_[buffer_strategy_type_].eviction_count_++;
+  FlushPage(partition, victim);
+  return victim;
+}
+
+bool BufferPool::IsPinned(const Partition &partition, size_t frame_id) {
+  const auto &page = partition.buffers_[frame_id].page_;
+  return page->GetPinCount() > 0 || page.use_count() > 1;
+}
+
+std::unique_ptr<BufferStrategy> BufferPool::CreateBufferStrategy(BufferStrategyType type) {
+  switch (type) {
+    case BufferStrategyType::LRU:
+      return std::make_unique<LRUBufferStrategy>();
+    case BufferStrategyType::LRU_K:
+      return std::make_unique<LRUKBufferStrategy>();
+    case BufferStrategyType::TWO_QUEUE:
+      return std::make_unique<TwoQueueBufferStrategy>();
+    case BufferStrategyType::CLOCK:
+      return std::make_unique<ClockBufferStrategy>();
+    default:
+      throw DbException("Unknown buffer strategy type");
   }
 }
 
-void BufferPool::FlushPage(size_t frame_id) {
-  if (frame_id >= BUFFER_SIZE) {
+void BufferPool::FlushPage(Partition &partition, size_t frame_id) {
+  if (frame_id >= partition.buffers_.size()) {
     throw DbException("Invalid frame id in BufferPool::FlushPage");
   }
-  auto &buffer_entry = buffers_[frame_id];
+  auto &buffer_entry = partition.buffers_[frame_id];
   if (buffer_entry.page_->IsDirty()) {
+    partition.strategy_stats_[buffer_strategy_type_].dirty_flush_count_++;
     auto table_page = std::make_unique<TablePage>(buffer_entry.page_);
     log_manager_.FlushPage(buffer_entry.table_oid_, buffer_entry.page_id_, table_page->GetPageLSN());
     assert(buffer_entry.db_oid_ != SYSTEM_DATABASE_OID);
-    disk_.WritePage(Disk::GetFilePath(buffer_entry.db_oid_, buffer_entry.table_oid_), buffer_entry.page_id_,
+    disk_.WritePage(buffer_entry.db_oid_, buffer_entry.table_oid_, buffer_entry.page_id_,
                     buffer_entry.page_->GetData());
   }
-  hashmap_.erase({buffer_entry.table_oid_, buffer_entry.page_id_});
+  partition.hashmap_.erase({buffer_entry.table_oid_, buffer_entry.page_id_});
 }
 
 void BufferPool::FlushSysTablePage(size_t frame_id) {
   auto &buffer_entry = systable_buffers_[frame_id];
   if (buffer_entry.page_->IsDirty()) {
     assert(buffer_entry.db_oid_ == SYSTEM_DATABASE_OID);
-    disk_.WritePage(Disk::GetFilePath(buffer_entry.db_oid_, buffer_entry.table_oid_), buffer_entry.page_id_,
+    disk_.WritePage(buffer_entry.db_oid_, buffer_entry.table_oid_, buffer_entry.page_id_,
                     buffer_entry.page_->GetData());
   }
   systable_hashmap_.erase({buffer_entry.table_oid_, buffer_entry.page_id_});
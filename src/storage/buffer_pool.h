@@ -1,12 +1,17 @@
 #pragma once
 
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/types.h"
+#include "storage/buffer_strategy.h"
 #include "storage/disk.h"
-#include "storage/lru_buffer_strategy.h"
 #include "storage/page.h"
 
 namespace huadb {
@@ -18,41 +23,144 @@ struct BufferPoolEntry {
   std::shared_ptr<Page> page_;
 };
 
+// 缓存统计，仅统计普通表页面
+struct BufferPoolStats {
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+  uint64_t eviction_count_ = 0;     // 淘汰页面数
+  uint64_t dirty_flush_count_ = 0;  // 脏页写回次数
+  uint64_t prefetch_count_ = 0;     // 预读读入的页面数
+  uint64_t bgwriter_flush_count_ = 0;  // 后台写进程写回的页面数
+};
+
+class BackgroundWriter;
 class LogManager;
+class Prefetcher;
 
+// 普通表缓存被划分为多个分区，页面按 {table_oid, page_id} 哈希到分区，分区之间互不阻塞
+// 每个分区有独立的分区锁、页表、空闲链表和替换策略；每个帧有一个帧锁，页面从磁盘读入期间持有帧锁的写锁，
+// 读入时不持有分区锁，其他线程访问同一页面时在帧锁上等待读入完成
 class BufferPool {
  public:
-  BufferPool(Disk &disk, LogManager &log_manager);
+  BufferPool(Disk &disk, LogManager &log_manager, size_t pool_size = DEFAULT_BUFFER_POOL_SIZE);
+  ~BufferPool();
 
   // 获取一个已经存在的页面
   std::shared_ptr<Page> GetPage(oid_t db_oid, oid_t table_oid, pageid_t page_id);
   // 新建一个页面
   std::shared_ptr<Page> NewPage(oid_t db_oid, oid_t table_oid, pageid_t page_id);
+  // 获取并固定页面，固定期间页面不会被淘汰，需与 UnpinPage 成对调用
+  std::shared_ptr<Page> PinPage(oid_t db_oid, oid_t table_oid, pageid_t page_id);
+  // 解除页面固定
+  void UnpinPage(oid_t db_oid, oid_t table_oid, pageid_t page_id);
+  // 预读页面，由预读线程调用：页面不在缓存中时读入，不计入命中和缺页统计，页面已在缓存中时不更新访问记录
+  std::shared_ptr<Page> PrefetchPage(oid_t db_oid, oid_t table_oid, pageid_t page_id);
+  // 提交异步预读请求，沿页面链表读入 page_id 之后的页面，返回预读的页面数，未开启预读时返回 0
+  size_t ReadAhead(oid_t db_oid, oid_t table_oid, pageid_t page_id);
   // 将所有页面刷到磁盘，regular_only 为 true 时只刷普通表页面
   void Flush(bool regular_only = false);
   // 清空 buffer pool，不刷脏，用于数据库故障模拟
   void Clear();
+  // 停止预读线程和后台写进程，需在 Disk 和 LogManager 析构之前调用
+  void Shutdown();
+  // 后台写回：每个分区中按淘汰顺序排在前 bgwriter_clean_percent 的未固定脏页先刷日志再写回磁盘，
+  // 页面保留在缓存中并清除脏标记，每次最多写回 bgwriter_max_pages 个页面，返回写回的页面数
+  size_t CleanFrames();
+
+  // 获取普通表缓存的页面数
+  size_t GetPoolSize() const;
+  // 调整普通表缓存的页面数，调整前会将普通表页面全部刷盘
+  void SetPoolSize(size_t pool_size);
+  // 获取页面大小
+  size_t GetPageSize() const;
+  // 设置表页面写回磁盘时的压缩方式
+  void SetCompression(oid_t db_oid, oid_t table_oid, CompressionType compression);
+  // 获取分区数
+  size_t GetPartitionCount() const;
+
+  // 获取顺序扫描预读的页面数，0 表示不预读
+  size_t GetReadAheadPages() const;
+  // 设置顺序扫描预读的页面数，实际预读页面数不超过缓存页面数的一半
+  void SetReadAheadPages(size_t page_count);
+
+  // 后台写进程参数，delay 为 0 时关闭后台写进程
+  size_t GetBgWriterDelay() const;
+  void SetBgWriterDelay(size_t delay_ms);
+  size_t GetBgWriterMaxPages() const;
+  void SetBgWriterMaxPages(size_t max_pages);
+  size_t GetBgWriterCleanPercent() const;
+  void SetBgWriterCleanPercent(size_t clean_percent);
+
+  // 获取当前缓存替换策略
+  BufferStrategyType GetBufferStrategy() const;
+  // 切换缓存替换策略，已缓存的页面保留在 buffer pool 中
+  void SetBufferStrategy(BufferStrategyType type);
+  // 获取缓存统计
+  BufferPoolStats GetStats() const;
+  // 获取各缓存替换策略生效期间的缓存统计
+  std::map<BufferStrategyType, BufferPoolStats> GetStrategyStats() const;
+  // 清空缓存统计
+  void ResetStats();
 
  private:
-  // 将页面加入 buffer pool
-  void AddToBuffer(oid_t db_oid, oid_t table_oid, pageid_t page_id, std::shared_ptr<Page> page);
-  // 将 buffer 中对应的页面刷到磁盘
-  void FlushPage(size_t frame_id);
+  struct Partition {
+    std::mutex mutex_;  // 分区锁，保护分区内除页面内容外的所有成员
+    // 普通表缓存，page_ 为空表示空闲帧
+    std::vector<BufferPoolEntry> buffers_;
+    // 帧锁
+    std::vector<std::unique_ptr<std::shared_mutex>> latches_;
+    // 空闲帧链表
+    std::list<size_t> free_frames_;
+    // page_id 到 buffers_ 下标的映射
+    std::unordered_map<TablePageid, size_t> hashmap_;
+    std::unique_ptr<BufferStrategy> buffer_strategy_;  // 缓存替换策略
+    std::map<BufferStrategyType, BufferPoolStats> strategy_stats_;
+  };
+
+  // 获取普通表页面，prefetch 为 true 时为预读
+  std::shared_ptr<Page> FetchPage(oid_t db_oid, oid_t table_oid, pageid_t page_id, bool prefetch);
+  // 丢弃未执行的预读请求并等待执行中的预读结束，调用时不能持有 pool_mutex_
+  void CancelPrefetch();
+  // 获取页面所在分区
+  Partition &GetPartition(oid_t table_oid, pageid_t page_id) const;
+  // 按 pool_size_ 重新划分分区，统计信息保留
+  void ResetPartitions();
+  // 将分区的所有帧放回空闲链表
+  void ResetFrames(Partition &partition);
+  // 获取一个空闲帧，没有空闲帧时淘汰一个未被固定的页面，需持有分区锁
+  size_t GetFreeFrame(Partition &partition);
+  // 页面是否被固定：显式调用 PinPage，或 buffer pool 之外仍持有页面指针，需持有分区锁
+  static bool IsPinned(const Partition &partition, size_t frame_id);
+  // 创建缓存替换策略
+  static std::unique_ptr<BufferStrategy> CreateBufferStrategy(BufferStrategyType type);
+  // 将 buffer 中对应的页面刷到磁盘，需持有分区锁
+  void FlushPage(Partition &partition, size_t frame_id);
   // 将 systable_buffer 中对应的页面刷到磁盘
   void FlushSysTablePage(size_t frame_id);
 
   Disk &disk_;
   LogManager &log_manager_;
-  std::unique_ptr<BufferStrategy> buffer_strategy_;  // 缓存替换策略
 
-  // 普通表缓存
-  std::vector<BufferPoolEntry> buffers_;
-  // page_id 到 buffers_ 下标的映射
-  std::unordered_map<TablePageid, size_t> hashmap_;
+  // 调整分区等全局操作持有写锁，页面访问持有读锁
+  mutable std::shared_mutex pool_mutex_;
+  // 普通表缓存页面数
+  size_t pool_size_;
+  BufferStrategyType buffer_strategy_type_ = DEFAULT_BUFFER_STRATEGY;
+  std::vector<std::unique_ptr<Partition>> partitions_;
+
+  std::mutex systable_mutex_;
   // 系统表专用缓存
   std::vector<BufferPoolEntry> systable_buffers_;
   // 系统表专用映射
   std::unordered_map<TablePageid, size_t> systable_hashmap_;
+
+  size_t read_ahead_pages_ = DEFAULT_READ_AHEAD_PAGES;
+  size_t bgwriter_delay_ms_ = DEFAULT_BGWRITER_DELAY_MS;
+  size_t bgwriter_max_pages_ = DEFAULT_BGWRITER_MAX_PAGES;
+  size_t bgwriter_clean_percent_ = DEFAULT_BGWRITER_CLEAN_PERCENT;
+  // 预读线程和后台写进程访问 buffer pool，需最先析构
+  std::unique_ptr<Prefetcher> prefetcher_;
+  std::unique_ptr<BackgroundWriter> bgwriter_;
 };
 
 }  // namespace huadb
@@ -1,17 +1,25 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
+#include <vector>
 
 namespace huadb {
 
+enum class BufferStrategyType { LRU, LRU_K, TWO_QUEUE, CLOCK };
+
+static constexpr BufferStrategyType DEFAULT_BUFFER_STRATEGY = BufferStrategyType::LRU;
+
 // 缓存替换策略的模板类
 class BufferStrategy {
  public:
   virtual ~BufferStrategy() = default;
   // 页面访问接口
   virtual void Access(size_t frame_no) = 0;
-  // 页面替换接口
-  virtual size_t Evict() = 0;
+  // 页面替换接口，只能淘汰 evictable 返回 true 的页面（被固定的页面不可淘汰）
+  virtual size_t Evict(const std::function<bool(size_t)> &evictable) = 0;
+  // 按淘汰顺序返回接下来最多 count 个可淘汰的页面，不改变策略状态，用于后台写进程提前写回即将被淘汰的脏页
+  virtual std::vector<size_t> GetVictims(size_t count, const std::function<bool(size_t)> &evictable) const = 0;
 };
 
 }  // namespace huadb
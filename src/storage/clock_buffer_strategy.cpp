@@ -0,0 +1,48 @@
+#include "storage/clock_buffer_strategy.h"
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+void ClockBufferStrategy::Access(size_t frame_no) {
+  if (frame_no >= present_.size()) {
+    present_.resize(frame_no + 1, false);
+    referenced_.resize(frame_no + 1, false);
+  }
+  present_[frame_no] = true;
+  referenced_[frame_no] = true;
+}
+
+size_t ClockBufferStrategy::Evict(const std::function<bool(size_t)> &evictable) {
+  // 最多扫描两圈：第一圈清除引用位，第二圈必然能找到未被固定的页面
+  for (size_t step = 0; step < 2 * present_.size(); step++) {
+    auto frame_no = hand_;
+    hand_ = (hand_ + 1) % present_.size();
+    if (!present_[frame_no]) {
+      continue;
+    }
+    if (referenced_[frame_no]) {
+      referenced_[frame_no] = false;
+    } else if (evictable(frame_no)) {
+      present_[frame_no] = false;
+      return frame_no;
+    }
+  }
+  throw DbException("No evictable frame in buffer pool");
+}
+
+std::vector<size_t> ClockBufferStrategy::GetVictims(size_t count, const std::function<bool(size_t)> &evictable) const {
+  // 从时钟指针开始，引用位为 0 的页面在第一圈被淘汰，引用位为 1 的页面在第二圈被淘汰
+  std::vector<size_t> victims;
+  for (bool referenced : {false, true}) {
+    for (size_t step = 0; step < present_.size() && victims.size() < count; step++) {
+      auto frame_no = (hand_ + step) % present_.size();
+      if (present_[frame_no] && referenced_[frame_no] == referenced && evictable(frame_no)) {
+        victims.push_back(frame_no);
+      }
+    }
+  }
+  return victims;
+}
+
+}  // namespace huadb
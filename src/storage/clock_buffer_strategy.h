@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+#include "storage/buffer_strategy.h"
+
+namespace huadb {
+
+// CLOCK 替换策略：访问时设置引用位，时钟指针扫过时清除引用位，淘汰引用位为 0 的页面
+class ClockBufferStrategy : public BufferStrategy {
+ public:
+  void Access(size_t frame_no) override;
+  size_t Evict(const std::function<bool(size_t)> &evictable) override;
+  std::vector<size_t> GetVictims(size_t count, const std::function<bool(size_t)> &evictable) const override;
+
+ private:
+  std::vector<bool> present_;     // 帧中是否有页面
+  std::vector<bool> referenced_;  // 引用位
+  size_t hand_ = 0;               // 时钟指针
+};
+
+}  // namespace huadb
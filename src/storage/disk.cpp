@@ -1,14 +1,50 @@
 #include "storage/disk.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "common/constants.h"
 #include "common/exceptions.h"
-#include "common/string_util.h"
+#include "storage/lz_codec.h"
 
 namespace huadb {
 
+// 压缩页头：最高位为压缩标记，32 至 39 位为压缩方式，低 32 位为压缩数据的字节数
+static constexpr uint64_t COMPRESSED_PAGE_FLAG = 1ULL << 63;
+static constexpr size_t COMPRESSED_PAGE_HEADER_SIZE = sizeof(uint64_t);
+
+// 将页面压缩到 image，返回包括压缩页头的字节数，压缩后不小于页面大小时返回 0
+static size_t CompressPage(const char *data, size_t page_size, CompressionType compression, char *image) {
+  auto size = LzCodec::Compress(data, page_size, image + COMPRESSED_PAGE_HEADER_SIZE,
+                                page_size - COMPRESSED_PAGE_HEADER_SIZE - 1);
+  if (size == 0) {
+    return 0;
+  }
+  uint64_t header = COMPRESSED_PAGE_FLAG | (static_cast<uint64_t>(compression) << 32) | size;
+  memcpy(image, &header, sizeof(header));
+  return COMPRESSED_PAGE_HEADER_SIZE + size;
+}
+
+// 释放文件中 [begin, end) 范围内的完整文件块，不支持打洞的平台和文件系统忽略
+static void PunchHole(int fd, off_t begin, off_t end, off_t block_size) {
+#ifdef FALLOC_FL_PUNCH_HOLE
+  begin = (begin + block_size - 1) / block_size * block_size;
+  end = end / block_size * block_size;
+  if (begin < end) {
+    (void)fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, begin, end - begin);
+  }
+#endif
+}
+
 Disk::Disk() {
   if (!DirectoryExists(BASE_PATH)) {
     CreateDirectory(BASE_PATH);
@@ -32,7 +68,10 @@ Disk::Disk() {
   }
 }
 
-Disk::~Disk() { ChangeDirectory(".."); }
+Disk::~Disk() {
+  CloseFiles();
+  ChangeDirectory("..");
+}
 
 bool Disk::DirectoryExists(const std::string &path) { return std::filesystem::is_directory(path); }
 
@@ -60,57 +99,141 @@ void Disk::CreateFile(const std::string &path) { std::ofstream ofs(path); }
 
 void Disk::RemoveFile(const std::string &path) { std::filesystem::remove(path); }
 
-void Disk::OpenFile(const std::string &path) {
-  hashmap_[path] = std::fstream(path, std::fstream::in | std::fstream::out | std::fstream::binary);
-  if (!hashmap_[path]) {
-    throw DbException("file " + path + " does not exist");
+void Disk::ReadPage(oid_t db_oid, oid_t table_oid, pageid_t page_id, char *data) {
+  auto begin = std::chrono::steady_clock::now();
+  ssize_t bytes;
+  {
+    std::shared_lock lock(files_mutex_);
+    auto fd = GetFileDescriptor(db_oid, table_oid, lock);
+    if (fd == -1) {
+      throw DbException("file " + GetFilePath(db_oid, table_oid) + " does not exist");
+    }
+    bytes = pread(fd, data, page_size_, static_cast<off_t>(page_id) * page_size_);
   }
-}
-
-void Disk::CloseFile(const std::string &path) { hashmap_.erase(path); }
-
-void Disk::ReadPage(const std::string &path, pageid_t page_id, char *data) {
-  if (GetOid(path).first != SYSTEM_DATABASE_OID) {
+  if (bytes != static_cast<ssize_t>(page_size_)) {
+    throw DbException(GetFilePath(db_oid, table_oid) + " read page " + std::to_string(page_id) + " failed: read " +
+                      std::to_string(bytes) + " bytes, expected " + std::to_string(page_size_) + " bytes");
+  }
+  if (!DecompressPage(data, page_size_)) {
+    throw DbException(GetFilePath(db_oid, table_oid) + " read page " + std::to_string(page_id) +
+                      " failed: corrupted compressed page");
+  }
+  if (db_oid != SYSTEM_DATABASE_OID) {
+    std::scoped_lock lock(mutex_);
     access_count_++;
+    stats_.read_count_++;
+    stats_.read_bytes_ += page_size_;
+    stats_.read_time_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - begin).count();
   }
-  if (hashmap_.count(path) == 0) {
-    OpenFile(path);
+}
+
+void Disk::WritePage(oid_t db_oid, oid_t table_oid, pageid_t page_id, const char *data) {
+  auto begin = std::chrono::steady_clock::now();
+  size_t size = page_size_;
+  size_t compressed_size = 0;
+  {
+    std::shared_lock lock(files_mutex_);
+    auto fd = GetFileDescriptor(db_oid, table_oid, lock);
+    // 表已被删除，无需写回
+    if (fd == -1) {
+      return;
+    }
+    auto offset = static_cast<off_t>(page_id) * page_size_;
+    std::vector<char> image;
+    auto compression = compressions_.find((static_cast<uint64_t>(db_oid) << 32) | table_oid);
+    if (compression != compressions_.end()) {
+      image.resize(page_size_);
+      compressed_size = CompressPage(data, page_size_, compression->second, image.data());
+    }
+    struct stat file_stat;
+    if (compressed_size > 0) {
+      if (fstat(fd, &file_stat) == -1) {
+        throw DbException("fstat " + GetFilePath(db_oid, table_oid) + " failed: " + std::string(strerror(errno)));
+      }
+      // 页面位于文件末尾之后时补零写满整个页面，保证文件大小为页面大小的整数倍
+      if (file_stat.st_size >= offset + static_cast<off_t>(page_size_)) {
+        size = compressed_size;
+      }
+      data = image.data();
+    }
+    auto bytes = pwrite(fd, data, size, offset);
+    if (bytes != static_cast<ssize_t>(size)) {
+      throw DbException(GetFilePath(db_oid, table_oid) + " write page " + std::to_string(page_id) +
+                        " failed: wrote " + std::to_string(bytes) + " bytes, expected " + std::to_string(size) +
+                        " bytes");
+    }
+    if (compressed_size > 0) {
+      PunchHole(fd, offset + compressed_size, offset + page_size_, file_stat.st_blksize);
+    }
   }
-  auto &fs = hashmap_[path];
-  if (fs.fail()) {
-    throw DbException("fstream failed in Disk::ReadPage");
+  if (db_oid != SYSTEM_DATABASE_OID) {
+    std::scoped_lock lock(mutex_);
+    access_count_++;
+    stats_.write_count_++;
+    stats_.write_bytes_ += size;
+    if (compressed_size > 0) {
+      stats_.compressed_write_count_++;
+      stats_.compressed_write_bytes_ += compressed_size;
+    }
+    stats_.write_time_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - begin).count();
   }
-  fs.seekg(page_id * DB_PAGE_SIZE);
-  fs.read(data, DB_PAGE_SIZE);
-  if (fs.gcount() != DB_PAGE_SIZE) {
-    throw DbException(path + " read page " + std::to_string(page_id) + " failed: read " + std::to_string(fs.gcount()) +
-                      " bytes, expected " + std::to_string(DB_PAGE_SIZE) + " bytes");
+}
+
+void Disk::SetCompression(oid_t db_oid, oid_t table_oid, CompressionType compression) {
+  std::unique_lock lock(files_mutex_);
+  auto key = (static_cast<uint64_t>(db_oid) << 32) | table_oid;
+  if (compression == CompressionType::NONE) {
+    compressions_.erase(key);
+  } else {
+    compressions_[key] = compression;
   }
 }
 
-void Disk::WritePage(const std::string &path, pageid_t page_id, const char *data) {
-  if (!FileExists(path)) {
-    return;
+bool Disk::DecompressPage(char *data, size_t page_size) {
+  uint64_t header;
+  memcpy(&header, data, sizeof(header));
+  if ((header & COMPRESSED_PAGE_FLAG) == 0) {
+    return true;
   }
-  if (hashmap_.count(path) == 0) {
-    OpenFile(path);
+  auto compression = static_cast<CompressionType>((header >> 32) & 0xFF);
+  size_t size = header & 0xFFFFFFFF;
+  if (compression != CompressionType::LZ || size > page_size - COMPRESSED_PAGE_HEADER_SIZE) {
+    return false;
   }
-  if (GetOid(path).first != SYSTEM_DATABASE_OID) {
-    access_count_++;
+  std::vector<char> image(data + COMPRESSED_PAGE_HEADER_SIZE, data + COMPRESSED_PAGE_HEADER_SIZE + size);
+  return LzCodec::Decompress(image.data(), size, data, page_size);
+}
+
+void Disk::SyncPages() {
+  std::shared_lock lock(files_mutex_);
+  for (const auto &[key, fd] : files_) {
+    if (fdatasync(fd) == -1) {
+      throw DbException("fdatasync failed in Disk::SyncPages: " + std::string(strerror(errno)));
+    }
   }
-  auto &fs = hashmap_[path];
-  if (fs.fail()) {
-    throw DbException("fstream failed in Disk::WritePage");
+}
+
+void Disk::CloseFiles() {
+  std::unique_lock lock(files_mutex_);
+  for (const auto &[key, fd] : files_) {
+    close(fd);
   }
-  fs.seekp(page_id * DB_PAGE_SIZE);
-  fs.write(data, DB_PAGE_SIZE);
-  fs.flush();
+  files_.clear();
 }
 
 void Disk::ReadLog(uint32_t offset, uint32_t count, char *data) {
+  std::scoped_lock lock(log_mutex_);
   if (log_fs_.fail()) {
     throw DbException("fstream failed in Disk::ReadLog");
   }
+  // 日志按最长长度读取，超出日志文件末尾的部分不含有效日志，填 0 即可
+  uint64_t log_size = log_segments * LOG_SEGMENT_SIZE;
+  if (offset < log_size && offset + count > log_size) {
+    std::fill(data + (log_size - offset), data + count, 0);
+    count = log_size - offset;
+  }
   log_fs_.seekg(offset);
   log_fs_.read(data, count);
   if (log_fs_.gcount() != count) {
@@ -120,6 +243,7 @@ void Disk::ReadLog(uint32_t offset, uint32_t count, char *data) {
 }
 
 void Disk::WriteLog(uint32_t offset, uint32_t count, const char *data) {
+  std::scoped_lock lock(log_mutex_);
   if (log_fs_.fail()) {
     throw DbException("fstream failed in Disk::WriteLog");
   }
@@ -132,15 +256,74 @@ void Disk::WriteLog(uint32_t offset, uint32_t count, const char *data) {
   log_fs_.flush();
 }
 
-uint32_t Disk::GetAccessCount() const { return access_count_; }
+size_t Disk::GetPageSize() const { return page_size_; }
+
+void Disk::SetPageSize(size_t page_size) {
+  if (!ValidPageSize(page_size)) {
+    throw DbException("Invalid page size " + std::to_string(page_size) + ": must be " +
+                      std::to_string(DEFAULT_DB_PAGE_SIZE) + " or a power of 2 between " +
+                      std::to_string(MIN_DB_PAGE_SIZE) + " and " + std::to_string(MAX_DB_PAGE_SIZE));
+  }
+  page_size_ = page_size;
+}
+
+bool Disk::ValidPageSize(size_t page_size) {
+  if (page_size == DEFAULT_DB_PAGE_SIZE) {
+    return true;
+  }
+  return page_size >= MIN_DB_PAGE_SIZE && page_size <= MAX_DB_PAGE_SIZE && (page_size & (page_size - 1)) == 0;
+}
+
+uint32_t Disk::GetAccessCount() const {
+  std::scoped_lock lock(mutex_);
+  return access_count_;
+}
+
+DiskStats Disk::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+void Disk::ResetStats() {
+  std::scoped_lock lock(mutex_);
+  stats_ = DiskStats();
+}
 
 std::string Disk::GetFilePath(oid_t db_oid, oid_t table_oid) {
   return std::to_string(db_oid) + "/" + std::to_string(table_oid);
 }
 
-std::pair<oid_t, oid_t> Disk::GetOid(const std::string &path) {
-  auto oids = StringUtil::Split(path, '/');
-  return {std::stoi(oids[0]), std::stoi(oids[1])};
+std::string Disk::GetFreeSpaceMapPath(oid_t db_oid, oid_t table_oid) {
+  return GetFilePath(db_oid, table_oid) + "_fsm";
+}
+
+int Disk::GetFileDescriptor(oid_t db_oid, oid_t table_oid, std::shared_lock<std::shared_mutex> &lock) {
+  auto key = (static_cast<uint64_t>(db_oid) << 32) | table_oid;
+  while (true) {
+    auto entry = files_.find(key);
+    if (entry != files_.end()) {
+      return entry->second;
+    }
+    lock.unlock();
+    bool exists = true;
+    {
+      std::unique_lock write_lock(files_mutex_);
+      if (files_.find(key) == files_.end()) {
+        auto fd = open(GetFilePath(db_oid, table_oid).c_str(), O_RDWR);
+        if (fd != -1) {
+          files_[key] = fd;
+        } else if (errno == ENOENT) {
+          exists = false;
+        } else {
+          throw DbException("open " + GetFilePath(db_oid, table_oid) + " failed: " + std::string(strerror(errno)));
+        }
+      }
+    }
+    lock.lock();
+    if (!exists) {
+      return -1;
+    }
+  }
 }
 
 }  // namespace huadb
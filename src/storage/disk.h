@@ -1,14 +1,28 @@
 #pragma once
 
 #include <fstream>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
-#include <utility>
 
+#include "common/constants.h"
 #include "common/types.h"
 
 namespace huadb {
 
+// 磁盘页面读写统计，仅统计普通表页面
+struct DiskStats {
+  uint64_t read_count_ = 0;
+  uint64_t write_count_ = 0;
+  uint64_t read_bytes_ = 0;
+  uint64_t write_bytes_ = 0;
+  uint64_t read_time_ns_ = 0;           // ReadPage 耗时
+  uint64_t write_time_ns_ = 0;          // WritePage 耗时
+  uint64_t compressed_write_count_ = 0;  // 压缩后写回的页面数
+  uint64_t compressed_write_bytes_ = 0;  // 压缩后写回的页面的压缩后字节数，包括压缩页头
+};
+
 class Disk {
  public:
   Disk();
@@ -24,25 +38,60 @@ class Disk {
   static void CreateFile(const std::string &path);
   static void RemoveFile(const std::string &path);
 
-  void OpenFile(const std::string &path);
-  void CloseFile(const std::string &path);
-
-  void ReadPage(const std::string &path, pageid_t page_id, char *data);
-  void WritePage(const std::string &path, pageid_t page_id, const char *data);
+  // 页面文件通过缓存的文件描述符以 pread/pwrite 读写，写入不立即持久化
+  // 读取到压缩页面时解压为原始页面
+  void ReadPage(oid_t db_oid, oid_t table_oid, pageid_t page_id, char *data);
+  // 文件不存在（表已被删除）时忽略写入
+  // 设置了压缩方式的表，压缩后小于页面大小时写入压缩页面，否则写入原始页面
+  // 压缩页面的前 8 字节为压缩页头，占据原始页面 page lsn 的位置，最高位为压缩标记，page lsn 不会使用该位
+  // 压缩页头之后为压缩数据，页面在文件中的位置不变，页面末尾整块未使用的文件空间通过打洞释放
+  void WritePage(oid_t db_oid, oid_t table_oid, pageid_t page_id, const char *data);
+  // 设置表页面写回时的压缩方式，压缩页面在读取时根据压缩页头识别，与当前设置无关
+  void SetCompression(oid_t db_oid, oid_t table_oid, CompressionType compression);
+  // 将 data 中的压缩页面原地解压，未压缩的页面保持不变，数据损坏时返回 false
+  static bool DecompressPage(char *data, size_t page_size);
+  // 将已写入的页面持久化到磁盘，在 checkpoint 时调用
+  void SyncPages();
+  // 关闭缓存的文件描述符，删除表或数据库后调用，之后访问页面文件时重新打开
+  void CloseFiles();
 
   void ReadLog(uint32_t offset, uint32_t count, char *data);
   void WriteLog(uint32_t offset, uint32_t count, const char *data);
 
+  // 获取页面大小
+  size_t GetPageSize() const;
+  // 设置页面大小，需在读写页面之前调用
+  void SetPageSize(size_t page_size);
+  // 页面大小是否合法
+  static bool ValidPageSize(size_t page_size);
+
   uint32_t GetAccessCount() const;
+  DiskStats GetStats() const;
+  void ResetStats();
 
   static std::string GetFilePath(oid_t db_oid, oid_t table_oid);
+  // 表的空闲空间映射表文件路径
+  static std::string GetFreeSpaceMapPath(oid_t db_oid, oid_t table_oid);
 
  private:
-  static std::pair<oid_t, oid_t> GetOid(const std::string &path);
-  std::unordered_map<std::string, std::fstream> hashmap_;  // 文件路径到 fstream 的映射表
+  // 获取页面文件的文件描述符，文件不存在时返回 -1
+  // 调用前需持有 files_mutex_ 的读锁，首次打开文件时临时释放读锁并获取写锁
+  // 返回时仍持有读锁
+  int GetFileDescriptor(oid_t db_oid, oid_t table_oid, std::shared_lock<std::shared_mutex> &lock);
+
+  // 保护统计信息
+  mutable std::mutex mutex_;
+  // 保护日志文件读写，后台写进程刷日志时查询线程可能正在回滚读取日志
+  std::mutex log_mutex_;
+  // 保护文件描述符缓存，页面读写持有读锁，打开和关闭文件持有写锁
+  std::shared_mutex files_mutex_;
+  std::unordered_map<uint64_t, int> files_;                     // {db_oid, table_oid} 到文件描述符的映射表
+  std::unordered_map<uint64_t, CompressionType> compressions_;  // 设置了压缩方式的表，与 files_ 共用锁
   std::fstream log_fs_;
 
+  size_t page_size_ = DEFAULT_DB_PAGE_SIZE;
   uint32_t access_count_ = 0;  // 磁盘访问次数
+  DiskStats stats_;
   uint32_t log_segments = 0;   // 日志段数
 };
 
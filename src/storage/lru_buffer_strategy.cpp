@@ -1,20 +1,44 @@
 #include "storage/lru_buffer_strategy.h"
 
+#include "common/exceptions.h"
+
 namespace huadb {
 
 void LRUBufferStrategy::Access(size_t frame_no) {
   // 缓存页面访问
   // LAB 1 BEGIN
-  access_order_.remove(frame_no);
-  access_order_.emplace_front(frame_no);
+  auto position = positions_.find(frame_no);
+  if (position != positions_.end()) {
+    access_order_.splice(access_order_.begin(), access_order_, position->second);
+  } else {
+    access_order_.emplace_front(frame_no);
+    positions_[frame_no] = access_order_.begin();
+  }
 };
 
-size_t LRUBufferStrategy::Evict() {
+size_t LRUBufferStrategy::Evict(const std::function<bool(size_t)> &evictable) {
   // 缓存页面淘汰，返回淘汰的页面在 buffer pool 中的下标
+  // 从最久未访问的页面开始，跳过被固定的页面
   // LAB 1 BEGIN
-  auto lastBuffer = access_order_.back();
-  access_order_.pop_back();
-  return lastBuffer;
+  for (auto iter = access_order_.rbegin(); iter != access_order_.rend(); ++iter) {
+    if (evictable(*iter)) {
+      auto victim = *iter;
+      access_order_.erase(std::next(iter).base());
+      positions_.erase(victim);
+      return victim;
+    }
+  }
+  throw DbException("No evictable frame in buffer pool");
+}
+
+std::vector<size_t> LRUBufferStrategy::GetVictims(size_t count, const std::function<bool(size_t)> &evictable) const {
+  std::vector<size_t> victims;
+  for (auto iter = access_order_.rbegin(); iter != access_order_.rend() && victims.size() < count; ++iter) {
+    if (evictable(*iter)) {
+      victims.push_back(*iter);
+    }
+  }
+  return victims;
 }
 
 }  // namespace huadb
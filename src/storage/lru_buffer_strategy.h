@@ -2,16 +2,21 @@
 
 #include "storage/buffer_strategy.h"
 #include <list>
+#include <unordered_map>
 
 namespace huadb {
 
 class LRUBufferStrategy : public BufferStrategy {
  public:
   void Access(size_t frame_no) override;
-  size_t Evict() override;
+  size_t Evict(const std::function<bool(size_t)> &evictable) override;
+  std::vector<size_t> GetVictims(size_t count, const std::function<bool(size_t)> &evictable) const override;
 
  private:
+  // 访问顺序链表，头部为最近访问的页面
   std::list<size_t> access_order_;
+  // 页面在访问顺序链表中的位置，使访问和淘汰均为 O(1)
+  std::unordered_map<size_t, std::list<size_t>::iterator> positions_;
 };
 
 }  // namespace huadb
@@ -0,0 +1,70 @@
+#include "storage/lru_k_buffer_strategy.h"
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+LRUKBufferStrategy::LRUKBufferStrategy(size_t k) : k_(k) {
+  if (k_ == 0) {
+    throw DbException("K of LRU-K must be positive");
+  }
+}
+
+void LRUKBufferStrategy::Access(size_t frame_no) {
+  auto iter = histories_.find(frame_no);
+  if (iter == histories_.end()) {
+    iter = histories_.emplace(frame_no, std::deque<uint64_t>()).first;
+  } else {
+    auto &queue = iter->second.size() < k_ ? history_queue_ : cache_queue_;
+    queue.erase(GetKey(frame_no));
+  }
+  auto &history = iter->second;
+  if (frame_no == last_frame_no_ && !history.empty()) {
+    // 相关访问只更新最近一次访问时间
+    history.back() = current_timestamp_++;
+  } else {
+    history.push_back(current_timestamp_++);
+    if (history.size() > k_) {
+      history.pop_front();
+    }
+  }
+  last_frame_no_ = frame_no;
+  auto &queue = history.size() < k_ ? history_queue_ : cache_queue_;
+  queue.insert(GetKey(frame_no));
+}
+
+size_t LRUKBufferStrategy::Evict(const std::function<bool(size_t)> &evictable) {
+  for (auto *queue : {&history_queue_, &cache_queue_}) {
+    for (auto iter = queue->begin(); iter != queue->end(); ++iter) {
+      auto frame_no = iter->second;
+      if (evictable(frame_no)) {
+        queue->erase(iter);
+        histories_.erase(frame_no);
+        if (frame_no == last_frame_no_) {
+          last_frame_no_ = -1;
+        }
+        return frame_no;
+      }
+    }
+  }
+  throw DbException("No evictable frame in buffer pool");
+}
+
+std::vector<size_t> LRUKBufferStrategy::GetVictims(size_t count, const std::function<bool(size_t)> &evictable) const {
+  std::vector<size_t> victims;
+  for (const auto *queue : {&history_queue_, &cache_queue_}) {
+    for (auto iter = queue->begin(); iter != queue->end() && victims.size() < count; ++iter) {
+      if (evictable(iter->second)) {
+        victims.push_back(iter->second);
+      }
+    }
+  }
+  return victims;
+}
+
+std::pair<uint64_t, size_t> LRUKBufferStrategy::GetKey(size_t frame_no) const {
+  // 两个队列均以 history 的第一个时间戳排序：不足 K 次时为最早访问时间，达到 K 次时为倒数第 K 次访问时间
+  return {histories_.at(frame_no).front(), frame_no};
+}
+
+}  // namespace huadb
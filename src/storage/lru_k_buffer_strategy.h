@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+#include "storage/buffer_strategy.h"
+
+namespace huadb {
+
+// LRU-K 替换策略：淘汰倒数第 K 次访问距今最久的页面，访问不足 K 次的页面优先淘汰
+// 连续访问同一页面（如顺序扫描逐条读取同一页面的记录）视为一次相关访问，只计一次
+class LRUKBufferStrategy : public BufferStrategy {
+ public:
+  explicit LRUKBufferStrategy(size_t k = 2);
+
+  void Access(size_t frame_no) override;
+  size_t Evict(const std::function<bool(size_t)> &evictable) override;
+  std::vector<size_t> GetVictims(size_t count, const std::function<bool(size_t)> &evictable) const override;
+
+ private:
+  // 页面在淘汰队列中的排序键
+  std::pair<uint64_t, size_t> GetKey(size_t frame_no) const;
+
+  size_t k_;
+  uint64_t current_timestamp_ = 0;
+  size_t last_frame_no_ = -1;
+  // 每个页面最近 K 次访问的时间戳
+  std::unordered_map<size_t, std::deque<uint64_t>> histories_;
+  // 访问不足 K 次的页面，按最早访问时间排序
+  std::set<std::pair<uint64_t, size_t>> history_queue_;
+  // 访问达到 K 次的页面，按倒数第 K 次访问时间排序
+  std::set<std::pair<uint64_t, size_t>> cache_queue_;
+};
+
+}  // namespace huadb
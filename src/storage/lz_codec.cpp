@@ -0,0 +1,166 @@
+#include "storage/lz_codec.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace huadb {
+
+// 最短匹配长度
+static constexpr size_t MIN_MATCH = 4;
+// 最后 LAST_LITERALS 字节总是作为字面量，距末尾不足 MATCH_LIMIT 字节时不再开始新的匹配，与 LZ4 相同
+static constexpr size_t LAST_LITERALS = 5;
+static constexpr size_t MATCH_LIMIT = 12;
+static constexpr size_t MAX_OFFSET = 65535;
+static constexpr size_t HASH_BITS = 12;
+
+static uint32_t Read32(const uint8_t *data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+static uint32_t Hash(uint32_t sequence) { return (sequence * 2654435761U) >> (32 - HASH_BITS); }
+
+// 写入长度扩展字节，空间不足时返回 false
+static bool WriteLength(size_t length, uint8_t *dst, size_t capacity, size_t &op) {
+  for (; length >= 255; length -= 255) {
+    if (op >= capacity) {
+      return false;
+    }
+    dst[op++] = 255;
+  }
+  if (op >= capacity) {
+    return false;
+  }
+  dst[op++] = static_cast<uint8_t>(length);
+  return true;
+}
+
+// 写入一个序列，match_length 为 0 时为只有字面量的最后一个序列
+static bool WriteSequence(const uint8_t *literals, size_t literal_length, size_t offset, size_t match_length,
+                          uint8_t *dst, size_t capacity, size_t &op) {
+  if (op >= capacity) {
+    return false;
+  }
+  auto token_pos = op++;
+  uint8_t token = (literal_length >= 15 ? 15 : literal_length) << 4;
+  if (literal_length >= 15 && !WriteLength(literal_length - 15, dst, capacity, op)) {
+    return false;
+  }
+  if (op + literal_length > capacity) {
+    return false;
+  }
+  memcpy(dst + op, literals, literal_length);
+  op += literal_length;
+  if (match_length > 0) {
+    if (op + 2 > capacity) {
+      return false;
+    }
+    dst[op++] = offset & 0xFF;
+    dst[op++] = offset >> 8;
+    auto length = match_length - MIN_MATCH;
+    token |= length >= 15 ? 15 : length;
+    if (length >= 15 && !WriteLength(length - 15, dst, capacity, op)) {
+      return false;
+    }
+  }
+  dst[token_pos] = token;
+  return true;
+}
+
+// 读取长度扩展字节，数据不完整时返回 false
+static bool ReadLength(const uint8_t *src, size_t size, size_t &ip, size_t &length) {
+  uint8_t byte;
+  do {
+    if (ip >= size) {
+      return false;
+    }
+    byte = src[ip++];
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+size_t LzCodec::Compress(const char *src, size_t size, char *dst, size_t capacity) {
+  auto *in = reinterpret_cast<const uint8_t *>(src);
+  auto *out = reinterpret_cast<uint8_t *>(dst);
+  size_t op = 0;
+  size_t anchor = 0;
+  if (size > MATCH_LIMIT) {
+    // 记录每个 4 字节序列最近出现的位置加 1，0 表示未出现
+    std::vector<uint32_t> table(1 << HASH_BITS, 0);
+    size_t match_end_limit = size - LAST_LITERALS;
+    size_t ip = 0;
+    while (ip < size - MATCH_LIMIT) {
+      auto sequence = Read32(in + ip);
+      auto &entry = table[Hash(sequence)];
+      size_t ref = entry;
+      entry = ip + 1;
+      if (ref == 0 || ip - (ref - 1) > MAX_OFFSET || Read32(in + ref - 1) != sequence) {
+        ip++;
+        continue;
+      }
+      ref--;
+      size_t length = MIN_MATCH;
+      while (ip + length < match_end_limit && in[ref + length] == in[ip + length]) {
+        length++;
+      }
+      if (!WriteSequence(in + anchor, ip - anchor, ip - ref, length, out, capacity, op)) {
+        return 0;
+      }
+      ip += length;
+      anchor = ip;
+    }
+  }
+  if (!WriteSequence(in + anchor, size - anchor, 0, 0, out, capacity, op)) {
+    return 0;
+  }
+  return op;
+}
+
+bool LzCodec::Decompress(const char *src, size_t size, char *dst, size_t dst_size) {
+  auto *in = reinterpret_cast<const uint8_t *>(src);
+  auto *out = reinterpret_cast<uint8_t *>(dst);
+  size_t ip = 0;
+  size_t op = 0;
+  while (ip < size) {
+    auto token = in[ip++];
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !ReadLength(in, size, ip, literal_length)) {
+      return false;
+    }
+    if (ip + literal_length > size || op + literal_length > dst_size) {
+      return false;
+    }
+    memcpy(out + op, in + ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+    if (ip == size) {
+      break;
+    }
+    if (ip + 2 > size) {
+      return false;
+    }
+    size_t offset = in[ip] | (in[ip + 1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > op) {
+      return false;
+    }
+    size_t match_length = token & 15;
+    if (match_length == 15 && !ReadLength(in, size, ip, match_length)) {
+      return false;
+    }
+    match_length += MIN_MATCH;
+    if (op + match_length > dst_size) {
+      return false;
+    }
+    // 匹配可能与输出重叠，逐字节复制
+    for (size_t i = 0; i < match_length; i++, op++) {
+      out[op] = out[op - offset];
+    }
+  }
+  return op == dst_size;
+}
+
+}  // namespace huadb
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+namespace huadb {
+
+// LZ4 块格式的字节压缩，不依赖外部库
+// 压缩结果由若干序列组成，每个序列为 token、字面量长度扩展、字面量、2 字节匹配偏移和匹配长度扩展
+// token 高 4 位为字面量长度，低 4 位为匹配长度减 4，取值 15 时后续字节继续累加，最后一个序列只有字面量
+class LzCodec {
+ public:
+  // 压缩 src 中的 size 字节到 dst，结果超过 capacity 字节时返回 0，否则返回压缩后的字节数
+  static size_t Compress(const char *src, size_t size, char *dst, size_t capacity);
+  // 解压 src 中的 size 字节到 dst，解压结果需恰好为 dst_size 字节，数据损坏时返回 false
+  static bool Decompress(const char *src, size_t size, char *dst, size_t dst_size);
+};
+
+}  // namespace huadb
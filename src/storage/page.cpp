@@ -1,10 +1,11 @@
 #include "storage/page.h"
 
 #include "common/constants.h"
+#include "common/exceptions.h"
 
 namespace huadb {
 
-Page::Page() { data_ = new char[DB_PAGE_SIZE]; }
+Page::Page(size_t page_size) : page_size_(page_size) { data_ = new char[page_size_]; }
 
 Page::~Page() { delete[] data_; }
 
@@ -12,6 +13,23 @@ void Page::SetDirty() { is_dirty_ = true; }
 
 bool Page::IsDirty() const { return is_dirty_; }
 
+void Page::ClearDirty() { is_dirty_ = false; }
+
 char *Page::GetData() const { return data_; }
 
+size_t Page::GetPageSize() const { return page_size_; }
+
+void Page::Pin() { pin_count_++; }
+
+void Page::Unpin() {
+  auto pin_count = pin_count_.load();
+  do {
+    if (pin_count == 0) {
+      throw DbException("Unpin a page which is not pinned");
+    }
+  } while (!pin_count_.compare_exchange_weak(pin_count, pin_count - 1));
+}
+
+uint32_t Page::GetPinCount() const { return pin_count_; }
+
 }  // namespace huadb
@@ -1,18 +1,34 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
 namespace huadb {
 
 class Page {
  public:
-  Page();
+  explicit Page(size_t page_size);
   ~Page();
   void SetDirty();
   bool IsDirty() const;
+  // 页面写回磁盘后清除脏标记
+  void ClearDirty();
   char *GetData() const;
+  size_t GetPageSize() const;
+
+  // 固定页面，被固定的页面不会被 buffer pool 淘汰
+  void Pin();
+  // 解除页面固定
+  void Unpin();
+  // 获取页面被固定的次数
+  uint32_t GetPinCount() const;
 
  private:
   char *data_;
+  size_t page_size_;
   bool is_dirty_ = false;
+  std::atomic<uint32_t> pin_count_ = 0;
 };
 
 }  // namespace huadb
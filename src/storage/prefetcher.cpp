@@ -0,0 +1,85 @@
+#include "storage/prefetcher.h"
+
+#include "common/exceptions.h"
+#include "storage/buffer_pool.h"
+#include "table/table_page.h"
+
+namespace huadb {
+
+Prefetcher::Prefetcher(BufferPool &buffer_pool, size_t thread_count) : buffer_pool_(buffer_pool) {
+  for (size_t i = 0; i < thread_count; i++) {
+    threads_.emplace_back(&Prefetcher::Work, this);
+  }
+}
+
+Prefetcher::~Prefetcher() {
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+    generation_++;
+    requests_.clear();
+  }
+  cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void Prefetcher::Prefetch(oid_t db_oid, oid_t table_oid, pageid_t page_id, size_t page_count) {
+  {
+    std::scoped_lock lock(mutex_);
+    requests_.push_back({db_oid, table_oid, page_id, page_count});
+  }
+  cv_.notify_one();
+}
+
+void Prefetcher::Cancel() {
+  std::unique_lock lock(mutex_);
+  generation_++;
+  requests_.clear();
+  idle_cv_.wait(lock, [this] { return running_ == 0; });
+}
+
+void Prefetcher::Work() {
+  while (true) {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+    if (stop_) {
+      return;
+    }
+    auto request = requests_.front();
+    requests_.pop_front();
+    auto generation = generation_;
+    running_++;
+    lock.unlock();
+    Run(request, generation);
+    lock.lock();
+    running_--;
+    lock.unlock();
+    idle_cv_.notify_all();
+  }
+}
+
+void Prefetcher::Run(const Request &request, uint64_t generation) {
+  auto page_id = request.page_id_;
+  try {
+    // 页面号保存在前一个页面中，需依次读入页面才能获得下一个页面号
+    for (size_t i = 0; i <= request.page_count_; i++) {
+      {
+        std::scoped_lock lock(mutex_);
+        if (generation != generation_) {
+          return;
+        }
+      }
+      auto page = buffer_pool_.PrefetchPage(request.db_oid_, request.table_oid_, page_id);
+      page_id = TablePage(page).GetNextPageId();
+      if (page_id == NULL_PAGE_ID) {
+        return;
+      }
+    }
+  } catch (DbException &e) {
+    // 预读失败（如表已被删除或缓存页面均被固定）不影响查询，由扫描时按需读取
+  }
+}
+
+}  // namespace huadb
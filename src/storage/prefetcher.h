@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/types.h"
+
+namespace huadb {
+
+class BufferPool;
+
+// 预读线程池，后台沿页面链表将页面读入 buffer pool
+class Prefetcher {
+ public:
+  explicit Prefetcher(BufferPool &buffer_pool, size_t thread_count = PREFETCH_THREAD_COUNT);
+  ~Prefetcher();
+
+  // 提交预读请求：读入 page_id 之后的 page_count 个页面，page_id 为扫描当前所在页面
+  void Prefetch(oid_t db_oid, oid_t table_oid, pageid_t page_id, size_t page_count);
+  // 丢弃未执行的请求，并等待执行中的请求结束
+  void Cancel();
+
+ private:
+  struct Request {
+    oid_t db_oid_;
+    oid_t table_oid_;
+    pageid_t page_id_;
+    size_t page_count_;
+  };
+
+  void Work();
+  void Run(const Request &request, uint64_t generation);
+
+  BufferPool &buffer_pool_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;       // 有新请求或需要停止
+  std::condition_variable idle_cv_;  // 执行中的请求数减少
+  std::deque<Request> requests_;
+  size_t running_ = 0;      // 执行中的请求数
+  uint64_t generation_ = 0;  // 每次取消时递增，执行中的请求发现变化后提前结束
+  bool stop_ = false;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,65 @@
+#include "storage/two_queue_buffer_strategy.h"
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+TwoQueueBufferStrategy::TwoQueueBufferStrategy(double a1_ratio) : a1_ratio_(a1_ratio) {}
+
+void TwoQueueBufferStrategy::Access(size_t frame_no) {
+  auto position = positions_.find(frame_no);
+  if (position == positions_.end()) {
+    a1_.emplace_front(frame_no);
+    positions_[frame_no] = {false, a1_.begin()};
+  } else if (position->second.in_am_) {
+    am_.splice(am_.begin(), am_, position->second.iter_);
+  } else if (frame_no != last_frame_no_) {
+    am_.splice(am_.begin(), a1_, position->second.iter_);
+    position->second.in_am_ = true;
+  }
+  last_frame_no_ = frame_no;
+}
+
+size_t TwoQueueBufferStrategy::Evict(const std::function<bool(size_t)> &evictable) {
+  size_t victim;
+  bool a1_first = a1_.size() > 1 && a1_.size() >= (a1_.size() + am_.size()) * a1_ratio_;
+  auto &first = a1_first ? a1_ : am_;
+  auto &second = a1_first ? am_ : a1_;
+  if (EvictFrom(first, evictable, victim) || EvictFrom(second, evictable, victim)) {
+    positions_.erase(victim);
+    if (victim == last_frame_no_) {
+      last_frame_no_ = -1;
+    }
+    return victim;
+  }
+  throw DbException("No evictable frame in buffer pool");
+}
+
+std::vector<size_t> TwoQueueBufferStrategy::GetVictims(size_t count,
+                                                       const std::function<bool(size_t)> &evictable) const {
+  // 按 Evict 的顺序近似：淘汰过程中 A1 的长度会变化，这里不模拟两个队列之间的切换
+  bool a1_first = a1_.size() > 1 && a1_.size() >= (a1_.size() + am_.size()) * a1_ratio_;
+  std::vector<size_t> victims;
+  for (const auto *queue : {a1_first ? &a1_ : &am_, a1_first ? &am_ : &a1_}) {
+    for (auto iter = queue->rbegin(); iter != queue->rend() && victims.size() < count; ++iter) {
+      if (evictable(*iter)) {
+        victims.push_back(*iter);
+      }
+    }
+  }
+  return victims;
+}
+
+bool TwoQueueBufferStrategy::EvictFrom(std::list<size_t> &queue, const std::function<bool(size_t)> &evictable,
+                                       size_t &victim) {
+  for (auto iter = queue.rbegin(); iter != queue.rend(); ++iter) {
+    if (evictable(*iter)) {
+      victim = *iter;
+      queue.erase(std::next(iter).base());
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace huadb
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+#include "storage/buffer_strategy.h"
+
+namespace huadb {
+
+// Simplified 2Q 替换策略：首次访问的页面进入 FIFO 队列 A1，再次访问时进入 LRU 队列 Am
+// A1 超过缓存页面数的 a1_ratio 时优先从 A1 淘汰，因此只访问一次的扫描页面不会挤出 Am 中的热点页面
+// 连续访问同一页面视为一次相关访问，不会将页面提升到 Am
+class TwoQueueBufferStrategy : public BufferStrategy {
+ public:
+  explicit TwoQueueBufferStrategy(double a1_ratio = 0.25);
+
+  void Access(size_t frame_no) override;
+  size_t Evict(const std::function<bool(size_t)> &evictable) override;
+  std::vector<size_t> GetVictims(size_t count, const std::function<bool(size_t)> &evictable) const override;
+
+ private:
+  struct Position {
+    bool in_am_;
+    std::list<size_t>::iterator iter_;
+  };
+  // 从 queue 尾部淘汰第一个可淘汰的页面，没有可淘汰页面时返回 false
+  bool EvictFrom(std::list<size_t> &queue, const std::function<bool(size_t)> &evictable, size_t &victim);
+
+  double a1_ratio_;
+  size_t last_frame_no_ = -1;
+  std::list<size_t> a1_;  // 只访问过一次的页面，头部为最新进入的页面
+  std::list<size_t> am_;  // 多次访问的页面，头部为最近访问的页面
+  std::unordered_map<size_t, Position> positions_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,70 @@
+#include "table/bulk_loader.h"
+
+#include <cstring>
+
+namespace huadb {
+
+BulkLoader::BulkLoader(Table &table, size_t page_size, xid_t xid, cid_t cid, RecordCallback on_append)
+    : table_(table), xid_(xid), cid_(cid), page_(std::make_shared<Page>(page_size)), on_append_(std::move(on_append)) {
+  if (table_.GetLayout() == TableLayout::PAX) {
+    pax_page_ = std::make_unique<PaxPage>(page_, table_.GetColumnList());
+  } else {
+    table_page_ = std::make_unique<TablePage>(page_);
+  }
+  ResetPage();
+}
+
+void BulkLoader::Append(std::shared_ptr<Record> record) {
+  if (record->GetSize() > MaxRecordSize(page_->GetPageSize())) {
+    throw DbException("Record size too large: " + std::to_string(record->GetSize()));
+  }
+  bool fits;
+  if (pax_page_ != nullptr) {
+    fits = pax_page_->GetFreeSpaceSize() >= PaxPage::GetInsertSize(*record);
+  } else {
+    fits = table_page_->GetFreeSpaceSize() >= record->GetSize();
+  }
+  if (!fits) {
+    FlushPage();
+  }
+  slotid_t slot_id;
+  if (pax_page_ != nullptr) {
+    slot_id = pax_page_->InsertRecord(record, xid_, cid_);
+  } else {
+    slot_id = table_page_->InsertRecord(record, xid_, cid_);
+  }
+  if (on_append_) {
+    page_records_.emplace_back(std::move(record), slot_id);
+  }
+  page_record_count_++;
+  record_count_++;
+}
+
+uint32_t BulkLoader::Finish() {
+  if (page_record_count_ > 0) {
+    FlushPage();
+  }
+  return record_count_;
+}
+
+void BulkLoader::ResetPage() {
+  memset(page_->GetData(), 0, page_->GetPageSize());
+  if (pax_page_ != nullptr) {
+    pax_page_->Init();
+  } else {
+    table_page_->Init();
+  }
+  page_records_.clear();
+  page_record_count_ = 0;
+}
+
+void BulkLoader::FlushPage() {
+  auto page_id = table_.AppendPage(*page_, xid_);
+  for (auto &[record, slot_id] : page_records_) {
+    record->SetRid({page_id, slot_id});
+    on_append_(*record);
+  }
+  ResetPage();
+}
+
+}  // namespace huadb
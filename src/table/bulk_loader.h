@@ -0,0 +1,47 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "storage/page.h"
+#include "table/pax_page.h"
+#include "table/table.h"
+#include "table/table_page.h"
+
+namespace huadb {
+
+// 批量导入，在内存中将记录依次装入新页面，页面装满后整页追加到表末尾，每个页面只写一条日志
+// 不使用表中已有页面的剩余空间，记录的 xmin 和 cid 为导入事务的 xid 和 cid
+class BulkLoader {
+ public:
+  // 页面追加到表中后对其中的每条记录调用 on_append，记录的 rid 已设置，用于维护索引
+  using RecordCallback = std::function<void(const Record &)>;
+
+  BulkLoader(Table &table, size_t page_size, xid_t xid, cid_t cid, RecordCallback on_append = nullptr);
+
+  // 添加一条记录，当前页面放不下时先将当前页面追加到表中
+  void Append(std::shared_ptr<Record> record);
+  // 追加最后一个未满的页面，返回导入的记录数
+  uint32_t Finish();
+
+ private:
+  // 清空并初始化内存中的页面
+  void ResetPage();
+  // 将内存中的页面追加到表中
+  void FlushPage();
+
+  Table &table_;
+  xid_t xid_;
+  cid_t cid_;
+  std::shared_ptr<Page> page_;  // 正在装入记录的页面，不在 buffer pool 中
+  std::unique_ptr<TablePage> table_page_;
+  std::unique_ptr<PaxPage> pax_page_;
+  RecordCallback on_append_;
+  // 当前页面中的记录及其槽号，仅在设置 on_append_ 时保存
+  std::vector<std::pair<std::shared_ptr<Record>, slotid_t>> page_records_;
+  uint32_t page_record_count_ = 0;  // 当前页面中的记录数
+  uint32_t record_count_ = 0;       // 已导入的记录数
+};
+
+}  // namespace huadb
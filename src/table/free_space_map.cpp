@@ -0,0 +1,72 @@
+#include "table/free_space_map.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include "storage/disk.h"
+
+namespace huadb {
+
+static constexpr size_t FSM_CATEGORY_COUNT = std::numeric_limits<uint8_t>::max() + 1;
+
+FreeSpaceMap::FreeSpaceMap(oid_t db_oid, oid_t table_oid, size_t page_size)
+    : db_oid_(db_oid), table_oid_(table_oid), category_size_(std::max<size_t>(page_size / FSM_CATEGORY_COUNT, 1)) {}
+
+void FreeSpaceMap::Load(pageid_t page_count) {
+  std::scoped_lock lock(mutex_);
+  categories_.clear();
+  search_hint_ = 0;
+  std::ifstream in(Disk::GetFreeSpaceMapPath(db_oid_, table_oid_), std::ios::binary);
+  if (!in) {
+    return;
+  }
+  categories_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  // 崩溃后表文件可能短于映射表，未写入的页面需通过页面链表重新发现
+  if (categories_.size() > page_count) {
+    categories_.resize(page_count);
+  }
+}
+
+void FreeSpaceMap::Save() const {
+  std::scoped_lock lock(mutex_);
+  std::ofstream out(Disk::GetFreeSpaceMapPath(db_oid_, table_oid_), std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(categories_.data()), categories_.size());
+}
+
+pageid_t FreeSpaceMap::FindPage(db_size_t size) {
+  std::scoped_lock lock(mutex_);
+  auto required = (size + category_size_ - 1) / category_size_;
+  if (required >= FSM_CATEGORY_COUNT) {
+    return NULL_PAGE_ID;
+  }
+  // 批量插入时空闲空间集中在最后找到的页面上，从该页面开始查找，均摊为 O(1)
+  auto count = static_cast<pageid_t>(categories_.size());
+  for (pageid_t i = 0; i < count; i++) {
+    auto page_id = (search_hint_ + i) % count;
+    if (categories_[page_id] >= required) {
+      search_hint_ = page_id;
+      return page_id;
+    }
+  }
+  return NULL_PAGE_ID;
+}
+
+void FreeSpaceMap::Update(pageid_t page_id, db_size_t free_space) {
+  std::scoped_lock lock(mutex_);
+  if (page_id >= categories_.size()) {
+    categories_.resize(page_id + 1, 0);
+  }
+  categories_[page_id] = ToCategory(free_space);
+}
+
+pageid_t FreeSpaceMap::GetPageCount() const {
+  std::scoped_lock lock(mutex_);
+  return categories_.size();
+}
+
+uint8_t FreeSpaceMap::ToCategory(db_size_t free_space) const {
+  return std::min<size_t>(free_space / category_size_, FSM_CATEGORY_COUNT - 1);
+}
+
+}  // namespace huadb
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "common/types.h"
+
+namespace huadb {
+
+// 空闲空间映射表，每个页面用 1 字节记录剩余空间等级（剩余空间 / (页面大小 / 256)，向下取整）
+// 映射表只是插入位置的提示，使用前需检查页面的实际剩余空间，发现过时记录时修正
+// 映射表保存在表文件旁的 _fsm 文件中，不写日志，仅在页面写回后持久化
+class FreeSpaceMap {
+ public:
+  FreeSpaceMap(oid_t db_oid, oid_t table_oid, size_t page_size);
+
+  // 从文件加载映射表，只保留前 page_count 个页面（已写入表文件的页面）的记录
+  void Load(pageid_t page_count);
+  // 将映射表写入文件
+  void Save() const;
+
+  // 查找剩余空间不少于 size 的页面，从上次找到的页面开始查找，不存在时返回 NULL_PAGE_ID
+  pageid_t FindPage(db_size_t size);
+  // 更新页面剩余空间，page_id 为下一个页面时追加记录
+  void Update(pageid_t page_id, db_size_t free_space);
+  // 映射表中记录的页面数
+  pageid_t GetPageCount() const;
+
+ private:
+  uint8_t ToCategory(db_size_t free_space) const;
+
+  oid_t db_oid_;
+  oid_t table_oid_;
+  size_t category_size_;  // 每个等级对应的字节数
+
+  mutable std::mutex mutex_;
+  std::vector<uint8_t> categories_;  // 页面号到剩余空间等级的映射
+  pageid_t search_hint_ = 0;         // 下次查找的起始页面
+};
+
+}  // namespace huadb
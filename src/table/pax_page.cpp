@@ -0,0 +1,307 @@
+#include "table/pax_page.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <tuple>
+
+#include "common/exceptions.h"
+#include "table/record_header.h"
+
+namespace huadb {
+
+PaxPage::PaxPage(std::shared_ptr<Page> page, const ColumnList &column_list)
+    : page_(std::move(page)), column_list_(column_list) {
+  page_data_ = page_->GetData();
+  db_size_t offset = 0;
+  page_lsn_ = reinterpret_cast<lsn_t *>(page_data_);
+  offset += sizeof(lsn_t);
+  next_page_id_ = reinterpret_cast<pageid_t *>(page_data_ + offset);
+  offset += sizeof(pageid_t);
+  record_count_ = reinterpret_cast<db_size_t *>(page_data_ + offset);
+  offset += sizeof(db_size_t);
+  upper_ = reinterpret_cast<db_size_t *>(page_data_ + offset);
+  offset += sizeof(db_size_t);
+  capacity_ = reinterpret_cast<db_size_t *>(page_data_ + offset);
+  offset += sizeof(db_size_t);
+  assert(offset == PAX_PAGE_HEADER_SIZE);
+  ComputeLayout();
+}
+
+void PaxPage::Init() {
+  *page_lsn_ = 0;
+  *next_page_id_ = NULL_PAGE_ID;
+  *record_count_ = 0;
+  *upper_ = page_->GetPageSize();
+  *capacity_ = ComputeCapacity(column_list_, page_->GetPageSize());
+  ComputeLayout();
+  page_->SetDirty();
+}
+
+slotid_t PaxPage::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid) {
+  record->SetXmin(xid);
+  record->SetCid(cid);
+  // 优先复用清理回收的槽位
+  slotid_t slot_id = 0;
+  while (slot_id < *record_count_ && IsSlotUsed(slot_id)) {
+    slot_id++;
+  }
+  assert(slot_id < *capacity_);
+  WriteRecord(slot_id, *record);
+  return slot_id;
+}
+
+void PaxPage::DeleteRecord(slotid_t slot_id, xid_t xid) {
+  auto *header = page_data_ + PAX_PAGE_HEADER_SIZE + slot_id * RECORD_HEADER_SIZE;
+  header[0] = RECORD_DELETED_FLAG;
+  memcpy(header + sizeof(bool) + sizeof(xid_t), &xid, sizeof(xid_t));
+  page_->SetDirty();
+}
+
+const char *PaxPage::GetRecordHeader(slotid_t slot_id) const {
+  return page_data_ + PAX_PAGE_HEADER_SIZE + slot_id * RECORD_HEADER_SIZE;
+}
+
+bool PaxPage::IsNull(slotid_t slot_id, size_t col_idx) const {
+  auto bits = static_cast<uint8_t>(page_data_[column_offsets_[col_idx] + slot_id / 8]);
+  return (bits & (1U << (slot_id % 8))) != 0;
+}
+
+Value PaxPage::GetValue(slotid_t slot_id, size_t col_idx) const {
+  if (IsNull(slot_id, col_idx)) {
+    return Value();
+  }
+  const auto &column = column_list_.GetColumn(col_idx);
+  auto value = Value(column.type_, column.max_size_);
+  auto *data = GetColumnData(slot_id, col_idx);
+  if (TypeUtil::IsString(column.type_)) {
+    db_size_t offset;
+    memcpy(&offset, data, sizeof(db_size_t));
+    data = page_data_ + offset;
+  }
+  value.DeserializeFrom(data);
+  return value;
+}
+
+std::shared_ptr<Page> PaxPage::GetPage() const { return page_; }
+
+bool PaxPage::IsSlotUsed(slotid_t slot_id) const {
+  return (static_cast<uint8_t>(GetRecordHeader(slot_id)[0]) & RECORD_UNUSED_FLAG) == 0;
+}
+
+std::vector<slotid_t> PaxPage::GetDeadSlots(xid_t oldest_xmin) const {
+  std::vector<slotid_t> slot_ids;
+  Record record;
+  for (slotid_t slot_id = 0; slot_id < *record_count_; slot_id++) {
+    if (!IsSlotUsed(slot_id)) {
+      continue;
+    }
+    record.DeserializeHeaderFrom(GetRecordHeader(slot_id));
+    if (record.IsDeleted() && record.GetXmax() < oldest_xmin) {
+      slot_ids.push_back(slot_id);
+    }
+  }
+  return slot_ids;
+}
+
+db_size_t PaxPage::Compact(const std::vector<slotid_t> &slot_ids) {
+  auto old_upper = *upper_;
+  for (auto slot_id : slot_ids) {
+    page_data_[PAX_PAGE_HEADER_SIZE + slot_id * RECORD_HEADER_SIZE] = RECORD_UNUSED_FLAG;
+  }
+  // 收集仍在使用的变长列值，按偏移从大到小依次移动到页面末尾，与 TablePage::Compact 相同
+  std::vector<std::tuple<db_size_t, slotid_t, size_t>> values;
+  for (size_t col_idx = 0; col_idx < column_list_.Length(); col_idx++) {
+    if (!TypeUtil::IsString(column_list_.GetColumn(col_idx).type_)) {
+      continue;
+    }
+    for (slotid_t slot_id = 0; slot_id < *record_count_; slot_id++) {
+      if (IsSlotUsed(slot_id) && !IsNull(slot_id, col_idx)) {
+        db_size_t offset;
+        memcpy(&offset, GetColumnData(slot_id, col_idx), sizeof(db_size_t));
+        values.emplace_back(offset, slot_id, col_idx);
+      }
+    }
+  }
+  std::sort(values.begin(), values.end(), [](const auto &lhs, const auto &rhs) {
+    return std::get<0>(lhs) > std::get<0>(rhs);
+  });
+  db_size_t upper = page_->GetPageSize();
+  for (const auto &[offset, slot_id, col_idx] : values) {
+    db_size_t str_size;
+    memcpy(&str_size, page_data_ + offset, sizeof(db_size_t));
+    db_size_t size = str_size + sizeof(db_size_t);
+    upper -= size;
+    memmove(page_data_ + upper, page_data_ + offset, size);
+    memcpy(GetColumnData(slot_id, col_idx), &upper, sizeof(db_size_t));
+  }
+  *upper_ = upper;
+  while (*record_count_ > 0 && !IsSlotUsed(*record_count_ - 1)) {
+    (*record_count_)--;
+  }
+  page_->SetDirty();
+  db_size_t row_size = RECORD_HEADER_SIZE;
+  for (const auto &column : column_list_.GetColumns()) {
+    row_size += ColumnWidth(column);
+  }
+  return (*upper_ - old_upper) + slot_ids.size() * row_size;
+}
+
+void PaxPage::UndoDeleteRecord(slotid_t slot_id) {
+  auto *header = page_data_ + PAX_PAGE_HEADER_SIZE + slot_id * RECORD_HEADER_SIZE;
+  header[0] = 0;
+  xid_t xmax = NULL_XID;
+  memcpy(header + sizeof(bool) + sizeof(xid_t), &xmax, sizeof(xid_t));
+  page_->SetDirty();
+}
+
+void PaxPage::RedoInsertRecord(slotid_t slot_id, const char *raw_record) {
+  Record record;
+  record.DeserializeFrom(raw_record, column_list_);
+  WriteRecord(slot_id, record);
+}
+
+db_size_t PaxPage::GetRecordCount() const { return *record_count_; }
+
+lsn_t PaxPage::GetPageLSN() const { return *page_lsn_; }
+
+pageid_t PaxPage::GetNextPageId() const { return *next_page_id_; }
+
+db_size_t PaxPage::GetFreeSpaceSize() const {
+  if (*record_count_ >= *capacity_) {
+    slotid_t slot_id = 0;
+    while (slot_id < *record_count_ && IsSlotUsed(slot_id)) {
+      slot_id++;
+    }
+    if (slot_id == *record_count_) {
+      return 0;
+    }
+  }
+  return *upper_ - fixed_end_ + 1;
+}
+
+void PaxPage::SetNextPageId(pageid_t page_id) {
+  *next_page_id_ = page_id;
+  page_->SetDirty();
+}
+
+std::string PaxPage::ToString() const {
+  std::ostringstream oss;
+  oss << "PaxPage[" << std::endl;
+  oss << "  page_lsn: " << *page_lsn_ << std::endl;
+  oss << "  next_page_id: " << *next_page_id_ << std::endl;
+  oss << "  record_count: " << *record_count_ << std::endl;
+  oss << "  upper: " << *upper_ << std::endl;
+  oss << "  capacity: " << *capacity_ << std::endl;
+  if (PAX_PAGE_HEADER_SIZE + static_cast<size_t>(*capacity_) * RECORD_HEADER_SIZE > page_->GetPageSize()) {
+    oss << "\n***Error: record headers out of page boundary***" << std::endl;
+  } else if (*record_count_ > *capacity_) {
+    oss << "\n***Error: record_count > capacity***" << std::endl;
+  } else {
+    if (*upper_ < fixed_end_ || *upper_ > page_->GetPageSize()) {
+      oss << "\n***Error: upper out of variable-length area***" << std::endl;
+    }
+    oss << "  slots: " << std::endl;
+    for (slotid_t slot_id = 0; slot_id < *record_count_; slot_id++) {
+      oss << "    " << slot_id << ": ";
+      if (!IsSlotUsed(slot_id)) {
+        oss << "unused" << std::endl;
+      } else {
+        RecordHeader header;
+        header.DeserializeFrom(GetRecordHeader(slot_id));
+        oss << header.ToString() << std::endl;
+      }
+    }
+  }
+  oss << "]\n";
+  return oss.str();
+}
+
+void PaxPage::SetPageLSN(lsn_t page_lsn) {
+  *page_lsn_ = page_lsn;
+  page_->SetDirty();
+}
+
+db_size_t PaxPage::GetInsertSize(const Record &record) {
+  db_size_t size = 1;
+  for (const auto &value : record.GetValues()) {
+    if (!value.IsNull() && TypeUtil::IsString(value.GetType())) {
+      size += value.GetSize() + sizeof(db_size_t);
+    }
+  }
+  return size;
+}
+
+db_size_t PaxPage::ComputeCapacity(const ColumnList &column_list, size_t page_size) {
+  size_t row_size = RECORD_HEADER_SIZE;
+  size_t var_size = 0;
+  size_t max_var_size = 0;
+  for (const auto &column : column_list.GetColumns()) {
+    row_size += ColumnWidth(column);
+    if (TypeUtil::IsString(column.type_)) {
+      var_size += column.max_size_ / 2 + sizeof(db_size_t);
+      max_var_size += column.max_size_ + sizeof(db_size_t);
+    }
+  }
+  auto fixed_size = [&](size_t capacity) { return capacity * row_size + column_list.Length() * ((capacity + 7) / 8); };
+  size_t available = page_size - PAX_PAGE_HEADER_SIZE;
+  size_t capacity = available / (row_size + var_size);
+  while (capacity > 0 && (fixed_size(capacity) + capacity * var_size > available ||
+                          fixed_size(capacity) + max_var_size > available)) {
+    capacity--;
+  }
+  if (capacity == 0) {
+    throw DbException("Record too large for pax layout with page size " + std::to_string(page_size));
+  }
+  return capacity;
+}
+
+void PaxPage::ComputeLayout() {
+  bitmap_size_ = (*capacity_ + 7) / 8;
+  column_offsets_.clear();
+  db_size_t offset = PAX_PAGE_HEADER_SIZE + *capacity_ * RECORD_HEADER_SIZE;
+  for (const auto &column : column_list_.GetColumns()) {
+    column_offsets_.push_back(offset);
+    offset += bitmap_size_ + *capacity_ * ColumnWidth(column);
+  }
+  fixed_end_ = offset;
+}
+
+void PaxPage::WriteRecord(slotid_t slot_id, const Record &record) {
+  record.SerializeHeaderTo(page_data_ + PAX_PAGE_HEADER_SIZE + slot_id * RECORD_HEADER_SIZE);
+  for (size_t col_idx = 0; col_idx < column_list_.Length(); col_idx++) {
+    const auto &value = record.GetValue(col_idx);
+    auto &bits = reinterpret_cast<uint8_t &>(page_data_[column_offsets_[col_idx] + slot_id / 8]);
+    if (value.IsNull()) {
+      bits |= (1U << (slot_id % 8));
+      continue;
+    }
+    bits &= ~(1U << (slot_id % 8));
+    auto *data = GetColumnData(slot_id, col_idx);
+    if (TypeUtil::IsString(column_list_.GetColumn(col_idx).type_)) {
+      *upper_ -= value.GetSize() + sizeof(db_size_t);
+      assert(*upper_ >= fixed_end_);
+      value.SerializeTo(page_data_ + *upper_);
+      memcpy(data, upper_, sizeof(db_size_t));
+    } else {
+      value.SerializeTo(data);
+    }
+  }
+  *record_count_ = std::max<db_size_t>(*record_count_, slot_id + 1);
+  page_->SetDirty();
+}
+
+char *PaxPage::GetColumnData(slotid_t slot_id, size_t col_idx) const {
+  const auto &column = column_list_.GetColumn(col_idx);
+  return page_data_ + column_offsets_[col_idx] + bitmap_size_ + slot_id * ColumnWidth(column);
+}
+
+db_size_t PaxPage::ColumnWidth(const ColumnDefinition &column) {
+  if (TypeUtil::IsString(column.type_)) {
+    return sizeof(db_size_t);
+  }
+  return column.max_size_;
+}
+
+}  // namespace huadb
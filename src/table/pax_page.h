@@ -0,0 +1,100 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/column_list.h"
+#include "common/types.h"
+#include "storage/page.h"
+#include "table/record.h"
+
+namespace huadb {
+
+// page_lsn(8) + next_page(4) + record_count(2) + upper(2) + capacity(2) = 18
+// page_lsn 和 next_page 的位置与 TablePage 相同，buffer pool 和预读可统一通过 TablePage 读取
+static constexpr db_size_t PAX_PAGE_HEADER_SIZE =
+    sizeof(lsn_t) + sizeof(pageid_t) + sizeof(db_size_t) + sizeof(db_size_t) + sizeof(db_size_t);
+
+// 记录头标记位，PAX 页面中已被清理回收的槽位
+static constexpr uint8_t RECORD_UNUSED_FLAG = 4;
+
+// PAX 页面：页头之后依次为 capacity 个记录头，以及每列一个 minipage
+// 每个 minipage 由该列的空值位图和 capacity 个列值组成，定长列直接存放列值
+// 变长列存放列值在页面末尾变长数据区中的偏移，变长数据区从页面末尾向前增长至 upper
+// capacity 在页面初始化时根据表结构确定，扫描单列时只需访问该列的 minipage
+class PaxPage {
+ public:
+  PaxPage(std::shared_ptr<Page> page, const ColumnList &column_list);
+
+  // 页面初始化
+  void Init();
+
+  // 插入记录，优先复用已回收的槽位，返回插入的槽号，调用前需确认 GetFreeSpaceSize() 不小于 GetInsertSize(*record)
+  slotid_t InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid);
+  // 删除记录
+  void DeleteRecord(slotid_t slot_id, xid_t xid);
+
+  // 获取记录头在页面中的起始地址，记录头格式与行存记录相同
+  const char *GetRecordHeader(slotid_t slot_id) const;
+  // 第 col_idx 列是否为空
+  bool IsNull(slotid_t slot_id, size_t col_idx) const;
+  // 获取第 col_idx 列的值
+  Value GetValue(slotid_t slot_id, size_t col_idx) const;
+  // 获取页面
+  std::shared_ptr<Page> GetPage() const;
+
+  // 槽位是否仍在使用
+  bool IsSlotUsed(slotid_t slot_id) const;
+  // 获取已删除且删除事务早于 oldest_xmin 的记录的槽号
+  std::vector<slotid_t> GetDeadSlots(xid_t oldest_xmin) const;
+  // 回收 slot_ids 对应的槽位和变长数据并整理变长数据区，截断末尾不再使用的槽位，返回回收的字节数
+  db_size_t Compact(const std::vector<slotid_t> &slot_ids);
+
+  // 回滚删除操作
+  void UndoDeleteRecord(slotid_t slot_id);
+  // 重做插入操作，raw_record 为行存格式的记录
+  void RedoInsertRecord(slotid_t slot_id, const char *raw_record);
+
+  // 获取记录数目
+  db_size_t GetRecordCount() const;
+  lsn_t GetPageLSN() const;
+  pageid_t GetNextPageId() const;
+  // 获取页面剩余空间大小，为变长数据区的空闲字节数加 1，没有可用槽位时为 0
+  db_size_t GetFreeSpaceSize() const;
+
+  void SetNextPageId(pageid_t page_id);
+  void SetPageLSN(lsn_t page_lsn);
+
+  std::string ToString() const;
+
+  // 插入记录所需的空间，为变长列值的字节数加 1，保证不会选中槽位已满的页面
+  static db_size_t GetInsertSize(const Record &record);
+  // 根据表结构计算每个页面可存放的记录数，估算时假设变长列平均占用一半的最大长度
+  // 同时保证最长的记录可以插入空页面，无法满足时抛出异常
+  static db_size_t ComputeCapacity(const ColumnList &column_list, size_t page_size);
+
+ private:
+  // 根据 capacity 计算各 minipage 的位置
+  void ComputeLayout();
+  // 将记录头和列值写入 slot_id 对应的位置
+  void WriteRecord(slotid_t slot_id, const Record &record);
+  // 获取列值在 minipage 中的起始地址
+  char *GetColumnData(slotid_t slot_id, size_t col_idx) const;
+  // 列值在 minipage 中占用的字节数，变长列为变长数据区中的偏移
+  static db_size_t ColumnWidth(const ColumnDefinition &column);
+
+  std::shared_ptr<Page> page_;
+  const ColumnList &column_list_;
+  char *page_data_;
+  lsn_t *page_lsn_;
+  pageid_t *next_page_id_;
+  db_size_t *record_count_;
+  db_size_t *upper_;     // 变长数据区起始位置
+  db_size_t *capacity_;  // 页面可存放的记录数
+  std::vector<db_size_t> column_offsets_;  // 各列 minipage 的起始位置
+  db_size_t bitmap_size_ = 0;              // 每列空值位图的字节数
+  db_size_t fixed_end_ = 0;                // 定长部分的结束位置，变长数据区不能低于该位置
+};
+
+}  // namespace huadb
@@ -7,16 +7,39 @@
 namespace huadb {
 
 Record::Record(std::vector<Value> values, Rid rid)
-    : null_bitmap_(values.size()), values_(std::move(values)), rid_(rid) {
-  for (size_t i = 0; i < values_.size(); i++) {
-    if (values_[i].IsNull()) {
-      null_bitmap_.Set(i);
-    }
-  }
-  UpdateSize();
+    : null_bitmap_(values.size()),
+      values_(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end())),
+      rid_(rid) {
+  InitNullBitmap();
+}
+
+Record::Record(std::allocator_arg_t, const allocator_type &alloc) : null_bitmap_(0, alloc), values_(alloc) {}
+
+Record::Record(std::allocator_arg_t, const allocator_type &alloc, std::pmr::vector<Value> values, Rid rid)
+    : null_bitmap_(values.size(), alloc), values_(std::move(values), alloc), rid_(rid) {
+  InitNullBitmap();
+}
+
+Record::Record(std::allocator_arg_t, const allocator_type &alloc, const Record &other)
+    : null_bitmap_(other.null_bitmap_, alloc),
+      values_(other.values_, alloc),
+      header_(other.header_),
+      rid_(other.rid_),
+      size_(other.size_) {}
+
+Record::Record(std::allocator_arg_t, const allocator_type &alloc, const Record &left, const Record &right)
+    : null_bitmap_(left.values_.size() + right.values_.size(), alloc),
+      values_(alloc),
+      header_(left.header_),
+      rid_(left.rid_) {
+  values_.reserve(left.values_.size() + right.values_.size());
+  values_.insert(values_.end(), left.values_.begin(), left.values_.end());
+  values_.insert(values_.end(), right.values_.begin(), right.values_.end());
+  InitNullBitmap();
 }
 
 void Record::Append(const Record &record) {
+  values_.reserve(values_.size() + record.GetValues().size());
   null_bitmap_.Resize(null_bitmap_.GetSize() + record.GetValues().size());
   for (const auto &value : record.GetValues()) {
     if (value.IsNull()) {
@@ -29,7 +52,7 @@ void Record::Append(const Record &record) {
   UpdateSize();
 }
 
-Value Record::GetValue(size_t col_idx) const {
+const Value &Record::GetValue(size_t col_idx) const {
   if (col_idx >= values_.size()) {
     throw DbException("Column index out of range");
   }
@@ -46,7 +69,7 @@ void Record::SetValue(size_t col_idx, const Value &value) {
   UpdateSize();
 }
 
-const std::vector<Value> &Record::GetValues() const { return values_; }
+const std::pmr::vector<Value> &Record::GetValues() const { return values_; }
 
 db_size_t Record::GetSize() const { return size_; }
 
@@ -77,6 +100,7 @@ db_size_t Record::DeserializeFrom(const char *data, const ColumnList &column_lis
   null_bitmap_.Resize(column_list.Length());
   offset += null_bitmap_.DeserializeFrom(data + offset);
   auto columns = column_list.GetColumns();
+  values_.reserve(values_.size() + columns.size());
   for (size_t i = 0; i < columns.size(); i++) {
     if (null_bitmap_.Test(i)) {
       values_.push_back(Value());
@@ -115,6 +139,15 @@ Rid Record::GetRid() const { return rid_; }
 
 void Record::SetRid(Rid rid) { rid_ = rid; }
 
+void Record::InitNullBitmap() {
+  for (size_t i = 0; i < values_.size(); i++) {
+    if (values_[i].IsNull()) {
+      null_bitmap_.Set(i);
+    }
+  }
+  UpdateSize();
+}
+
 void Record::UpdateSize() {
   size_ = RECORD_HEADER_SIZE;
   size_ += null_bitmap_.GetBytes();
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -12,16 +14,24 @@ namespace huadb {
 
 class Record {
  public:
+  // 通过 std::allocate_shared 和 std::pmr::polymorphic_allocator 创建记录时，记录及其值数组和空值位图从同一内存区分配
+  using allocator_type = std::pmr::polymorphic_allocator<Value>;
+
   Record() = default;
   explicit Record(std::vector<Value> values, Rid rid = {0, 0});
+  Record(std::allocator_arg_t, const allocator_type &alloc);
+  Record(std::allocator_arg_t, const allocator_type &alloc, std::pmr::vector<Value> values, Rid rid = {0, 0});
+  Record(std::allocator_arg_t, const allocator_type &alloc, const Record &other);
+  // 记录合并，用于 join 算子，结果依次包含 left 和 right 的所有值
+  Record(std::allocator_arg_t, const allocator_type &alloc, const Record &left, const Record &right);
   // 记录合并，用于 join 算子
   void Append(const Record &record);
   // 获取第 col_idx 个 column 的值
-  Value GetValue(size_t col_idx) const;
+  const Value &GetValue(size_t col_idx) const;
   // 设置第 col_idx 个 column 的值
   void SetValue(size_t col_idx, const Value &value);
   // 获取所有 column 的值
-  const std::vector<Value> &GetValues() const;
+  const std::pmr::vector<Value> &GetValues() const;
   // 获取记录的大小
   db_size_t GetSize() const;
   // 将记录转换为字符串
@@ -52,11 +62,12 @@ class Record {
   void SetRid(Rid rid);
 
  private:
+  void InitNullBitmap();
   void UpdateSize();
 
   // 空值位图
   Bitmap null_bitmap_;
-  std::vector<Value> values_;
+  std::pmr::vector<Value> values_;
   RecordHeader header_;
   Rid rid_;
   db_size_t size_;
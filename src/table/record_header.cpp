@@ -8,8 +8,9 @@ namespace huadb {
 
 db_size_t RecordHeader::SerializeTo(char *data) const {
   db_size_t offset = 0;
-  memcpy(data + offset, &deleted_, sizeof(deleted_));
-  offset += sizeof(deleted_);
+  uint8_t flags = (deleted_ ? RECORD_DELETED_FLAG : 0) | (hot_updated_ ? RECORD_HOT_UPDATED_FLAG : 0);
+  memcpy(data + offset, &flags, sizeof(flags));
+  offset += sizeof(flags);
   memcpy(data + offset, &xmin_, sizeof(xmin_));
   offset += sizeof(xmin_);
   memcpy(data + offset, &xmax_, sizeof(xmax_));
@@ -22,8 +23,11 @@ db_size_t RecordHeader::SerializeTo(char *data) const {
 
 db_size_t RecordHeader::DeserializeFrom(const char *data) {
   db_size_t offset = 0;
-  memcpy(&deleted_, data + offset, sizeof(deleted_));
-  offset += sizeof(deleted_);
+  uint8_t flags;
+  memcpy(&flags, data + offset, sizeof(flags));
+  offset += sizeof(flags);
+  deleted_ = (flags & RECORD_DELETED_FLAG) != 0;
+  hot_updated_ = (flags & RECORD_HOT_UPDATED_FLAG) != 0;
   memcpy(&xmin_, data + offset, sizeof(xmin_));
   offset += sizeof(xmin_);
   memcpy(&xmax_, data + offset, sizeof(xmax_));
@@ -37,6 +41,9 @@ db_size_t RecordHeader::DeserializeFrom(const char *data) {
 std::string RecordHeader::ToString() const {
   std::ostringstream oss;
   oss << "[deleted: " << deleted_;
+  if (hot_updated_) {
+    oss << ", hot_updated";
+  }
   oss << ", xmin: " << xmin_;
   oss << ", xmax: " << xmax_;
   oss << ", cid: " << cid_;
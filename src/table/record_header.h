@@ -9,6 +9,11 @@ namespace huadb {
 // deleted(1) + xmin(4) + xmax(4) + cid(4) = 13
 static constexpr db_size_t RECORD_HEADER_SIZE = sizeof(bool) + sizeof(xid_t) + sizeof(xid_t) + sizeof(cid_t);
 
+// 记录头第一个字节的标记位
+static constexpr uint8_t RECORD_DELETED_FLAG = 1;
+// 记录在页内被更新，新版本位于同一页面，此时 cid 字段保存新版本的槽号
+static constexpr uint8_t RECORD_HOT_UPDATED_FLAG = 2;
+
 class RecordHeader {
   friend class Record;
 
@@ -21,6 +26,8 @@ class RecordHeader {
  private:
   // LAB 1: 记录是否删除
   bool deleted_ = false;
+  // 页内更新链，hot_updated_ 为 true 时 cid_ 为同一页面中新版本的槽号
+  bool hot_updated_ = false;
 
   // LAB 3: 记录的事务信息
   xid_t xmin_ = NULL_XID;
@@ -1,25 +1,37 @@
 #include "table/table.h"
 
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+#include "table/pax_page.h"
 #include "table/table_page.h"
+#include "table/tuple_view.h"
 
 namespace huadb {
 
 Table::Table(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, ColumnList column_list,
-             bool new_table, bool is_empty)
+             bool new_table, bool is_empty, TableLayout layout, CompressionType compression)
     : buffer_pool_(buffer_pool),
       log_manager_(log_manager),
       oid_(oid),
       db_oid_(db_oid),
-      column_list_(std::move(column_list)) {
+      column_list_(std::move(column_list)),
+      layout_(layout),
+      compression_(compression),
+      free_space_map_(db_oid, oid, buffer_pool.GetPageSize()),
+      zone_map_(column_list_) {
+  buffer_pool_.SetCompression(db_oid, oid, compression);
   if (new_table || is_empty) {
     first_page_id_ = NULL_PAGE_ID;
   } else {
     first_page_id_ = 0;
+    free_space_map_.Load(std::filesystem::file_size(Disk::GetFilePath(db_oid, oid)) / buffer_pool.GetPageSize());
   }
 }
 
 Rid Table::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bool write_log) {
-  if (record->GetSize() > MAX_RECORD_SIZE) {
+  if (record->GetSize() > MaxRecordSize(buffer_pool_.GetPageSize())) {
     throw DbException("Record size too large: " + std::to_string(record->GetSize()));
   }
 
@@ -31,76 +43,72 @@ Rid Table::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bo
 
   // 使用 buffer_pool_ 获取页面
   // 使用 TablePage 类操作记录页面
-  // 遍历表的页面，判断页面是否有足够的空间插入记录，如果没有则通过 buffer_pool_ 创建新页面
+  // 通过空闲空间映射表查找空间足够的页面，如果没有则通过 buffer_pool_ 创建新页面
   // 如果 first_page_id_ 为 NULL_PAGE_ID，说明表还没有页面，需要创建新页面
   // 创建新页面时需设置前一个页面的 next_page_id，并将新页面初始化
   // 找到空间足够的页面后，通过 TablePage 插入记录
   // 返回插入记录的 rid
   // LAB 1 BEGIN
-  pageid_t currentPageId = 0;
-  slotid_t slotId = 0;
-  
-  // If there's no first page, create one and insert the record into it.
-  if (first_page_id_ == NULL_PAGE_ID) {
-    first_page_id_ = 0;
-    auto firstPage = buffer_pool_.NewPage(db_oid_, oid_, first_page_id_);
-    TablePage firstTablePage(firstPage);
-    firstTablePage.Init();
-    slotId = firstTablePage.InsertRecord(record, xid, cid);
-
-    if (write_log) {
-        // Offset points to the head of the inserted record after updating the upper pointer.
-        db_size_t offset = firstTablePage.GetUpper();
-        char* newRecord = firstTablePage.GetPageData() + offset;
-
-        log_manager_.AppendNewPageLog(xid, oid_, NULL_PAGE_ID, first_page_id_);
-        auto lsn = log_manager_.AppendInsertLog(xid, oid_, first_page_id_, slotId, offset, record->GetSize(), newRecord);
-        firstTablePage.SetPageLSN(lsn);
+  auto page_id = FindPage(layout_ == TableLayout::PAX ? PaxPage::GetInsertSize(*record) : record->GetSize());
+  std::shared_ptr<Page> page;
+  if (page_id != NULL_PAGE_ID) {
+    page = buffer_pool_.GetPage(db_oid_, oid_, page_id);
+  } else {
+    // 映射表已包含页面链表中的所有页面，新页面追加在最后一个页面之后
+    page_id = free_space_map_.GetPageCount();
+    auto prev_page_id = page_id == 0 ? NULL_PAGE_ID : page_id - 1;
+    if (prev_page_id == NULL_PAGE_ID) {
+      first_page_id_ = page_id;
+    } else {
+      // PAX 页面的 next_page 与 TablePage 位于相同位置
+      TablePage prev_page(buffer_pool_.GetPage(db_oid_, oid_, prev_page_id));
+      prev_page.SetNextPageId(page_id);
     }
-    
+    page = buffer_pool_.NewPage(db_oid_, oid_, page_id);
+    if (layout_ == TableLayout::PAX) {
+      PaxPage(page, column_list_).Init();
     } else {
-        // Traverse existing pages to find a page with enough free space.
-        while (currentPageId != NULL_PAGE_ID) {
-            auto currentPage = buffer_pool_.GetPage(db_oid_, oid_, currentPageId);
-            TablePage tablePage(currentPage);
-            
-            // If the current page can accommodate the record, insert it.
-            if (tablePage.GetFreeSpaceSize() >= record->GetSize()) {
-                slotId = tablePage.InsertRecord(record, xid, cid);
-                
-                if (write_log) {
-                    db_size_t offset = tablePage.GetUpper();
-                    char* newRecord = tablePage.GetPageData() + offset;
-                    auto lsn = log_manager_.AppendInsertLog(xid, oid_, currentPageId, slotId, offset, record->GetSize(), newRecord);
-                    tablePage.SetPageLSN(lsn);
-                    }
-                break;
-            }
-            
-            // If there is no next page, create a new page.
-            if (tablePage.GetNextPageId() == NULL_PAGE_ID) {
-                auto newPage = buffer_pool_.NewPage(db_oid_, oid_, currentPageId + 1);
-                TablePage newTablePage(newPage);
-                newTablePage.Init();
-                tablePage.SetNextPageId(currentPageId + 1);
-                slotId = newTablePage.InsertRecord(record, xid, cid);
-                
-                if (write_log) {
-                    db_size_t offset = newTablePage.GetUpper();
-                    char* newRecord = newTablePage.GetPageData() + offset;
-                    log_manager_.AppendNewPageLog(xid, oid_, currentPageId, currentPageId + 1);
-                    auto lsn = log_manager_.AppendInsertLog(xid, oid_, currentPageId + 1, slotId, offset, record->GetSize(), newRecord);
-                    newTablePage.SetPageLSN(lsn);
-                }
-            break;
-        }
-        currentPageId = tablePage.GetNextPageId();
-        }
+      TablePage(page).Init();
     }
-  return {currentPageId, slotId};
+    zone_map_.Reset(page_id);
+    if (write_log) {
+      log_manager_.AppendNewPageLog(xid, oid_, prev_page_id, page_id);
+    }
+  }
+
+  if (layout_ == TableLayout::PAX) {
+    PaxPage pax_page(page, column_list_);
+    auto slot_id = pax_page.InsertRecord(record, xid, cid);
+    if (write_log) {
+      // 日志中保存行存格式的记录，重做时再拆分到各列
+      std::vector<char> raw_record(record->GetSize());
+      record->SerializeTo(raw_record.data());
+      auto lsn = log_manager_.AppendInsertLog(xid, oid_, page_id, slot_id, 0, record->GetSize(), raw_record.data());
+      pax_page.SetPageLSN(lsn);
+    }
+    free_space_map_.Update(page_id, pax_page.GetFreeSpaceSize());
+    zone_map_.Update(page_id, *record);
+    visibility_map_.Clear(page_id);
+    return {page_id, slot_id};
+  }
+
+  TablePage table_page(page);
+  auto slot_id = table_page.InsertRecord(record, xid, cid);
+  if (write_log) {
+    // 插入后 upper 指针指向新记录的起始位置
+    db_size_t offset = table_page.GetUpper();
+    auto lsn = log_manager_.AppendInsertLog(xid, oid_, page_id, slot_id, offset, record->GetSize(),
+                                            table_page.GetPageData() + offset);
+    table_page.SetPageLSN(lsn);
+  }
+  free_space_map_.Update(page_id, table_page.GetFreeSpaceSize());
+  zone_map_.Update(page_id, *record);
+  visibility_map_.Clear(page_id);
+  return {page_id, slot_id};
 }
 
 void Table::DeleteRecord(const Rid &rid, xid_t xid, bool write_log) {
+  // 删除只标记记录，不释放页面空间，空闲空间映射表无需更新
   // 增加写 DeleteLog 过程
   // 设置页面的 page lsn
   // LAB 2 BEGIN
@@ -108,17 +116,119 @@ void Table::DeleteRecord(const Rid &rid, xid_t xid, bool write_log) {
   // 使用 TablePage 操作页面
   // LAB 1 BEGIN
   auto page = buffer_pool_.GetPage(db_oid_, oid_, rid.page_id_);
-  TablePage table_page(page);
-  table_page.DeleteRecord(rid.slot_id_, xid);
-  
+  if (layout_ == TableLayout::PAX) {
+    PaxPage(page, column_list_).DeleteRecord(rid.slot_id_, xid);
+  } else {
+    TablePage(page).DeleteRecord(rid.slot_id_, xid);
+  }
+
   if (write_log) {
     auto lsn = log_manager_.AppendDeleteLog(xid, oid_, rid.page_id_, rid.slot_id_);
+    TablePage(page).SetPageLSN(lsn);
+  }
+  visibility_map_.Clear(rid.page_id_);
+}
+
+Rid Table::UpdateRecord(const Rid &rid, xid_t xid, cid_t cid, std::shared_ptr<Record> record, bool write_log) {
+  if (record->GetSize() > MaxRecordSize(buffer_pool_.GetPageSize())) {
+    throw DbException("Record size too large: " + std::to_string(record->GetSize()));
+  }
+  if (layout_ == TableLayout::PAX) {
+    // PAX 页面不支持页内更新
+    DeleteRecord(rid, xid, write_log);
+    return InsertRecord(record, xid, cid, write_log);
+  }
+  TablePage table_page(buffer_pool_.GetPage(db_oid_, oid_, rid.page_id_));
+  if (table_page.GetFreeSpaceSize() < record->GetSize()) {
+    // 原页面空间不足，新版本写入其他页面
+    DeleteRecord(rid, xid, write_log);
+    return InsertRecord(record, xid, cid, write_log);
+  }
+  // 页内更新：新版本写入同一页面，旧版本的 cid 字段改为指向新版本，只写一条 UpdateLog
+  Record old_header;
+  old_header.DeserializeHeaderFrom(table_page.GetRecordData(rid.slot_id_));
+  auto slot_id = table_page.UpdateRecord(rid.slot_id_, record, xid, cid);
+  if (write_log) {
+    db_size_t offset = table_page.GetUpper();
+    auto lsn = log_manager_.AppendUpdateLog(xid, oid_, rid.page_id_, rid.slot_id_, old_header.GetCid(), slot_id, offset,
+                                            record->GetSize(), table_page.GetPageData() + offset);
     table_page.SetPageLSN(lsn);
+  }
+  free_space_map_.Update(rid.page_id_, table_page.GetFreeSpaceSize());
+  zone_map_.Update(rid.page_id_, *record);
+  visibility_map_.Clear(rid.page_id_);
+  return {rid.page_id_, slot_id};
+}
+
+VacuumStats Table::Vacuum(xid_t xid, xid_t oldest_xmin, const TupleVisitor &on_remove) {
+  VacuumStats stats;
+  VacuumPages(xid, oldest_xmin, first_page_id_, std::numeric_limits<size_t>::max(), stats, on_remove);
+  return stats;
+}
+
+pageid_t Table::VacuumPages(xid_t xid, xid_t oldest_xmin, pageid_t page_id, size_t max_pages, VacuumStats &stats,
+                            const TupleVisitor &on_remove) {
+  // TablePage 和 PaxPage 提供相同的清理接口
+  auto vacuum_page = [&](auto &&table_page, const std::shared_ptr<Page> &page) {
+    auto slot_ids = table_page.GetDeadSlots(oldest_xmin);
+    if (!slot_ids.empty()) {
+      if (on_remove) {
+        VisitTuples(page_id, page, on_remove, &slot_ids);
+      }
+      stats.compacted_pages_++;
+      stats.removed_records_ += slot_ids.size();
+      stats.freed_bytes_ += table_page.Compact(slot_ids);
+      auto lsn = log_manager_.AppendVacuumLog(xid, oid_, page_id, std::move(slot_ids));
+      table_page.SetPageLSN(lsn);
+      free_space_map_.Update(page_id, table_page.GetFreeSpaceSize());
     }
+    return table_page.GetNextPageId();
+  };
+  for (size_t i = 0; i < max_pages && page_id != NULL_PAGE_ID; i++) {
+    auto page = buffer_pool_.GetPage(db_oid_, oid_, page_id);
+    pageid_t next_page_id;
+    if (layout_ == TableLayout::PAX) {
+      next_page_id = vacuum_page(PaxPage(page, column_list_), page);
+    } else {
+      next_page_id = vacuum_page(TablePage(page), page);
     }
-Rid Table::UpdateRecord(const Rid &rid, xid_t xid, cid_t cid, std::shared_ptr<Record> record, bool write_log) {
-  DeleteRecord(rid, xid, write_log);
-  return InsertRecord(record, xid, cid, write_log);
+    // 清理时访问表的所有页面，顺便重建区域映射表，重启后的表也可以跳过页面
+    RebuildZone(page_id, page);
+    bool all_visible = true;
+    VisitTuples(page_id, page, [&](const TupleView &tuple) {
+      all_visible = all_visible && !tuple.IsDeleted() && tuple.GetXmin() < oldest_xmin;
+    });
+    visibility_map_.Set(page_id, all_visible);
+    page_id = next_page_id;
+  }
+  return page_id;
+}
+
+pageid_t Table::AppendPage(const Page &page, xid_t xid) {
+  ScanUnrecordedPages(std::numeric_limits<db_size_t>::max());
+  auto page_id = free_space_map_.GetPageCount();
+  auto prev_page_id = page_id == 0 ? NULL_PAGE_ID : page_id - 1;
+  std::shared_ptr<Page> prev_page;
+  if (prev_page_id == NULL_PAGE_ID) {
+    first_page_id_ = page_id;
+  } else {
+    prev_page = buffer_pool_.GetPage(db_oid_, oid_, prev_page_id);
+    TablePage(prev_page).SetNextPageId(page_id);
+  }
+  auto new_page = buffer_pool_.NewPage(db_oid_, oid_, page_id);
+  memcpy(new_page->GetData(), page.GetData(), page.GetPageSize());
+  auto lsn = log_manager_.AppendBulkInsertLog(xid, oid_, prev_page_id, page_id, GetRecordCount(new_page),
+                                              std::vector<char>(page.GetData(), page.GetData() + page.GetPageSize()));
+  // PAX 页面的 page_lsn 和 next_page 与 TablePage 位于相同位置
+  TablePage(new_page).SetPageLSN(lsn);
+  // 前一个页面的链接由该日志重做，写回前一个页面前同样需要先将该日志刷盘
+  if (prev_page != nullptr) {
+    TablePage(prev_page).SetPageLSN(lsn);
+  }
+  free_space_map_.Update(page_id, GetFreeSpaceSize(new_page));
+  RebuildZone(page_id, new_page);
+  visibility_map_.Clear(page_id);
+  return page_id;
 }
 
 void Table::UpdateRecordInPlace(const Record &record) {
@@ -129,10 +239,128 @@ void Table::UpdateRecordInPlace(const Record &record) {
 
 pageid_t Table::GetFirstPageId() const { return first_page_id_; }
 
+pageid_t Table::GetPageCount() const { return free_space_map_.GetPageCount(); }
+
+void Table::SaveFreeSpaceMap() const { free_space_map_.Save(); }
+
+const ZoneMap &Table::GetZoneMap() const { return zone_map_; }
+
+const VisibilityMap &Table::GetVisibilityMap() const { return visibility_map_; }
+
+pageid_t Table::FindPage(db_size_t size) {
+  while (true) {
+    auto page_id = free_space_map_.FindPage(size);
+    if (page_id == NULL_PAGE_ID) {
+      break;
+    }
+    auto free_space = GetFreeSpaceSize(buffer_pool_.GetPage(db_oid_, oid_, page_id));
+    if (free_space >= size) {
+      return page_id;
+    }
+    // 映射表记录过时（如恢复时重做了插入），修正后继续查找
+    free_space_map_.Update(page_id, free_space);
+  }
+  return ScanUnrecordedPages(size);
+}
+
+pageid_t Table::ScanUnrecordedPages(db_size_t size) {
+  if (first_page_id_ == NULL_PAGE_ID) {
+    return NULL_PAGE_ID;
+  }
+  // 崩溃恢复后页面链表末尾可能有映射表未记录的页面，沿链表补全记录
+  pageid_t page_id = free_space_map_.GetPageCount();
+  pageid_t prev_page_id = page_id == 0 ? NULL_PAGE_ID : page_id - 1;
+  if (prev_page_id != NULL_PAGE_ID) {
+    page_id = TablePage(buffer_pool_.GetPage(db_oid_, oid_, prev_page_id)).GetNextPageId();
+  }
+  pageid_t found = NULL_PAGE_ID;
+  while (page_id != NULL_PAGE_ID) {
+    auto page = buffer_pool_.GetPage(db_oid_, oid_, page_id);
+    auto free_space = GetFreeSpaceSize(page);
+    free_space_map_.Update(page_id, free_space);
+    if (found == NULL_PAGE_ID && free_space >= size) {
+      found = page_id;
+    }
+    page_id = TablePage(page).GetNextPageId();
+  }
+  return found;
+}
+
+db_size_t Table::GetFreeSpaceSize(std::shared_ptr<Page> page) const {
+  if (layout_ == TableLayout::PAX) {
+    return PaxPage(std::move(page), column_list_).GetFreeSpaceSize();
+  }
+  return TablePage(std::move(page)).GetFreeSpaceSize();
+}
+
+slotid_t Table::GetRecordCount(std::shared_ptr<Page> page) const {
+  if (layout_ == TableLayout::PAX) {
+    return PaxPage(std::move(page), column_list_).GetRecordCount();
+  }
+  return TablePage(std::move(page)).GetRecordCount();
+}
+
+void Table::ForEachTuple(const TupleVisitor &visitor) {
+  auto page_id = first_page_id_;
+  while (page_id != NULL_PAGE_ID) {
+    auto page = buffer_pool_.GetPage(db_oid_, oid_, page_id);
+    VisitTuples(page_id, page, visitor);
+    // PAX 页面的 next_page 与 TablePage 位于相同位置
+    page_id = TablePage(page).GetNextPageId();
+  }
+}
+
+void Table::VisitTuples(pageid_t page_id, std::shared_ptr<Page> page, const TupleVisitor &visitor,
+                        const std::vector<slotid_t> *slot_ids) const {
+  auto visit_page = [&](auto &&table_page, auto &&reset) {
+    TupleView tuple;
+    if (slot_ids != nullptr) {
+      for (auto slot_id : *slot_ids) {
+        reset(tuple, slot_id);
+        visitor(tuple);
+      }
+      return;
+    }
+    for (slotid_t slot_id = 0; slot_id < table_page.GetRecordCount(); slot_id++) {
+      if (table_page.IsSlotUsed(slot_id)) {
+        reset(tuple, slot_id);
+        visitor(tuple);
+      }
+    }
+  };
+  if (layout_ == TableLayout::PAX) {
+    PaxPage pax_page(page, column_list_);
+    visit_page(pax_page, [&](TupleView &tuple, slotid_t slot_id) {
+      tuple.Reset(page, {page_id, slot_id}, pax_page, column_list_);
+    });
+  } else {
+    TablePage table_page(page);
+    visit_page(table_page, [&](TupleView &tuple, slotid_t slot_id) {
+      tuple.Reset(page, {page_id, slot_id}, table_page.GetRecordData(slot_id), column_list_);
+    });
+  }
+}
+
+void Table::RebuildZone(pageid_t page_id, std::shared_ptr<Page> page) {
+  std::vector<ColumnZone> zones(column_list_.Length());
+  VisitTuples(page_id, page, [&](const TupleView &tuple) {
+    for (size_t col_idx = 0; col_idx < column_list_.Length(); col_idx++) {
+      if (ZoneMap::IsTracked(column_list_.GetColumn(col_idx).type_) && !tuple.IsNull(col_idx)) {
+        zones[col_idx].Add(ZoneMap::ToDouble(tuple.GetValue(col_idx)));
+      }
+    }
+  });
+  zone_map_.Reset(page_id, std::move(zones));
+}
+
 oid_t Table::GetOid() const { return oid_; }
 
 oid_t Table::GetDbOid() const { return db_oid_; }
 
 const ColumnList &Table::GetColumnList() const { return column_list_; }
 
+TableLayout Table::GetLayout() const { return layout_; }
+
+CompressionType Table::GetCompression() const { return compression_; }
+
 }  // namespace huadb
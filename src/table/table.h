@@ -1,17 +1,34 @@
 #pragma once
 
+#include <functional>
+
 #include "catalog/column_list.h"
 #include "common/types.h"
 #include "log/log_manager.h"
 #include "storage/buffer_pool.h"
+#include "table/free_space_map.h"
 #include "table/record.h"
+#include "table/tuple_view.h"
+#include "table/visibility_map.h"
+#include "table/zone_map.h"
 
 namespace huadb {
 
+// 访问记录的回调函数
+using TupleVisitor = std::function<void(const TupleView &)>;
+
+// 清理统计
+struct VacuumStats {
+  uint64_t compacted_pages_ = 0;  // 整理的页面数
+  uint64_t removed_records_ = 0;  // 回收的记录数
+  uint64_t freed_bytes_ = 0;      // 回收的字节数，包括记录和槽位
+};
+
 class Table {
  public:
   Table(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, ColumnList column_list,
-        bool new_table, bool is_empty);
+        bool new_table, bool is_empty, TableLayout layout = TableLayout::ROW,
+        CompressionType compression = CompressionType::NONE);
 
   // 插入记录，返回插入记录的 rid
   // write_log: 是否写日志。系统表操作不写日志，用户表操作写日志，lab 2 相关参数
@@ -21,23 +38,67 @@ class Table {
   // 更新记录
   Rid UpdateRecord(const Rid &rid, xid_t xid, cid_t cid, std::shared_ptr<Record> record, bool write_log);
 
+  // 回收 xmax 早于 oldest_xmin 的已删除记录并整理页面，xid 为执行清理的事务
+  // 剩余记录均未被删除且 xmin 早于 oldest_xmin 的页面在可见性映射表中标记为全部可见
+  // on_remove 不为空时在回收前对每条被回收的记录调用，用于删除索引项
+  VacuumStats Vacuum(xid_t xid, xid_t oldest_xmin, const TupleVisitor &on_remove = nullptr);
+  // 从 page_id 开始最多清理 max_pages 个页面，结果累加到 stats，返回下一个待清理的页面号，清理完成时返回 NULL_PAGE_ID
+  pageid_t VacuumPages(xid_t xid, xid_t oldest_xmin, pageid_t page_id, size_t max_pages, VacuumStats &stats,
+                       const TupleVisitor &on_remove = nullptr);
+  // 遍历表中所有未被回收的记录版本，不判断可见性，用于建立索引
+  void ForEachTuple(const TupleVisitor &visitor);
+
+  // 批量导入，将在内存中装入记录的页面追加到表末尾，写一条包含整个页面的日志，返回追加的页面号
+  // 页面中的记录需均由 xid 插入，不经过空闲空间查找
+  pageid_t AppendPage(const Page &page, xid_t xid);
+
   // 用于系统表的原地更新，无需关注
   void UpdateRecordInPlace(const Record &record);
 
   // 获取表的第一个页面的页面号
   pageid_t GetFirstPageId() const;
+  // 获取空闲空间映射表记录的页面数，页面号从 0 开始连续分配，页面 i 的下一个页面为 i + 1
+  // 崩溃恢复后页面链表末尾可能有尚未记录的页面
+  pageid_t GetPageCount() const;
+  // 持久化空闲空间映射表，需在页面写回后调用
+  void SaveFreeSpaceMap() const;
+  // 获取区域映射表
+  const ZoneMap &GetZoneMap() const;
+  // 获取可见性映射表
+  const VisibilityMap &GetVisibilityMap() const;
 
   oid_t GetOid() const;
   oid_t GetDbOid() const;
   const ColumnList &GetColumnList() const;
+  TableLayout GetLayout() const;
+  CompressionType GetCompression() const;
 
  private:
+  // 查找剩余空间不少于 size 的页面，不存在时返回 NULL_PAGE_ID
+  pageid_t FindPage(db_size_t size);
+  // 沿页面链表补全映射表未记录的末尾页面，返回其中剩余空间不少于 size 的第一个页面，不存在时返回 NULL_PAGE_ID
+  pageid_t ScanUnrecordedPages(db_size_t size);
+  // 按表的页面布局获取页面剩余空间
+  db_size_t GetFreeSpaceSize(std::shared_ptr<Page> page) const;
+  // 按表的页面布局获取页面中的槽位数
+  slotid_t GetRecordCount(std::shared_ptr<Page> page) const;
+  // 访问页面中 slot_ids 对应的记录，slot_ids 为空指针时访问所有仍在使用的槽位
+  void VisitTuples(pageid_t page_id, std::shared_ptr<Page> page, const TupleVisitor &visitor,
+                   const std::vector<slotid_t> *slot_ids = nullptr) const;
+  // 根据页面中仍在使用的记录重建页面在区域映射表中的范围
+  void RebuildZone(pageid_t page_id, std::shared_ptr<Page> page);
+
   BufferPool &buffer_pool_;
   LogManager &log_manager_;
   oid_t oid_;
   oid_t db_oid_;
-  pageid_t first_page_id_;  // 第一个页面的页面号
-  ColumnList column_list_;  // 表的 schema 信息
+  pageid_t first_page_id_;       // 第一个页面的页面号
+  ColumnList column_list_;       // 表的 schema 信息
+  TableLayout layout_;           // 页面布局
+  CompressionType compression_;  // 页面写回磁盘时的压缩方式
+  FreeSpaceMap free_space_map_;
+  ZoneMap zone_map_;
+  VisibilityMap visibility_map_;
 };
 
 }  // namespace huadb
@@ -1,4 +1,6 @@
 #include "table/table_page.h"
+#include <algorithm>
+#include <cstring>
 #include <ostream>
 #include <string>
 #include <sstream>
@@ -26,7 +28,7 @@ void TablePage::Init() {
   *page_lsn_ = 0;
   *next_page_id_ = NULL_PAGE_ID;
   *lower_ = PAGE_HEADER_SIZE;
-  *upper_ = DB_PAGE_SIZE;
+  *upper_ = page_->GetPageSize();
   page_->SetDirty();
 }
 
@@ -79,6 +81,12 @@ void TablePage::DeleteRecord(slotid_t slot_id, xid_t xid) {
   page_->SetDirty();
 }
 
+slotid_t TablePage::UpdateRecord(slotid_t slot_id, std::shared_ptr<Record> record, xid_t xid, cid_t cid) {
+  auto new_slot_id = InsertRecord(std::move(record), xid, cid);
+  SetHotUpdated(slot_id, xid, new_slot_id);
+  return new_slot_id;
+}
+
 void TablePage::UpdateRecordInPlace(const Record &record, slotid_t slot_id) {
   record.SerializeTo(page_data_ + slots_[slot_id].offset_);
   page_->SetDirty();
@@ -97,6 +105,58 @@ std::shared_ptr<Record> TablePage::GetRecord(Rid rid, const ColumnList &column_l
   return newRecord;
 }
 
+const char *TablePage::GetRecordData(slotid_t slot_id) const { return page_data_ + slots_[slot_id].offset_; }
+
+std::shared_ptr<Page> TablePage::GetPage() const { return page_; }
+
+bool TablePage::IsSlotUsed(slotid_t slot_id) const { return slots_[slot_id].size_ != 0; }
+
+std::vector<slotid_t> TablePage::GetDeadSlots(xid_t oldest_xmin) const {
+  std::vector<slotid_t> slot_ids;
+  Record record;
+  for (slotid_t slot_id = 0; slot_id < GetRecordCount(); slot_id++) {
+    if (!IsSlotUsed(slot_id)) {
+      continue;
+    }
+    record.DeserializeHeaderFrom(page_data_ + slots_[slot_id].offset_);
+    // 回滚删除时会清除删除标记，回滚插入时以插入事务的 xid 标记删除
+    // 因此带删除标记且 xmax 早于 oldest_xmin 的记录已被提交的删除或回滚的插入作废
+    if (record.IsDeleted() && record.GetXmax() < oldest_xmin) {
+      slot_ids.push_back(slot_id);
+    }
+  }
+  return slot_ids;
+}
+
+db_size_t TablePage::Compact(const std::vector<slotid_t> &slot_ids) {
+  auto old_lower = *lower_;
+  auto old_upper = *upper_;
+  for (auto slot_id : slot_ids) {
+    slots_[slot_id] = {0, 0};
+  }
+  // 按偏移从大到小依次将记录移动到页面末尾，目标位置不低于原位置，不会覆盖尚未移动的记录
+  std::vector<slotid_t> used_slots;
+  for (slotid_t slot_id = 0; slot_id < GetRecordCount(); slot_id++) {
+    if (IsSlotUsed(slot_id)) {
+      used_slots.push_back(slot_id);
+    }
+  }
+  std::sort(used_slots.begin(), used_slots.end(),
+            [this](slotid_t lhs, slotid_t rhs) { return slots_[lhs].offset_ > slots_[rhs].offset_; });
+  db_size_t upper = page_->GetPageSize();
+  for (auto slot_id : used_slots) {
+    upper -= slots_[slot_id].size_;
+    memmove(page_data_ + upper, page_data_ + slots_[slot_id].offset_, slots_[slot_id].size_);
+    slots_[slot_id].offset_ = upper;
+  }
+  *upper_ = upper;
+  while (*lower_ > PAGE_HEADER_SIZE && !IsSlotUsed(GetRecordCount() - 1)) {
+    *lower_ -= sizeof(Slot);
+  }
+  page_->SetDirty();
+  return (*upper_ - old_upper) + (old_lower - *lower_);
+}
+
 void TablePage::UndoDeleteRecord(slotid_t slot_id) {
   // 清除记录的删除标记
   // 将页面设为 dirty
@@ -133,6 +193,21 @@ void TablePage::RedoInsertRecord(slotid_t slot_id, char *raw_record, db_size_t p
   page_->SetDirty();
 }
 
+void TablePage::UndoUpdateRecord(slotid_t old_slot_id, cid_t old_cid, slotid_t new_slot_id, xid_t xid) {
+  // 与回滚插入相同，新版本以 xid 标记删除，由清理回收
+  DeleteRecord(new_slot_id, xid);
+  UndoDeleteRecord(old_slot_id);
+  memcpy(page_data_ + slots_[old_slot_id].offset_ + sizeof(bool) + sizeof(xid_t) + sizeof(xid_t), &old_cid,
+         sizeof(cid_t));
+  page_->SetDirty();
+}
+
+void TablePage::RedoUpdateRecord(slotid_t old_slot_id, xid_t xid, slotid_t new_slot_id, char *raw_record,
+                                 db_size_t page_offset, db_size_t record_size) {
+  RedoInsertRecord(new_slot_id, raw_record, page_offset, record_size);
+  SetHotUpdated(old_slot_id, xid, new_slot_id);
+}
+
 db_size_t TablePage::GetRecordCount() const { return (*lower_ - PAGE_HEADER_SIZE) / sizeof(Slot); }
 
 lsn_t TablePage::GetPageLSN() const { return *page_lsn_; }
@@ -163,6 +238,15 @@ void TablePage::SetPageLSN(lsn_t page_lsn) {
   page_->SetDirty();
 }
 
+void TablePage::SetHotUpdated(slotid_t slot_id, xid_t xid, slotid_t new_slot_id) {
+  auto *record_ptr = page_data_ + slots_[slot_id].offset_;
+  record_ptr[0] = RECORD_DELETED_FLAG | RECORD_HOT_UPDATED_FLAG;
+  memcpy(record_ptr + sizeof(bool) + sizeof(xid_t), &xid, sizeof(xid_t));
+  cid_t successor = new_slot_id;
+  memcpy(record_ptr + sizeof(bool) + sizeof(xid_t) + sizeof(xid_t), &successor, sizeof(cid_t));
+  page_->SetDirty();
+}
+
 std::string TablePage::ToString() const {
   std::ostringstream oss;
   oss << "TablePage[" << std::endl;
@@ -176,9 +260,11 @@ std::string TablePage::ToString() const {
   oss << "  slots: " << std::endl;
   for (size_t i = 0; i < GetRecordCount(); i++) {
     oss << "    " << i << ": offset " << slots_[i].offset_ << ", size " << slots_[i].size_ << " ";
-    if (slots_[i].size_ <= RECORD_HEADER_SIZE) {
+    if (!IsSlotUsed(i)) {
+      oss << "unused" << std::endl;
+    } else if (slots_[i].size_ <= RECORD_HEADER_SIZE) {
       oss << "***Error: record size smaller than header size***" << std::endl;
-    } else if (slots_[i].offset_ + RECORD_HEADER_SIZE >= DB_PAGE_SIZE) {
+    } else if (slots_[i].offset_ + RECORD_HEADER_SIZE >= page_->GetPageSize()) {
       oss << "***Error: record offset out of page boundary***" << std::endl;
     } else {
       RecordHeader header;
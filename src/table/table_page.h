@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "common/types.h"
 #include "log/log_manager.h"
@@ -25,17 +26,37 @@ class TablePage {
   slotid_t InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid);
   // 删除记录
   void DeleteRecord(slotid_t slot_id, xid_t xid);
+  // 页内更新，在本页插入新版本并将旧版本标记为删除，旧版本的 cid 字段指向新版本的槽号
+  // 调用前需确认页面剩余空间足够，返回新版本的槽号
+  slotid_t UpdateRecord(slotid_t slot_id, std::shared_ptr<Record> record, xid_t xid, cid_t cid);
 
   // 用于系统表的原地更新，无需关注
   void UpdateRecordInPlace(const Record &record, slotid_t slot_id);
 
   // 获取记录
   std::shared_ptr<Record> GetRecord(Rid rid, const ColumnList &column_list);
+  // 获取记录在页面中的起始地址，用于构造 TupleView
+  const char *GetRecordData(slotid_t slot_id) const;
+  // 获取页面
+  std::shared_ptr<Page> GetPage() const;
+
+  // 槽位是否仍在使用，被清理回收的记录的槽位不再使用
+  bool IsSlotUsed(slotid_t slot_id) const;
+  // 获取已删除且删除事务早于 oldest_xmin 的记录的槽号，这些记录对所有事务均不可见
+  std::vector<slotid_t> GetDeadSlots(xid_t oldest_xmin) const;
+  // 回收 slot_ids 对应记录的空间并整理页面，返回回收的字节数
+  // 其余记录的槽号保持不变，仅截断槽位数组末尾不再使用的槽位
+  db_size_t Compact(const std::vector<slotid_t> &slot_ids);
 
   // Lab 2: 回滚删除操作
   void UndoDeleteRecord(slotid_t slot_id);
   // Lab 2: 重做插入操作
   void RedoInsertRecord(slotid_t slot_id, char *raw_record, db_size_t page_offset, db_size_t record_size);
+  // 回滚页内更新，恢复旧版本及其 cid，并以 xid 标记删除新版本
+  void UndoUpdateRecord(slotid_t old_slot_id, cid_t old_cid, slotid_t new_slot_id, xid_t xid);
+  // 重做页内更新
+  void RedoUpdateRecord(slotid_t old_slot_id, xid_t xid, slotid_t new_slot_id, char *raw_record,
+                        db_size_t page_offset, db_size_t record_size);
 
   // 获取记录数目
   db_size_t GetRecordCount() const;
@@ -62,6 +83,9 @@ class TablePage {
   std::string ToString() const;
 
  private:
+  // 以 xid 标记旧版本删除，并将其 cid 字段指向新版本的槽号
+  void SetHotUpdated(slotid_t slot_id, xid_t xid, slotid_t new_slot_id);
+
   std::shared_ptr<Page> page_;
   char *page_data_;
   lsn_t *page_lsn_;         // LAB 2: PageLSN
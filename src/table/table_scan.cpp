@@ -1,58 +1,60 @@
 #include "table/table_scan.h"
 
+#include "table/pax_page.h"
 #include "table/table_page.h"
 
 namespace huadb {
 
-    bool IsVisible(IsolationLevel iso_level, xid_t xid, cid_t cid,
-               const std::unordered_set<xid_t>& active_xids,
-               const std::shared_ptr<Record>& record) {
-    // Retrieve record transaction identifiers
-    xid_t recordInsertXid = record->GetXmin();
-    xid_t recordDeleteXid = record->GetXmax();
-    cid_t recordInsertCid = record->GetCid();
-    
-    bool visible = true;
-    
-    if (iso_level == IsolationLevel::REPEATABLE_READ || iso_level == IsolationLevel::SERIALIZABLE) {
-        // For REPEATABLE_READ and SERIALIZABLE isolation levels:
-        // If the record is deleted, its deletion transaction is not active, and the deletion occurred before or at the current transaction, mark it invisible.
-        if (record->IsDeleted() &&
-            active_xids.find(recordDeleteXid) == active_xids.end() &&
-            recordDeleteXid <= xid) {
-            visible = false;
-        }
-        // Also, if the record's insertion transaction is still active or occurred after the current transaction, it is not visible.
-        if (active_xids.find(recordInsertXid) != active_xids.end() || recordInsertXid > xid) {
-            visible = false;
-        }
-    } else if (iso_level == IsolationLevel::READ_COMMITTED) {
-        // For READ_COMMITTED isolation level:
-        // Mark as invisible if the record is deleted and either its deletion transaction is not active or it was deleted by the current transaction.
-        if (record->IsDeleted() &&
-            (active_xids.find(recordDeleteXid) == active_xids.end() || xid == recordDeleteXid)) {
-            visible = false;
-        }
-        // Additionally, if the insertion transaction is still active (and not the current transaction), the record is not visible.
-        if (active_xids.find(recordInsertXid) != active_xids.end() && recordInsertXid != xid) {
-            visible = false;
-        }
+static bool IsVisible(IsolationLevel iso_level, xid_t xid, cid_t cid, const std::unordered_set<xid_t> &active_xids,
+                      const TupleView &tuple) {
+  // Retrieve record transaction identifiers
+  xid_t recordInsertXid = tuple.GetXmin();
+  xid_t recordDeleteXid = tuple.GetXmax();
+  cid_t recordInsertCid = tuple.GetCid();
+
+  bool visible = true;
+
+  if (iso_level == IsolationLevel::REPEATABLE_READ || iso_level == IsolationLevel::SERIALIZABLE) {
+    // For REPEATABLE_READ and SERIALIZABLE isolation levels:
+    // If the record is deleted, its deletion transaction is not active, and the deletion occurred before or at the
+    // current transaction, mark it invisible.
+    if (tuple.IsDeleted() && active_xids.find(recordDeleteXid) == active_xids.end() && recordDeleteXid <= xid) {
+      visible = false;
     }
-    
-    // Prevent the Halloween problem: if the record was inserted by the current transaction with the same command id, it should not be visible.
-    if (recordInsertXid == xid && recordInsertCid == cid) {
-        visible = false;
+    // Also, if the record's insertion transaction is still active or occurred after the current transaction, it is
+    // not visible.
+    if (active_xids.find(recordInsertXid) != active_xids.end() || recordInsertXid > xid) {
+      visible = false;
     }
-    
-    return visible;
-}
+  } else if (iso_level == IsolationLevel::READ_COMMITTED) {
+    // For READ_COMMITTED isolation level:
+    // Mark as invisible if the record is deleted and either its deletion transaction is not active or it was deleted
+    // by the current transaction.
+    if (tuple.IsDeleted() && (active_xids.find(recordDeleteXid) == active_xids.end() || xid == recordDeleteXid)) {
+      visible = false;
+    }
+    // Additionally, if the insertion transaction is still active (and not the current transaction), the record is not
+    // visible.
+    if (active_xids.find(recordInsertXid) != active_xids.end() && recordInsertXid != xid) {
+      visible = false;
+    }
+  }
+
+  // Prevent the Halloween problem: if the record was inserted by the current transaction with the same command id, it
+  // should not be visible.
+  if (recordInsertXid == xid && recordInsertCid == cid) {
+    visible = false;
+  }
 
+  return visible;
+}
 
 TableScan::TableScan(BufferPool &buffer_pool, std::shared_ptr<Table> table, Rid rid)
     : buffer_pool_(buffer_pool), table_(std::move(table)), rid_(rid) {}
 
 std::shared_ptr<Record> TableScan::GetNextRecord(xid_t xid, IsolationLevel isolation_level, cid_t cid,
-                                                 const std::unordered_set<xid_t> &active_xids) {
+                                                 const std::unordered_set<xid_t> &active_xids,
+                                                 const TupleFilter &filter) {
   // 根据事务隔离级别及活跃事务集合，判断记录是否可见
   // LAB 3 BEGIN
 
@@ -64,34 +66,122 @@ std::shared_ptr<Record> TableScan::GetNextRecord(xid_t xid, IsolationLevel isola
   if (rid_.page_id_ == NULL_PAGE_ID) {
     return nullptr;
   }
-  
-  std::shared_ptr<Record> record = nullptr;
-  
-  while (true) {
-    auto current_page = buffer_pool_.GetPage(table_->GetDbOid(), table_->GetOid(), rid_.page_id_);
-    TablePage table_page(current_page);
 
-    if (rid_.slot_id_ < table_page.GetRecordCount()) {
-        record = table_page.GetRecord(rid_, table_->GetColumnList());
-        rid_.slot_id_++;
-
-        // Check record visibility
-        if (!IsVisible(isolation_level, xid, cid, active_xids, record)) {
+  // 通过 TupleView 直接在页面上判断可见性和过滤条件，只物化满足条件的记录
+  TupleView tuple;
+  while (true) {
+    bool skip_page = false;
+    if (rid_.slot_id_ == 0) {
+      // 进入新页面时根据区域映射表判断是否可以跳过整个页面
+      skip_page = !zone_conditions_.empty() && !table_->GetZoneMap().MayMatch(rid_.page_id_, zone_conditions_);
+      if (stats_ != nullptr) {
+        (skip_page ? stats_->skipped_pages_ : stats_->scanned_pages_)++;
+      }
+      // 跳过的页面不读取，直接计算下一个页面号；映射表记录的最后一个页面之后可能还有页面，需读取页面获取
+      if (skip_page && rid_.page_id_ + 1 < table_->GetPageCount()) {
+        rid_.page_id_++;
+        continue;
+      }
+    }
+    auto page = buffer_pool_.GetPage(table_->GetDbOid(), table_->GetOid(), rid_.page_id_);
+    // 页面中没有满足条件的记录时直接读取下一个页面
+    if (!skip_page) {
+      if (table_->GetLayout() == TableLayout::PAX) {
+        PaxPage pax_page(page, table_->GetColumnList());
+        while (rid_.slot_id_ < pax_page.GetRecordCount()) {
+          if (!pax_page.IsSlotUsed(rid_.slot_id_)) {
+            rid_.slot_id_++;
             continue;
+          }
+          tuple.Reset(page, rid_, pax_page, table_->GetColumnList());
+          rid_.slot_id_++;
+          if (IsVisible(isolation_level, xid, cid, active_xids, tuple) && (!filter || filter(tuple))) {
+            return Materialize(tuple);
+          }
         }
-        break;
-    } else if (table_page.GetNextPageId() != NULL_PAGE_ID) {
-        // Switch to the next page and reset the slot index
-        rid_.page_id_ = table_page.GetNextPageId();
-        rid_.slot_id_ = 0;
-        // Continue loop to process the new page
-        continue;
-    } else {
-        rid_.page_id_ = NULL_PAGE_ID;
-        rid_.slot_id_ = 0;
-        return nullptr;
+      } else {
+        TablePage table_page(page);
+        while (rid_.slot_id_ < table_page.GetRecordCount()) {
+          if (!table_page.IsSlotUsed(rid_.slot_id_)) {
+            rid_.slot_id_++;
+            continue;
+          }
+          tuple.Reset(page, rid_, table_page.GetRecordData(rid_.slot_id_), table_->GetColumnList());
+          rid_.slot_id_++;
+          if (IsVisible(isolation_level, xid, cid, active_xids, tuple) && (!filter || filter(tuple))) {
+            return Materialize(tuple);
+          }
+        }
+      }
+    }
+    // PAX 页面的 next_page 与 TablePage 位于相同位置
+    TablePage table_page(page);
+    if (table_page.GetNextPageId() == NULL_PAGE_ID) {
+      rid_.page_id_ = NULL_PAGE_ID;
+      rid_.slot_id_ = 0;
+      return nullptr;
     }
+    if (read_ahead_) {
+      ReadAhead(rid_.page_id_);
     }
-return record;
+    rid_.page_id_ = table_page.GetNextPageId();
+    rid_.slot_id_ = 0;
+  }
 }
+
+std::shared_ptr<Record> TableScan::FetchRecord(Rid rid, xid_t xid, IsolationLevel isolation_level, cid_t cid,
+                                               const std::unordered_set<xid_t> &active_xids,
+                                               const TupleFilter &filter) {
+  auto page = buffer_pool_.GetPage(table_->GetDbOid(), table_->GetOid(), rid.page_id_);
+  TupleView tuple;
+  // PAX 页面的视图需在 pax_page 有效期间物化
+  auto fetch = [&]() -> std::shared_ptr<Record> {
+    if (!IsVisible(isolation_level, xid, cid, active_xids, tuple) || (filter && !filter(tuple))) {
+      return nullptr;
+    }
+    return Materialize(tuple);
+  };
+  if (table_->GetLayout() == TableLayout::PAX) {
+    PaxPage pax_page(page, table_->GetColumnList());
+    if (rid.slot_id_ >= pax_page.GetRecordCount() || !pax_page.IsSlotUsed(rid.slot_id_)) {
+      return nullptr;
+    }
+    tuple.Reset(page, rid, pax_page, table_->GetColumnList());
+    return fetch();
+  }
+  TablePage table_page(page);
+  if (rid.slot_id_ >= table_page.GetRecordCount() || !table_page.IsSlotUsed(rid.slot_id_)) {
+    return nullptr;
+  }
+  tuple.Reset(page, rid, table_page.GetRecordData(rid.slot_id_), table_->GetColumnList());
+  return fetch();
+}
+
+void TableScan::EnableReadAhead() { read_ahead_ = true; }
+
+void TableScan::SetMemoryResource(std::pmr::memory_resource *resource) { resource_ = resource; }
+
+void TableScan::SetProjection(std::vector<bool> projection) { projection_ = std::move(projection); }
+
+void TableScan::SetZoneConditions(std::vector<ZoneCondition> conditions) { zone_conditions_ = std::move(conditions); }
+
+void TableScan::SetStats(TableScanStats *stats) { stats_ = stats; }
+
+std::shared_ptr<Record> TableScan::Materialize(const TupleView &tuple) const {
+  if (projection_.empty()) {
+    return tuple.Materialize(resource_);
+  }
+  return tuple.Materialize(resource_, projection_);
+}
+
+void TableScan::ReadAhead(pageid_t page_id) {
+  if (read_ahead_remaining_ > 0) {
+    read_ahead_remaining_--;
+  }
+  if (read_ahead_remaining_ <= read_ahead_window_ / 2) {
+    read_ahead_window_ = buffer_pool_.ReadAhead(table_->GetDbOid(), table_->GetOid(), page_id);
+    read_ahead_remaining_ = read_ahead_window_;
+  }
+}
+
 }  // namespace huadb
@@ -1,14 +1,26 @@
 #pragma once
 
+#include <functional>
+#include <memory_resource>
 #include <unordered_map>
 
 #include "common/types.h"
 #include "storage/buffer_pool.h"
 #include "table/record.h"
 #include "table/table.h"
+#include "table/tuple_view.h"
 
 namespace huadb {
 
+// 扫描时在页面上判断记录是否满足条件，返回 false 的记录被跳过且不会被物化
+using TupleFilter = std::function<bool(const TupleView &)>;
+
+// 扫描统计
+struct TableScanStats {
+  uint64_t scanned_pages_ = 0;  // 逐条检查记录的页面数
+  uint64_t skipped_pages_ = 0;  // 根据区域映射表跳过、不读取的页面数
+};
+
 class TableScan {
  public:
   TableScan(BufferPool &buffer_pool, std::shared_ptr<Table> table, Rid rid);
@@ -17,13 +29,42 @@ class TableScan {
   // cid: 事物内部 command id
   // active_xids: 活跃的事务 id 集合
   // 均为 Lab 3 相关参数
+  // filter: 过滤条件，为空时返回所有可见记录
   std::shared_ptr<Record> GetNextRecord(xid_t xid = NULL_XID, IsolationLevel isolation_level = DEFAULT_ISOLATION_LEVEL,
-                                        cid_t cid = NULL_CID, const std::unordered_set<xid_t> &active_xids = {});
+                                        cid_t cid = NULL_CID, const std::unordered_set<xid_t> &active_xids = {},
+                                        const TupleFilter &filter = nullptr);
+  // 按 rid 读取一条记录，用于索引扫描，记录已被回收、不可见或不满足 filter 时返回空指针，参数含义同 GetNextRecord
+  std::shared_ptr<Record> FetchRecord(Rid rid, xid_t xid, IsolationLevel isolation_level, cid_t cid,
+                                      const std::unordered_set<xid_t> &active_xids,
+                                      const TupleFilter &filter = nullptr);
+  // 开启顺序预读，扫描沿页面链表前进时在后台读入之后的页面
+  void EnableReadAhead();
+  // 设置返回记录的内存分配来源，默认使用全局分配器
+  void SetMemoryResource(std::pmr::memory_resource *resource);
+  // 设置需要物化的列，其余列在返回的记录中为空值；为空时物化所有列
+  void SetProjection(std::vector<bool> projection);
+  // 设置区域映射表可判断的过滤条件，范围不满足所有条件的页面被整页跳过，conditions 需由 filter 蕴含
+  void SetZoneConditions(std::vector<ZoneCondition> conditions);
+  // 设置扫描统计，扫描过程中累加，stats 需在扫描期间保持有效
+  void SetStats(TableScanStats *stats);
 
  private:
   BufferPool &buffer_pool_;
   std::shared_ptr<Table> table_;
   Rid rid_;  // 当前扫描到的记录的 rid
+  std::pmr::memory_resource *resource_ = std::pmr::get_default_resource();
+  std::vector<bool> projection_;
+  std::vector<ZoneCondition> zone_conditions_;
+  TableScanStats *stats_ = nullptr;
+
+  // 按 projection_ 物化记录
+  std::shared_ptr<Record> Materialize(const TupleView &tuple) const;
+
+  // 离开 page_id 页面进入下一个页面时调用，已预读的页面消耗过半时提交新的预读请求
+  void ReadAhead(pageid_t page_id);
+  bool read_ahead_ = false;
+  size_t read_ahead_window_ = 0;     // 上次提交的预读页面数
+  size_t read_ahead_remaining_ = 0;  // 已预读但尚未扫描到的页面数
 };
 
 }  // namespace huadb
@@ -0,0 +1,122 @@
+#include "table/tuple_view.h"
+
+#include <cstring>
+
+#include "common/exceptions.h"
+#include "table/pax_page.h"
+#include "table/record_header.h"
+
+namespace huadb {
+
+TupleView::TupleView(std::shared_ptr<Page> page, Rid rid, const char *data, const ColumnList &column_list) {
+  Reset(std::move(page), rid, data, column_list);
+}
+
+void TupleView::Reset(std::shared_ptr<Page> page, Rid rid, const char *data, const ColumnList &column_list) {
+  page_ = std::move(page);
+  rid_ = rid;
+  data_ = data;
+  pax_page_ = nullptr;
+  column_list_ = &column_list;
+  offsets_.clear();
+  // 第一列紧跟在记录头和空值位图之后
+  offsets_.push_back(RECORD_HEADER_SIZE + (column_list.Length() + 7) / 8);
+}
+
+void TupleView::Reset(std::shared_ptr<Page> page, Rid rid, const PaxPage &pax_page, const ColumnList &column_list) {
+  page_ = std::move(page);
+  rid_ = rid;
+  data_ = pax_page.GetRecordHeader(rid.slot_id_);
+  pax_page_ = &pax_page;
+  column_list_ = &column_list;
+}
+
+bool TupleView::IsDeleted() const { return (static_cast<uint8_t>(data_[0]) & RECORD_DELETED_FLAG) != 0; }
+
+xid_t TupleView::GetXmin() const {
+  xid_t xmin;
+  memcpy(&xmin, data_ + sizeof(bool), sizeof(xid_t));
+  return xmin;
+}
+
+xid_t TupleView::GetXmax() const {
+  xid_t xmax;
+  memcpy(&xmax, data_ + sizeof(bool) + sizeof(xid_t), sizeof(xid_t));
+  return xmax;
+}
+
+cid_t TupleView::GetCid() const {
+  cid_t cid;
+  memcpy(&cid, data_ + sizeof(bool) + sizeof(xid_t) + sizeof(xid_t), sizeof(cid_t));
+  return cid;
+}
+
+Rid TupleView::GetRid() const { return rid_; }
+
+bool TupleView::IsNull(size_t col_idx) const {
+  if (pax_page_ != nullptr) {
+    return pax_page_->IsNull(rid_.slot_id_, col_idx);
+  }
+  auto bits = static_cast<uint8_t>(data_[RECORD_HEADER_SIZE + col_idx / 8]);
+  return (bits & (1U << (col_idx % 8))) != 0;
+}
+
+Value TupleView::GetValue(size_t col_idx) const {
+  if (col_idx >= column_list_->Length()) {
+    throw DbException("Column index out of range");
+  }
+  if (pax_page_ != nullptr) {
+    return pax_page_->GetValue(rid_.slot_id_, col_idx);
+  }
+  if (IsNull(col_idx)) {
+    return Value();
+  }
+  const auto &column = column_list_->GetColumns()[col_idx];
+  auto value = Value(column.type_, column.max_size_);
+  value.DeserializeFrom(data_ + GetOffset(col_idx));
+  return value;
+}
+
+std::shared_ptr<Record> TupleView::Materialize(std::pmr::memory_resource *resource) const {
+  if (pax_page_ != nullptr) {
+    return Materialize(resource, std::vector<bool>(column_list_->Length(), true));
+  }
+  auto record = std::allocate_shared<Record>(std::pmr::polymorphic_allocator<Record>(resource));
+  record->SetRid(rid_);
+  record->DeserializeFrom(data_, *column_list_);
+  return record;
+}
+
+std::shared_ptr<Record> TupleView::Materialize(std::pmr::memory_resource *resource,
+                                               const std::vector<bool> &projection) const {
+  std::pmr::vector<Value> values(resource);
+  values.reserve(column_list_->Length());
+  for (size_t col_idx = 0; col_idx < column_list_->Length(); col_idx++) {
+    values.push_back(projection[col_idx] ? GetValue(col_idx) : Value());
+  }
+  auto record =
+      std::allocate_shared<Record>(std::pmr::polymorphic_allocator<Record>(resource), std::move(values), rid_);
+  record->DeserializeHeaderFrom(data_);
+  return record;
+}
+
+db_size_t TupleView::GetOffset(size_t col_idx) const {
+  const auto &columns = column_list_->GetColumns();
+  while (offsets_.size() <= col_idx) {
+    auto i = offsets_.size() - 1;
+    auto offset = offsets_.back();
+    if (!IsNull(i)) {
+      if (TypeUtil::IsString(columns[i].type_)) {
+        db_size_t str_size;
+        memcpy(&str_size, data_ + offset, 2);
+        offset += str_size + 2;
+      } else {
+        offset += columns[i].max_size_;
+      }
+    }
+    offsets_.push_back(offset);
+  }
+  return offsets_[col_idx];
+}
+
+}  // namespace huadb
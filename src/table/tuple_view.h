@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "catalog/column_list.h"
+#include "common/types.h"
+#include "common/value.h"
+#include "storage/page.h"
+#include "table/record.h"
+
+namespace huadb {
+
+class PaxPage;
+
+// 页面中记录的只读视图，直接从页面读取记录头和列值，无需反序列化整条记录
+// 持有页面的 shared_ptr，视图有效期间页面不会被淘汰
+// 视图可通过 Reset 复用，避免每条记录分配内存
+class TupleView {
+ public:
+  TupleView() = default;
+  TupleView(std::shared_ptr<Page> page, Rid rid, const char *data, const ColumnList &column_list);
+
+  // 指向新的记录，清空列偏移缓存
+  void Reset(std::shared_ptr<Page> page, Rid rid, const char *data, const ColumnList &column_list);
+  // 指向 PAX 页面中的记录，列值从各列的 minipage 读取，视图使用期间 pax_page 需保持有效
+  void Reset(std::shared_ptr<Page> page, Rid rid, const PaxPage &pax_page, const ColumnList &column_list);
+
+  // 获取记录头信息
+  bool IsDeleted() const;
+  xid_t GetXmin() const;
+  xid_t GetXmax() const;
+  cid_t GetCid() const;
+  Rid GetRid() const;
+
+  // 第 col_idx 列是否为空
+  bool IsNull(size_t col_idx) const;
+  // 获取第 col_idx 列的值，仅反序列化该列
+  Value GetValue(size_t col_idx) const;
+  // 将视图物化为记录，记录从 resource 分配
+  std::shared_ptr<Record> Materialize(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const;
+  // 只物化 projection 中为 true 的列，其余列为空值
+  std::shared_ptr<Record> Materialize(std::pmr::memory_resource *resource, const std::vector<bool> &projection) const;
+
+ private:
+  // 获取第 col_idx 列相对记录起始位置的偏移，依次计算并缓存之前各列的偏移
+  db_size_t GetOffset(size_t col_idx) const;
+
+  std::shared_ptr<Page> page_;
+  Rid rid_;
+  const char *data_ = nullptr;  // 记录起始地址，PAX 页面中为记录头的地址
+  const PaxPage *pax_page_ = nullptr;
+  const ColumnList *column_list_ = nullptr;
+  mutable std::vector<db_size_t> offsets_;  // 已计算的列偏移
+};
+
+}  // namespace huadb
@@ -0,0 +1,23 @@
+#include "table/visibility_map.h"
+
+namespace huadb {
+
+void VisibilityMap::Set(pageid_t page_id, bool all_visible) {
+  std::scoped_lock lock(mutex_);
+  if (page_id >= all_visible_.size()) {
+    if (!all_visible) {
+      return;
+    }
+    all_visible_.resize(page_id + 1, false);
+  }
+  all_visible_[page_id] = all_visible;
+}
+
+void VisibilityMap::Clear(pageid_t page_id) { Set(page_id, false); }
+
+bool VisibilityMap::IsAllVisible(pageid_t page_id) const {
+  std::scoped_lock lock(mutex_);
+  return page_id < all_visible_.size() && all_visible_[page_id];
+}
+
+}  // namespace huadb
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "common/types.h"
+
+namespace huadb {
+
+// 可见性映射表，每个页面一位，表示页面中所有记录均已提交且未被删除，对所有事务可见
+// 清理时设置，插入、删除和更新页面中的记录时清除；活跃事务修改过的页面不会被设置，回滚无需清除
+// 映射表只保存在内存中，重启后为空，所有页面均视为不是全部可见，需通过清理重建
+class VisibilityMap {
+ public:
+  // 设置页面是否全部可见
+  void Set(pageid_t page_id, bool all_visible);
+  // 页面被修改后清除标记
+  void Clear(pageid_t page_id);
+  bool IsAllVisible(pageid_t page_id) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<bool> all_visible_;
+};
+
+}  // namespace huadb
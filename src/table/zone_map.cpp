@@ -0,0 +1,98 @@
+#include "table/zone_map.h"
+
+#include <algorithm>
+
+namespace huadb {
+
+void ColumnZone::Add(double value) {
+  if (empty_) {
+    min_ = max_ = value;
+    empty_ = false;
+  } else {
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+}
+
+ZoneMap::ZoneMap(const ColumnList &column_list) {
+  for (const auto &column : column_list.GetColumns()) {
+    tracked_.push_back(IsTracked(column.type_));
+  }
+}
+
+bool ZoneMap::IsTracked(Type type) { return type == Type::INT || type == Type::DOUBLE; }
+
+double ZoneMap::ToDouble(const Value &value) {
+  if (value.GetType() == Type::INT) {
+    return value.GetValue<int32_t>();
+  }
+  return value.GetValue<double>();
+}
+
+void ZoneMap::Reset(pageid_t page_id, std::vector<ColumnZone> zones) {
+  zones.resize(tracked_.size());
+  std::scoped_lock lock(mutex_);
+  if (page_id >= zones_.size()) {
+    zones_.resize(page_id + 1);
+    known_.resize(page_id + 1, false);
+  }
+  zones_[page_id] = std::move(zones);
+  known_[page_id] = true;
+}
+
+void ZoneMap::Update(pageid_t page_id, const Record &record) {
+  std::scoped_lock lock(mutex_);
+  // 范围未知的页面中可能有映射表之外的记录，只记录插入的记录会导致错误地跳过页面
+  if (page_id >= known_.size() || !known_[page_id]) {
+    return;
+  }
+  auto &zones = zones_[page_id];
+  for (size_t col_idx = 0; col_idx < tracked_.size(); col_idx++) {
+    const auto &value = record.GetValue(col_idx);
+    if (tracked_[col_idx] && !value.IsNull()) {
+      zones[col_idx].Add(ToDouble(value));
+    }
+  }
+}
+
+bool ZoneMap::MayMatch(pageid_t page_id, const std::vector<ZoneCondition> &conditions) const {
+  std::scoped_lock lock(mutex_);
+  if (page_id >= known_.size() || !known_[page_id]) {
+    return true;
+  }
+  const auto &zones = zones_[page_id];
+  for (const auto &condition : conditions) {
+    const auto &zone = zones[condition.col_idx_];
+    // 空值与任何值比较的结果均为空，不满足条件
+    if (zone.empty_) {
+      return false;
+    }
+    bool may_match = true;
+    switch (condition.type_) {
+      case ZoneCompareType::EQUAL:
+        may_match = zone.min_ <= condition.value_ && condition.value_ <= zone.max_;
+        break;
+      case ZoneCompareType::NOT_EQUAL:
+        may_match = zone.min_ != condition.value_ || zone.max_ != condition.value_;
+        break;
+      case ZoneCompareType::LESS:
+        may_match = zone.min_ < condition.value_;
+        break;
+      case ZoneCompareType::LESS_EQUAL:
+        may_match = zone.min_ <= condition.value_;
+        break;
+      case ZoneCompareType::GREATER:
+        may_match = zone.max_ > condition.value_;
+        break;
+      case ZoneCompareType::GREATER_EQUAL:
+        may_match = zone.max_ >= condition.value_;
+        break;
+    }
+    if (!may_match) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace huadb
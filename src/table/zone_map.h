@@ -0,0 +1,57 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "catalog/column_list.h"
+#include "common/types.h"
+#include "table/record.h"
+
+namespace huadb {
+
+enum class ZoneCompareType { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL };
+
+// 区域映射表可判断的过滤条件：第 col_idx_ 列 type_ 常量 value_
+struct ZoneCondition {
+  size_t col_idx_;
+  ZoneCompareType type_;
+  double value_;
+};
+
+// 页面中一列非空值的取值范围
+struct ColumnZone {
+  double min_ = 0;
+  double max_ = 0;
+  bool empty_ = true;  // 页面中该列没有非空值
+
+  void Add(double value);
+};
+
+// 区域映射表，记录每个页面中 INT 和 DOUBLE 列的最小值和最大值，扫描时跳过不可能满足过滤条件的页面
+// 范围包含页面中所有仍在使用的记录版本，与可见性无关；插入时扩大范围，删除不缩小范围，清理时重建
+// 映射表只保存在内存中，重启后为空，没有记录的页面不会被跳过，需通过清理重建
+class ZoneMap {
+ public:
+  explicit ZoneMap(const ColumnList &column_list);
+
+  // 该类型的列是否记录取值范围
+  static bool IsTracked(Type type);
+  // 将值转换为范围比较使用的 double，值需为 IsTracked 的类型
+  static double ToDouble(const Value &value);
+
+  // 新页面或清理后的页面，用 zones 替换页面原有的范围，zones 为空时表示页面中没有记录
+  void Reset(pageid_t page_id, std::vector<ColumnZone> zones = {});
+  // 插入记录后扩大页面的范围，没有记录的页面保持未知
+  void Update(pageid_t page_id, const Record &record);
+  // 页面中是否可能存在满足所有条件的记录，没有记录的页面返回 true
+  bool MayMatch(pageid_t page_id, const std::vector<ZoneCondition> &conditions) const;
+
+ private:
+  std::vector<bool> tracked_;  // 各列是否记录取值范围
+
+  mutable std::mutex mutex_;
+  std::vector<std::vector<ColumnZone>> zones_;  // 页面号到各列的取值范围
+  std::vector<bool> known_;                     // 页面的范围是否已知
+};
+
+}  // namespace huadb
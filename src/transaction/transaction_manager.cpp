@@ -1,5 +1,6 @@
 #include "transaction/transaction_manager.h"
 
+#include <algorithm>
 #include <string>
 
 #include "common/exceptions.h"
@@ -74,6 +75,17 @@ std::unordered_set<xid_t> TransactionManager::GetActiveTransactions() const {
   return active_xids;
 }
 
+xid_t TransactionManager::GetOldestXmin() const {
+  xid_t oldest_xmin = next_xid_;
+  for (const auto &[xid, active_xids] : xid2active_set_) {
+    oldest_xmin = std::min(oldest_xmin, xid);
+    for (const auto active_xid : active_xids) {
+      oldest_xmin = std::min(oldest_xmin, active_xid);
+    }
+  }
+  return oldest_xmin;
+}
+
 void TransactionManager::ReleaseLocks(xid_t xid) { lock_manager_.ReleaseLocks(xid); }
 
 }  // namespace huadb
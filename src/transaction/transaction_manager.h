@@ -35,6 +35,9 @@ class TransactionManager {
   std::unordered_set<xid_t> GetSnapshot(xid_t xid) const;
   // 获取活跃事务表
   std::unordered_set<xid_t> GetActiveTransactions() const;
+  // 获取所有活跃事务及其快照中最小的 xid，没有活跃事务时返回 next_xid
+  // 早于该 xid 提交的删除对所有事务均可见，被删除的记录可以回收
+  xid_t GetOldestXmin() const;
 
  private:
   // 释放事务持有的锁